@@ -48,67 +48,117 @@ namespace equinox {
 /**
  * @brief trace() function to produce message with severity set to 'trace'
  *
- * @param format includes the message, or/and format specifier for the values included in the message
+ * @param format includes the message, or/and format specifier for the values included in the message;
+ *        a string literal, std::string_view or std::string, never copied
  * @param args variadic number of arguments to be logged
  */
 template <typename... Args>
-inline void trace(const std::string& format, Args&&... args) {
-  equinox::EquinoxLoggerEngine::getInstance().log(level::LOG_LEVEL::trace, format, std::forward<Args>(args)...);
+inline void trace(FormatString format, Args&&... args) {
+  if constexpr (EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_TRACE) {
+    equinox::EquinoxLoggerEngine& engine = equinox::EquinoxLoggerEngine::getInstance();
+    if (engine.isLevelEnabled(level::LOG_LEVEL::trace)) {
+      engine.log(level::LOG_LEVEL::trace, format, std::forward<Args>(args)...);
+    }
+  }
 }
 
 /**
  * @brief debug() function to produce message with severity set to 'debug'
  *
- * @param format includes the message, or/and format specifier for the values included in the message
+ * @param format includes the message, or/and format specifier for the values included in the message;
+ *        a string literal, std::string_view or std::string, never copied
  * @param args variadic number of arguments to be logged
  */
 template <typename... Args>
-inline void debug(const std::string& format, Args&&... args) {
-  equinox::EquinoxLoggerEngine::getInstance().log(level::LOG_LEVEL::debug, format, std::forward<Args>(args)...);
+inline void debug(FormatString format, Args&&... args) {
+  if constexpr (EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_DEBUG) {
+    equinox::EquinoxLoggerEngine& engine = equinox::EquinoxLoggerEngine::getInstance();
+    if (engine.isLevelEnabled(level::LOG_LEVEL::debug)) {
+      engine.log(level::LOG_LEVEL::debug, format, std::forward<Args>(args)...);
+    }
+  }
 }
 
 /**
  * @brief info() function to produce message with severity set to 'info'
  *
- * @param format includes the message, or/and format specifier for the values included in the message
+ * @param format includes the message, or/and format specifier for the values included in the message;
+ *        a string literal, std::string_view or std::string, never copied
  * @param args variadic number of arguments to be logged
  */
 template <typename... Args>
-inline void info(const std::string& format, Args&&... args) {
-  equinox::EquinoxLoggerEngine::getInstance().log(level::LOG_LEVEL::info, format, std::forward<Args>(args)...);
+inline void info(FormatString format, Args&&... args) {
+  if constexpr (EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_INFO) {
+    equinox::EquinoxLoggerEngine& engine = equinox::EquinoxLoggerEngine::getInstance();
+    if (engine.isLevelEnabled(level::LOG_LEVEL::info)) {
+      engine.log(level::LOG_LEVEL::info, format, std::forward<Args>(args)...);
+    }
+  }
 }
 
 /**
  * @brief warning() function to produce message with severity set to 'warning'
  *
- * @param format includes the message, or/and format specifier for the values included in the message
+ * @param format includes the message, or/and format specifier for the values included in the message;
+ *        a string literal, std::string_view or std::string, never copied
  * @param args variadic number of arguments to be logged
  */
 template <typename... Args>
-inline void warning(const std::string& format, Args&&... args) {
-  equinox::EquinoxLoggerEngine::getInstance().log(level::LOG_LEVEL::warning, format, std::forward<Args>(args)...);
+inline void warning(FormatString format, Args&&... args) {
+  if constexpr (EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_WARNING) {
+    equinox::EquinoxLoggerEngine& engine = equinox::EquinoxLoggerEngine::getInstance();
+    if (engine.isLevelEnabled(level::LOG_LEVEL::warning)) {
+      engine.log(level::LOG_LEVEL::warning, format, std::forward<Args>(args)...);
+    }
+  }
 }
 
 /**
  * @brief error() function to produce message with severity set to 'error'
  *
- * @param format includes the message, or/and format specifier for the values included in the message
+ * @param format includes the message, or/and format specifier for the values included in the message;
+ *        a string literal, std::string_view or std::string, never copied
  * @param args variadic number of arguments to be logged
  */
 template <typename... Args>
-inline void error(const std::string& format, Args&&... args) {
-  equinox::EquinoxLoggerEngine::getInstance().log(level::LOG_LEVEL::error, format, std::forward<Args>(args)...);
+inline void error(FormatString format, Args&&... args) {
+  if constexpr (EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_ERROR) {
+    equinox::EquinoxLoggerEngine& engine = equinox::EquinoxLoggerEngine::getInstance();
+    if (engine.isLevelEnabled(level::LOG_LEVEL::error)) {
+      engine.log(level::LOG_LEVEL::error, format, std::forward<Args>(args)...);
+    }
+  }
 }
 
 /**
  * @brief critical() function to produce message with severity set to 'critical'
  *
- * @param format includes the message, or/and format specifier for the values included in the message
+ * @param format includes the message, or/and format specifier for the values included in the message;
+ *        a string literal, std::string_view or std::string, never copied
  * @param args variadic number of arguments to be logged
  */
 template <typename... Args>
-inline void critical(const std::string& format, Args&&... args) {
-  equinox::EquinoxLoggerEngine::getInstance().log(level::LOG_LEVEL::critical, format, std::forward<Args>(args)...);
+inline void critical(FormatString format, Args&&... args) {
+  if constexpr (EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_CRITICAL) {
+    equinox::EquinoxLoggerEngine& engine = equinox::EquinoxLoggerEngine::getInstance();
+    if (engine.isLevelEnabled(level::LOG_LEVEL::critical)) {
+      engine.log(level::LOG_LEVEL::critical, format, std::forward<Args>(args)...);
+    }
+  }
+}
+
+/**
+ * @brief tryLog() function to produce message without ever waiting for space in the queue
+ *
+ * @param msgLevel level of the message
+ * @param format includes the message, or/and format specifier for the values included in the message;
+ *        a string literal, std::string_view or std::string, never copied
+ * @param args variadic number of arguments to be logged
+ * @return false if the message was dropped because the queue was full, even with the block overflow policy
+ */
+template <typename... Args>
+inline bool tryLog(level::LOG_LEVEL msgLevel, FormatString format, Args&&... args) {
+  return equinox::EquinoxLoggerEngine::getInstance().tryLog(msgLevel, format, std::forward<Args>(args)...);
 }
 
 /**
@@ -125,6 +175,17 @@ inline void critical(const std::string& format, Args&&... args) {
 EQUINOX_API bool setup(level::LOG_LEVEL logLevel, const std::string& logPrefix, logs_output::SINK logsOutputSink, const std::string& logFileName = kLogFileName,
                        std::size_t maxLogFileSizeBytes = kDefaultMaxLogFileSizeBytes, std::size_t maxLogFiles = kDefaultMaxLogFiles);
 
+/**
+ * @brief setup() function to setup logger with the advanced settings
+ *
+ * @param logLevel        level of the messages that will be (trace, debug, info, warning, error or critical)
+ * @param logPrefix       string with prefix included to each log (f.ex. with application name)
+ * @param logsOutputSink  place where logs are printed (console, file or both)
+ * @param options         log file, rotation and queue settings
+ * @return true if setup succeeded, false if file setup failed
+ */
+EQUINOX_API bool setup(level::LOG_LEVEL logLevel, const std::string& logPrefix, logs_output::SINK logsOutputSink, const LoggerOptions& options);
+
 /**
  * @brief changeLevel() function to change level of logged messages
  *
@@ -140,11 +201,74 @@ EQUINOX_API void changeLevel(level::LOG_LEVEL logLevel);
  */
 EQUINOX_API bool changeLogsOutputSink(logs_output::SINK logsOutputSink);
 
+/**
+ * @brief changeFormattingMode() function to change where messages are formatted
+ *
+ * @param formattingMode  immediate (formatted on the calling thread) or deferred (arguments are captured
+ *                        on the calling thread and the message is formatted by the logger worker thread)
+ */
+EQUINOX_API void changeFormattingMode(formatting::MODE formattingMode);
+
 /**
  * @brief flush() function to force write any pending log messages
  */
 EQUINOX_API void flush();
 
+/**
+ * @brief getDroppedMessagesCount() function to read how many messages the overflow policy dropped
+ *
+ * @param msgLevel  level of the dropped messages
+ * @return number of messages with the given level dropped since the start of the process
+ */
+EQUINOX_API std::uint64_t getDroppedMessagesCount(level::LOG_LEVEL msgLevel);
+
+/**
+ * @brief getFileWriteStats() function to read the write(2) and fdatasync() latencies of the file sink
+ *
+ * @return counts, total and maximum durations in nanoseconds since the start of the process
+ */
+EQUINOX_API FileWriteStats getFileWriteStats();
+
 } /*namespace equinox*/
 
+/*
+ * Logging macros removed at compile time when their level is below EQUINOX_ACTIVE_LEVEL.
+ * A removed call evaluates none of its arguments and leaves no format string in the binary.
+ */
+#if EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_TRACE
+#define EQUINOX_TRACE(...) equinox::trace(__VA_ARGS__)
+#else
+#define EQUINOX_TRACE(...) (void)0
+#endif
+
+#if EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_DEBUG
+#define EQUINOX_DEBUG(...) equinox::debug(__VA_ARGS__)
+#else
+#define EQUINOX_DEBUG(...) (void)0
+#endif
+
+#if EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_INFO
+#define EQUINOX_INFO(...) equinox::info(__VA_ARGS__)
+#else
+#define EQUINOX_INFO(...) (void)0
+#endif
+
+#if EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_WARNING
+#define EQUINOX_WARNING(...) equinox::warning(__VA_ARGS__)
+#else
+#define EQUINOX_WARNING(...) (void)0
+#endif
+
+#if EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_ERROR
+#define EQUINOX_ERROR(...) equinox::error(__VA_ARGS__)
+#else
+#define EQUINOX_ERROR(...) (void)0
+#endif
+
+#if EQUINOX_ACTIVE_LEVEL <= EQUINOX_LEVEL_CRITICAL
+#define EQUINOX_CRITICAL(...) equinox::critical(__VA_ARGS__)
+#else
+#define EQUINOX_CRITICAL(...) (void)0
+#endif
+
 #endif /* API_EQUINOXLOGGER_H_ */
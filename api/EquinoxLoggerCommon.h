@@ -41,7 +41,9 @@
 #define API_EQUINOXLOGGERCOMMON_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 #if defined(EQUINOX_SHARED_SHARED_LIB)
 #undef EQUINOX_HEADER_ONLY
@@ -61,10 +63,62 @@
 #define EQUINOX_LEVEL_CRITICAL 5
 #define EQUINOX_LEVEL_OFF 6
 
+/* Minimum level compiled into the binary, set with the EQUINOX_LOGGER_ACTIVE_LEVEL CMake option.
+   It has to be the same for every translation unit of the program. */
+#ifndef EQUINOX_ACTIVE_LEVEL
+#define EQUINOX_ACTIVE_LEVEL EQUINOX_LEVEL_TRACE
+#endif
+
 #define EQUINOX_SINK_CONSOLE 0
 #define EQUINOX_SINK_FILE 1
 #define EQUINOX_SINK_CONSOLE_AND_FILE 2
 
+#define EQUINOX_FORMATTING_IMMEDIATE 0
+#define EQUINOX_FORMATTING_DEFERRED 1
+
+#define EQUINOX_QUEUE_SHARED 0
+#define EQUINOX_QUEUE_PER_THREAD 1
+#define EQUINOX_QUEUE_BYTE_RING 2
+#define EQUINOX_QUEUE_PER_CPU 3
+
+#define EQUINOX_OVERFLOW_DROP_OLDEST 0
+#define EQUINOX_OVERFLOW_DROP_NEWEST 1
+#define EQUINOX_OVERFLOW_BLOCK 2
+
+#define EQUINOX_WORKER_WAIT_TIMED 0
+#define EQUINOX_WORKER_WAIT_BLOCKING 1
+#define EQUINOX_WORKER_WAIT_ADAPTIVE 2
+#define EQUINOX_WORKER_WAIT_BUSY_POLL 3
+
+#define EQUINOX_TIMESTAMP_CLOCK_MONOTONIC 0
+#define EQUINOX_TIMESTAMP_CLOCK_REALTIME_COARSE 1
+#define EQUINOX_TIMESTAMP_CLOCK_TSC 2
+
+#define EQUINOX_TIMESTAMP_ZONE_LOCAL 0
+#define EQUINOX_TIMESTAMP_ZONE_UTC 1
+
+#define EQUINOX_TIMESTAMP_PRECISION_MICROSECONDS 0
+#define EQUINOX_TIMESTAMP_PRECISION_NANOSECONDS 1
+
+#define EQUINOX_FILE_DURABILITY_OS_BUFFERED 0
+#define EQUINOX_FILE_DURABILITY_BATCH_SYNC 1
+#define EQUINOX_FILE_DURABILITY_PERIODIC_SYNC 2
+#define EQUINOX_FILE_DURABILITY_SYNC_ON_ERROR 3
+
+#define EQUINOX_FILE_IO_WRITE 0
+#define EQUINOX_FILE_IO_MMAP 1
+#define EQUINOX_FILE_IO_IO_URING 2
+
+#define EQUINOX_FILE_ROTATION_PERIOD_NONE 0
+#define EQUINOX_FILE_ROTATION_PERIOD_HOURLY 1
+#define EQUINOX_FILE_ROTATION_PERIOD_DAILY 2
+
+#define EQUINOX_FILE_PAGE_CACHE_KEEP 0
+#define EQUINOX_FILE_PAGE_CACHE_DROP_BEHIND 1
+
+#define EQUINOX_FILE_COMPRESSION_NONE 0
+#define EQUINOX_FILE_COMPRESSION_GZIP 1
+
 #define __FILENAME__ (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : __FILE__)
 
 namespace equinox {
@@ -89,6 +143,216 @@ namespace logs_output {
 enum class SINK : int { console = EQUINOX_SINK_CONSOLE, file = EQUINOX_SINK_FILE, console_and_file = EQUINOX_SINK_CONSOLE_AND_FILE };
 } /*namespace logs_output*/
 
+namespace formatting {
+enum class MODE : int { immediate = EQUINOX_FORMATTING_IMMEDIATE, deferred = EQUINOX_FORMATTING_DEFERRED };
+} /*namespace formatting*/
+
+namespace queue {
+/*
+ * shared: one queue for all threads
+ * per_thread: one lock-free ring per logging thread, messages are ordered per thread only
+ * byte_ring: one preallocated ring all threads copy their messages into, no allocation per message
+ * per_cpu: one preallocated ring per CPU, for many short-lived threads; messages are ordered per CPU only
+ */
+enum class TYPE : int {
+  shared = EQUINOX_QUEUE_SHARED,
+  per_thread = EQUINOX_QUEUE_PER_THREAD,
+  byte_ring = EQUINOX_QUEUE_BYTE_RING,
+  per_cpu = EQUINOX_QUEUE_PER_CPU
+};
+} /*namespace queue*/
+
+namespace overflow {
+/*
+ * What happens to a message logged while the queue is full:
+ * drop_oldest: the oldest queued message is removed to make room (the ring queues can only drop the newest one)
+ * drop_newest: the new message is dropped
+ * block: the logging thread waits for free space up to the block timeout, then the new message is dropped
+ */
+enum class POLICY : int { drop_oldest = EQUINOX_OVERFLOW_DROP_OLDEST, drop_newest = EQUINOX_OVERFLOW_DROP_NEWEST, block = EQUINOX_OVERFLOW_BLOCK };
+} /*namespace overflow*/
+
+namespace worker_wait {
+/*
+ * How the worker waits for messages when the queue is empty:
+ * timed: inside the queue, waking up every dequeue timeout to check for shutdown
+ * blocking: parked on a futex until a producer wakes it, no wake-ups while idle
+ * adaptive: spins, then yields, then parks like blocking; short gaps between messages never reach the kernel
+ * busy_poll: never sleeps and keeps one core busy, meant for a core isolated for the worker (see workerCpu)
+ */
+enum class STRATEGY : int {
+  timed = EQUINOX_WORKER_WAIT_TIMED,
+  blocking = EQUINOX_WORKER_WAIT_BLOCKING,
+  adaptive = EQUINOX_WORKER_WAIT_ADAPTIVE,
+  busy_poll = EQUINOX_WORKER_WAIT_BUSY_POLL
+};
+} /*namespace worker_wait*/
+
+namespace timestamp_clock {
+/*
+ * Clock read by the logging thread when a message is queued, the worker converts the reading to wall-clock time:
+ * monotonic: CLOCK_MONOTONIC, the worker resamples its offset to the wall clock once a second
+ * realtime_coarse: CLOCK_REALTIME_COARSE, the cheapest read, with the resolution of the kernel tick (1-4 ms)
+ * tsc: the CPU time stamp counter, calibrated by the worker once a second; falls back to monotonic without an invariant TSC
+ */
+enum class SOURCE : int {
+  monotonic = EQUINOX_TIMESTAMP_CLOCK_MONOTONIC,
+  realtime_coarse = EQUINOX_TIMESTAMP_CLOCK_REALTIME_COARSE,
+  tsc = EQUINOX_TIMESTAMP_CLOCK_TSC
+};
+} /*namespace timestamp_clock*/
+
+namespace timestamp_format {
+/*
+ * Every line starts with an ISO-8601 timestamp:
+ * local: [2026-10-17T14:05:09.123456+02:00], the offset of the local time zone is refreshed once a minute
+ * utc: [2026-10-17T12:05:09.123456Z]
+ */
+enum class ZONE : int { local = EQUINOX_TIMESTAMP_ZONE_LOCAL, utc = EQUINOX_TIMESTAMP_ZONE_UTC };
+enum class PRECISION : int { microseconds = EQUINOX_TIMESTAMP_PRECISION_MICROSECONDS, nanoseconds = EQUINOX_TIMESTAMP_PRECISION_NANOSECONDS };
+} /*namespace timestamp_format*/
+
+namespace file_durability {
+/*
+ * The file sink writes the lines of a batch with one write(2); what happens after that:
+ * os_buffered: nothing, the kernel writes the page cache back to the disk when it decides to
+ * batch_sync: fdatasync() after every batch
+ * periodic_sync: fdatasync() at the end of a batch once fileSyncIntervalMs passed or fileSyncBytes were written since the last one
+ * sync_on_error: an error or critical line is written and synced at once, other lines stay OS-buffered
+ */
+enum class MODE : int {
+  os_buffered = EQUINOX_FILE_DURABILITY_OS_BUFFERED,
+  batch_sync = EQUINOX_FILE_DURABILITY_BATCH_SYNC,
+  periodic_sync = EQUINOX_FILE_DURABILITY_PERIODIC_SYNC,
+  sync_on_error = EQUINOX_FILE_DURABILITY_SYNC_ON_ERROR
+};
+} /*namespace file_durability*/
+
+namespace file_io {
+/*
+ * How the file sink gets a batch into the log file:
+ * write: write() on a descriptor opened with O_APPEND, retried until the whole batch is written
+ * mmap: memcpy into the file mapped into memory, preallocated with fallocate() to the max log file size (4 MiB
+ *       steps without rotation), the kernel writes the pages back and the file is cut to its content when closed
+ * io_uring: batches copied into registered buffers and written asynchronously, up to 4 in flight, syncs queued
+ *           behind them; falls back to write when the kernel has no io_uring
+ */
+enum class BACKEND : int { write = EQUINOX_FILE_IO_WRITE, mmap = EQUINOX_FILE_IO_MMAP, io_uring = EQUINOX_FILE_IO_IO_URING };
+} /*namespace file_io*/
+
+namespace file_page_cache {
+/*
+ * What happens to the log file pages in the page cache once they are written:
+ * keep: they stay cached until the kernel needs the memory, possibly pushing out the service's own data
+ * drop_behind: writeback of every full 4 MiB window is started and the window before it is dropped, rotated
+ *              files are dropped by the archiver thread; stream and io_uring backends only, mmap keeps its pages
+ */
+enum class MODE : int { keep = EQUINOX_FILE_PAGE_CACHE_KEEP, drop_behind = EQUINOX_FILE_PAGE_CACHE_DROP_BEHIND };
+} /*namespace file_page_cache*/
+
+namespace file_compression {
+/*
+ * What the background archiver thread does with a rotated file:
+ * none: keeps it as it is
+ * gzip: compresses logs_1.log to logs_1.log.gz and removes logs_1.log, needs a build with zlib (EQUINOX_LOGGER_ZLIB)
+ */
+enum class MODE : int { none = EQUINOX_FILE_COMPRESSION_NONE, gzip = EQUINOX_FILE_COMPRESSION_GZIP };
+} /*namespace file_compression*/
+
+namespace file_rotation {
+/*
+ * When the file sink starts a new segment besides reaching maxLogFileSizeBytes (0 turns the size limit off):
+ * none: only by size
+ * hourly: at the start of every hour, segments are named logs_2026-10-17T14_<sequence>.log
+ * daily: at midnight, segments are named logs_2026-10-17_<sequence>.log
+ * Boundaries follow timestampZone, a line goes to the segment of the period it was logged in.
+ */
+enum class PERIOD : int {
+  none = EQUINOX_FILE_ROTATION_PERIOD_NONE,
+  hourly = EQUINOX_FILE_ROTATION_PERIOD_HOURLY,
+  daily = EQUINOX_FILE_ROTATION_PERIOD_DAILY
+};
+} /*namespace file_rotation*/
+
+/**
+ * Settings accepted by setup(); members not set keep their default values
+ */
+struct LoggerOptions {
+  std::string logFileName = kLogFileName;
+  std::size_t maxLogFileSizeBytes = kDefaultMaxLogFileSizeBytes;
+  std::size_t maxLogFiles = kDefaultMaxLogFiles;
+  queue::TYPE queueType = queue::TYPE::shared;
+  /* byte_ring only: back the ring with huge pages, falls back to transparent huge pages when none are reserved */
+  bool queueHugePages = false;
+  overflow::POLICY overflowPolicy = overflow::POLICY::drop_oldest;
+  std::uint32_t overflowBlockTimeoutMs = 100U;
+  /* Messages for shared (10000) and per_thread (1024 per thread), bytes for byte_ring (4 MiB) and per_cpu (256 KiB per CPU); 0 keeps the default */
+  std::size_t queueCapacity = 0U;
+  /* Most records the worker takes from the queue at once */
+  std::size_t batchSize = 64U;
+  /* timed wait strategy only: how long the idle worker waits for a record before checking for shutdown */
+  std::uint32_t dequeueTimeoutMs = 50U;
+  /* Start with small batches for low latency, grow them while the queue stays deep and shrink them when it drains */
+  bool adaptiveBatching = false;
+  worker_wait::STRATEGY workerWaitStrategy = worker_wait::STRATEGY::timed;
+  /* CPU the worker thread is pinned to, -1 lets the scheduler choose */
+  int workerCpu = -1;
+  /* SCHED_FIFO priority of the worker thread (1-99), 0 keeps the default scheduling policy */
+  int workerPriority = 0;
+  timestamp_clock::SOURCE timestampClock = timestamp_clock::SOURCE::monotonic;
+  timestamp_format::ZONE timestampZone = timestamp_format::ZONE::local;
+  timestamp_format::PRECISION timestampPrecision = timestamp_format::PRECISION::microseconds;
+  /* Longest time a console line waits in the worker's batch buffer while the queue stays busy, 0 writes every line at once */
+  std::uint32_t consoleFlushIntervalMs = 10U;
+  file_io::BACKEND fileIoBackend = file_io::BACKEND::write;
+  file_durability::MODE fileDurability = file_durability::MODE::os_buffered;
+  /* periodic_sync only */
+  std::uint32_t fileSyncIntervalMs = 1000U;
+  std::size_t fileSyncBytes = 1024U * 1024U;
+  file_page_cache::MODE filePageCache = file_page_cache::MODE::keep;
+  file_compression::MODE fileCompression = file_compression::MODE::none;
+  file_rotation::PERIOD fileRotationPeriod = file_rotation::PERIOD::none;
+};
+
+/**
+ * Latencies of the file sink since the start of the process, in nanoseconds:
+ * one write is the write(2) of a batch, one sync an fdatasync().
+ * The failed counts are the writes whose lines were lost and the syncs that reported an error.
+ */
+struct FileWriteStats {
+  std::uint64_t writeCount = 0U;
+  std::uint64_t writeTotalNs = 0U;
+  std::uint64_t writeMaxNs = 0U;
+  std::uint64_t syncCount = 0U;
+  std::uint64_t syncTotalNs = 0U;
+  std::uint64_t syncMaxNs = 0U;
+  std::uint64_t failedWriteCount = 0U;
+  std::uint64_t failedSyncCount = 0U;
+};
+
+/**
+ * Non-owning view of a format string accepted by the logging functions.
+ * String literals, std::string_view and std::string convert to it without copying the characters.
+ */
+class FormatString {
+ public:
+  constexpr FormatString(const char* format) : mFormat_{format}, mNullTerminated_{true} {}
+  constexpr FormatString(std::string_view format) : mFormat_{format}, mNullTerminated_{false} {}
+  FormatString(const std::string& format) : mFormat_{format}, mNullTerminated_{true} {}
+
+  constexpr const char* data() const { return mFormat_.data(); }
+  constexpr std::size_t size() const { return mFormat_.size(); }
+  constexpr std::string_view view() const { return mFormat_; }
+
+  /* A std::string_view may point into a larger buffer, so it can not be passed to snprintf as is */
+  constexpr bool isNullTerminated() const { return mNullTerminated_; }
+
+ private:
+  std::string_view mFormat_;
+  bool mNullTerminated_;
+};
+
+
 } /*namespace equinox*/
 
 #endif /* API_EQUINOXLOGGERCOMMON_H_ */
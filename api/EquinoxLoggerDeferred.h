@@ -0,0 +1,143 @@
+/*
+ * EquinoxLoggerDeferred.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef API_EQUINOXLOGGERDEFERRED_H_
+#define API_EQUINOXLOGGERDEFERRED_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace equinox {
+
+    namespace deferred {
+
+        /**
+         * Tags describing how a captured printf argument is stored in the encoded message.
+         * The encoded message layout is: [uint32 format size][format bytes]{[uint8 tag][payload]}...
+         */
+        enum class ARGUMENT_TYPE : std::uint8_t {
+            signed_integer = 0,
+            unsigned_integer = 1,
+            floating = 2,
+            long_floating = 3,
+            string = 4,
+            null_string = 5,
+            pointer = 6
+        };
+
+        template <typename T>
+        inline void appendRaw(std::string& encodedMessage, const T& value) {
+            encodedMessage.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        inline void appendString(std::string& encodedMessage, const char* data, std::size_t size) {
+            encodedMessage.push_back(static_cast<char>(ARGUMENT_TYPE::string));
+            appendRaw(encodedMessage, static_cast<std::uint32_t>(size));
+            encodedMessage.append(data, size);
+        }
+
+        /**
+         * Copies a single printf argument into the encoded message without formatting it
+         *
+         * @param encodedMessage The buffer the argument is appended to
+         * @param argument The argument passed by the caller
+         */
+        template <typename T>
+        inline void encodeArgument(std::string& encodedMessage, const T& argument) {
+            using ArgumentType = std::decay_t<T>;
+
+            if constexpr (std::is_array_v<T> && (std::is_same_v<ArgumentType, char*> || std::is_same_v<ArgumentType, const char*>)) {
+                appendString(encodedMessage, argument, std::strlen(argument));
+            } else if constexpr (std::is_same_v<ArgumentType, char*> || std::is_same_v<ArgumentType, const char*>) {
+                if (argument == nullptr) {
+                    encodedMessage.push_back(static_cast<char>(ARGUMENT_TYPE::null_string));
+                } else {
+                    appendString(encodedMessage, argument, std::strlen(argument));
+                }
+            } else if constexpr (std::is_same_v<ArgumentType, std::string> || std::is_same_v<ArgumentType, std::string_view>) {
+                appendString(encodedMessage, argument.data(), argument.size());
+            } else if constexpr (std::is_same_v<ArgumentType, long double>) {
+                encodedMessage.push_back(static_cast<char>(ARGUMENT_TYPE::long_floating));
+                appendRaw(encodedMessage, argument);
+            } else if constexpr (std::is_floating_point_v<ArgumentType>) {
+                encodedMessage.push_back(static_cast<char>(ARGUMENT_TYPE::floating));
+                appendRaw(encodedMessage, static_cast<double>(argument));
+            } else if constexpr (std::is_enum_v<ArgumentType>) {
+                encodeArgument(encodedMessage, static_cast<std::underlying_type_t<ArgumentType>>(argument));
+            } else if constexpr (std::is_integral_v<ArgumentType> && std::is_signed_v<ArgumentType>) {
+                encodedMessage.push_back(static_cast<char>(ARGUMENT_TYPE::signed_integer));
+                appendRaw(encodedMessage, static_cast<std::int64_t>(argument));
+            } else if constexpr (std::is_integral_v<ArgumentType>) {
+                encodedMessage.push_back(static_cast<char>(ARGUMENT_TYPE::unsigned_integer));
+                appendRaw(encodedMessage, static_cast<std::uint64_t>(argument));
+            } else if constexpr (std::is_pointer_v<ArgumentType> || std::is_null_pointer_v<ArgumentType>) {
+                encodedMessage.push_back(static_cast<char>(ARGUMENT_TYPE::pointer));
+                appendRaw(encodedMessage, reinterpret_cast<std::uintptr_t>(argument));
+            } else {
+                static_assert(std::is_pointer_v<ArgumentType>, "Unsupported argument type for printf-style logging");
+            }
+        }
+
+        /**
+         * Captures the format string and the raw arguments of a log call so that the
+         * formatting itself can be done later on the worker thread
+         *
+         * @param encodedMessage The buffer with the encoded message (cleared first, capacity is reused)
+         * @param format Pointer to the format string
+         * @param formatSize Size of the format string in bytes
+         * @param args Arguments of the log call
+         */
+        template <typename... Args>
+        inline void encodeMessage(std::string& encodedMessage, const char* format, std::size_t formatSize, const Args&... args) {
+            encodedMessage.clear();
+            appendRaw(encodedMessage, static_cast<std::uint32_t>(formatSize));
+            encodedMessage.append(format, formatSize);
+            (encodeArgument(encodedMessage, args), ...);
+        }
+
+    } /*namespace deferred*/
+
+} /*namespace equinox*/
+
+#endif /* API_EQUINOXLOGGERDEFERRED_H_ */
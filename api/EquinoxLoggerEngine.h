@@ -40,12 +40,16 @@
 #ifndef API_EQUINOXLOGGERENGINE_H_
 #define API_EQUINOXLOGGERENGINE_H_
 
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 
 #include "EquinoxLoggerCommon.h"
+#include "EquinoxLoggerDeferred.h"
 #include "IEquinoxLoggerEngineImpl.h"
 
 namespace equinox {
@@ -61,16 +65,67 @@ namespace equinox {
         void operator=(const EquinoxLoggerEngine&) = delete;
         void operator=(const EquinoxLoggerEngine&&) = delete;
 
+        /**
+         * Lock-free check if a message with the given level passes the current log level
+         *
+         * @param msgLevel level of the message
+         * @return true if the message would be logged
+         */
+        bool isLevelEnabled(level::LOG_LEVEL msgLevel) const {
+            return (msgLevel != level::LOG_LEVEL::off) && (msgLevel >= mLogLevel_.load(std::memory_order_relaxed));
+        }
+
+        template <typename... Args>
+        void log(level::LOG_LEVEL msgLevel, FormatString msgFormat, Args&&... args) {
+            logImpl(msgLevel, false, msgFormat, std::forward<Args>(args)...);
+        }
+
+        /**
+         * Same as log() but never waits for space in the queue, not even with the block overflow policy
+         *
+         * @return false if the message was dropped because the queue was full or it could not be formatted
+         */
+        template <typename... Args>
+        bool tryLog(level::LOG_LEVEL msgLevel, FormatString msgFormat, Args&&... args) {
+            return logImpl(msgLevel, true, msgFormat, std::forward<Args>(args)...);
+        }
+
+        bool setup(equinox::level::LOG_LEVEL logLevel, const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink,
+                   const std::string& logFileName = kLogFileName, std::size_t maxLogFileSizeBytes = kDefaultMaxLogFileSizeBytes,
+                   std::size_t maxLogFiles = kDefaultMaxLogFiles);
+        bool setup(equinox::level::LOG_LEVEL logLevel, const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink, const LoggerOptions& options);
+        void changeLevel(level::LOG_LEVEL logLevel);
+        bool changeLogsOutputSink(logs_output::SINK logsOutputSink);
+        void changeFormattingMode(formatting::MODE formattingMode);
+        void flush();
+        std::uint64_t getDroppedMessagesCount(level::LOG_LEVEL msgLevel);
+        FileWriteStats getFileWriteStats();
+
+       protected:
+        EquinoxLoggerEngine();
+        EquinoxLoggerEngine(std::unique_ptr<IEquinoxLoggerEngineImpl> mEquinoxLoggerEngineImpl);
+
+       private:
         template <typename... Args>
-        void log(level::LOG_LEVEL msgLevel, const std::string& msgFormat, Args&&... args) {
+        bool logImpl(level::LOG_LEVEL msgLevel, bool nonBlocking, FormatString msgFormat, Args&&... args) {
+            if (!isLevelEnabled(msgLevel)) {
+                return true;
+            }
+
+            if (mFormattingMode_.load(std::memory_order_relaxed) == formatting::MODE::deferred) {
+                std::string& encodedMessage = getEncodedMessageBuffer();
+                deferred::encodeMessage(encodedMessage, msgFormat.data(), msgFormat.size(), args...);
+                return mEquinoxLoggerEngineImpl_->logDeferredMessage(msgLevel, getCallSiteId(msgFormat), encodedMessage, nonBlocking);
+            }
+
             constexpr size_t kMaxMessageSize = 4096;
             char messageBuffer[kMaxMessageSize];
 
-            int written = std::snprintf(messageBuffer, kMaxMessageSize, msgFormat.c_str(), std::forward<Args>(args)...);
+            int written = std::snprintf(messageBuffer, kMaxMessageSize, getNullTerminatedFormat(msgFormat), std::forward<Args>(args)...);
 
             if (written < 0) {
                 std::cout << "[EquinoxLoggerEngine] Message formatting error" << std::endl;
-                return;
+                return false;
             }
 
             if (static_cast<size_t>(written) >= kMaxMessageSize) {
@@ -78,25 +133,39 @@ namespace equinox {
                 written = kMaxMessageSize - 1;
             }
 
-            std::string mFormattedOutputMessage_(messageBuffer, static_cast<size_t>(written));
-            std::lock_guard<std::mutex> lock(mEngineMutex_);
-            mEquinoxLoggerEngineImpl_->logMessage(msgLevel, mFormattedOutputMessage_);
+            return mEquinoxLoggerEngineImpl_->logMessage(msgLevel, getCallSiteId(msgFormat), std::string_view(messageBuffer, static_cast<size_t>(written)),
+                                                         nonBlocking);
         }
 
-        bool setup(equinox::level::LOG_LEVEL logLevel, const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink,
-                   const std::string& logFileName = kLogFileName, std::size_t maxLogFileSizeBytes = kDefaultMaxLogFileSizeBytes,
-                   std::size_t maxLogFiles = kDefaultMaxLogFiles);
-        void changeLevel(level::LOG_LEVEL logLevel);
-        bool changeLogsOutputSink(logs_output::SINK logsOutputSink);
-        void flush();
+        /* The address of the format string folded to 32 bits, free to compute; every call with the same literal gets the same id */
+        static std::uint32_t getCallSiteId(FormatString msgFormat) {
+            const auto formatAddress = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(msgFormat.data()));
+            return static_cast<std::uint32_t>(formatAddress ^ (formatAddress >> 32U));
+        }
 
-       protected:
-        EquinoxLoggerEngine();
-        EquinoxLoggerEngine(std::unique_ptr<IEquinoxLoggerEngineImpl> mEquinoxLoggerEngineImpl);
+        /* One buffer per thread shared by all log() instantiations; it keeps its capacity between calls */
+        static std::string& getEncodedMessageBuffer() {
+            thread_local std::string encodedMessage;
+            return encodedMessage;
+        }
+
+        static const char* getNullTerminatedFormat(FormatString msgFormat) {
+            if (msgFormat.isNullTerminated()) {
+                return msgFormat.data();
+            }
+
+            /* Reuses its capacity, so only the first call on a thread with a longer format allocates */
+            thread_local std::string nullTerminatedFormat;
+            nullTerminatedFormat.assign(msgFormat.data(), msgFormat.size());
+            return nullTerminatedFormat.c_str();
+        }
 
-       private:
         std::unique_ptr<IEquinoxLoggerEngineImpl> mEquinoxLoggerEngineImpl_;
+        /* Serializes setup and reconfiguration only, log() does not take it */
         mutable std::mutex mEngineMutex_;
+        std::atomic<formatting::MODE> mFormattingMode_;
+        /* The only copy of the level, the implementation gets the messages that passed it */
+        std::atomic<level::LOG_LEVEL> mLogLevel_;
     };
 
 } /*namespace equinox*/
@@ -0,0 +1,132 @@
+/*
+ * FileBackendBenchmark.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "FileLogsProducer.h"
+#include "LogRecordHeader.h"
+#include "TimestampProducer.h"
+
+namespace {
+constexpr std::size_t kLinesPerRun = 500000U;
+constexpr std::size_t kSyncedLinesPerRun = 50000U;
+/* The worker writes the file once it drained a batch, the queue batch size default */
+constexpr std::size_t kLinesPerBatch = 64U;
+constexpr const char* kBenchmarkLogFile = "/tmp/equinox_file_backend_benchmark.log";
+
+/* Exposes the file sink to the benchmark the same way the tests do */
+class BenchmarkFileLogsProducer : public equinox::FileLogsProducer {
+   public:
+    explicit BenchmarkFileLogsProducer(std::shared_ptr<equinox::ITimestampProducer> timestampProducer) : FileLogsProducer(timestampProducer) {}
+
+    using FileLogsProducer::GetIoBackend;
+};
+
+struct BackendResult {
+    double linesPerSecond;
+    double averageWriteNs;
+    bool fellBack;
+};
+
+/* Sink side throughput of one backend, rotation off so every run writes one growing file */
+BackendResult measureBackend(equinox::file_io::BACKEND ioBackend, equinox::file_durability::MODE durabilityMode, std::size_t lines) {
+    std::filesystem::remove(kBenchmarkLogFile);
+    BackendResult result{0.0, 0.0, false};
+    {
+        BenchmarkFileLogsProducer fileLogsProducer(std::make_shared<equinox::TimestampProducer>());
+        fileLogsProducer.setLogPrefix("[FileBackendBenchmark]");
+        fileLogsProducer.setIoBackend(ioBackend);
+        fileLogsProducer.setDurability(durabilityMode, 0U, 0U);
+        fileLogsProducer.setupFile(kBenchmarkLogFile, 0U, 0U);
+        result.fellBack = fileLogsProducer.GetIoBackend() != ioBackend;
+
+        const std::string message = "File sink backend message with a typical payload text: payload";
+        const auto begin = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < lines; ++i) {
+            const equinox::LogRecordMetadata metadata{equinox::level::LOG_LEVEL::info,
+                                                      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count(),
+                                                      0U, 0U};
+            fileLogsProducer.logMessage(message, metadata);
+            if ((i + 1U) % kLinesPerBatch == 0U) {
+                fileLogsProducer.flush();
+            }
+        }
+        fileLogsProducer.flush();
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin);
+
+        const equinox::FileWriteStats stats = fileLogsProducer.getWriteStats();
+        result.linesPerSecond = static_cast<double>(lines) / elapsed.count();
+        result.averageWriteNs = (stats.writeCount > 0U) ? static_cast<double>(stats.writeTotalNs) / static_cast<double>(stats.writeCount) : 0.0;
+    }
+    std::filesystem::remove(kBenchmarkLogFile);
+    return result;
+}
+}  // namespace
+
+int main() {
+    const struct {
+        const char* name;
+        equinox::file_io::BACKEND ioBackend;
+    } kBackends[] = {{"write", equinox::file_io::BACKEND::write},
+                     {"mmap", equinox::file_io::BACKEND::mmap},
+                     {"io_uring", equinox::file_io::BACKEND::io_uring}};
+    const struct {
+        const char* name;
+        equinox::file_durability::MODE durabilityMode;
+        std::size_t lines;
+    } kDurabilityModes[] = {{"os_buffered", equinox::file_durability::MODE::os_buffered, kLinesPerRun},
+                            {"batch_sync", equinox::file_durability::MODE::batch_sync, kSyncedLinesPerRun}};
+
+    std::printf("%-12s %-14s %14s %18s\n", "Backend", "Durability", "lines/s", "avg write ns");
+    for (const auto& durabilityMode : kDurabilityModes) {
+        for (const auto& backend : kBackends) {
+            const BackendResult result = measureBackend(backend.ioBackend, durabilityMode.durabilityMode, durabilityMode.lines);
+            std::printf("%-12s %-14s %14.0f %18.0f%s\n", backend.name, durabilityMode.name, result.linesPerSecond, result.averageWriteNs,
+                        result.fellBack ? "  (not available, write used)" : "");
+        }
+    }
+    std::printf("(io_uring write latency is from submission to completion, the worker does not wait for it)\n");
+
+    return 0;
+}
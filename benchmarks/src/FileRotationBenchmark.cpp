@@ -0,0 +1,124 @@
+/*
+ * FileRotationBenchmark.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FileLogsProducer.h"
+#include "LogRecordHeader.h"
+#include "TimestampProducer.h"
+
+namespace {
+constexpr std::size_t kLinesPerRun = 500000U;
+/* The worker writes the file once it drained a batch, the queue batch size default */
+constexpr std::size_t kLinesPerBatch = 64U;
+constexpr std::size_t kMaxLogFileSizeBytes = 4U * 1024U * 1024U;
+constexpr std::size_t kMaxLogFiles = 3U;
+constexpr const char* kBenchmarkLogFile = "/tmp/equinox_file_rotation_benchmark.log";
+
+/* Exposes the file sink to the benchmark the same way the tests do */
+class BenchmarkFileLogsProducer : public equinox::FileLogsProducer {
+   public:
+    explicit BenchmarkFileLogsProducer(std::shared_ptr<equinox::ITimestampProducer> timestampProducer) : FileLogsProducer(timestampProducer) {}
+
+    using FileLogsProducer::GetLogFileName;
+};
+
+/* The segments of earlier runs would be continued */
+void removeBenchmarkLogFiles() {
+    const std::filesystem::path benchmarkLogFile(kBenchmarkLogFile);
+    std::vector<std::filesystem::path> segments;
+    for (const auto& entry : std::filesystem::directory_iterator(benchmarkLogFile.parent_path())) {
+        if (entry.path().filename().string().rfind(benchmarkLogFile.stem().string(), 0U) == 0U) {
+            segments.push_back(entry.path());
+        }
+    }
+    for (const auto& segment : segments) {
+        std::filesystem::remove(segment);
+    }
+}
+
+/* Sink side throughput with rotation enabled, statPerLine adds the file_size() call rotation used to make per line */
+double measureLinesPerSecond(bool statPerLine, std::uintmax_t& statChecksum) {
+    removeBenchmarkLogFiles();
+
+    BenchmarkFileLogsProducer fileLogsProducer(std::make_shared<equinox::TimestampProducer>());
+    fileLogsProducer.setLogPrefix("[FileRotationBenchmark]");
+    fileLogsProducer.setupFile(kBenchmarkLogFile, kMaxLogFileSizeBytes, kMaxLogFiles);
+
+    const std::string message = "Rotated file sink message with a typical payload text: payload";
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < kLinesPerRun; ++i) {
+        const equinox::LogRecordMetadata metadata{equinox::level::LOG_LEVEL::info,
+                                                  std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count(),
+                                                  0U, 0U};
+        fileLogsProducer.logMessage(message, metadata);
+        if (statPerLine) {
+            std::error_code errorCode;
+            statChecksum += std::filesystem::file_size(fileLogsProducer.GetLogFileName(), errorCode);
+        }
+        if ((i + 1U) % kLinesPerBatch == 0U) {
+            fileLogsProducer.flush();
+        }
+    }
+    fileLogsProducer.flush();
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin);
+
+    return static_cast<double>(kLinesPerRun) / elapsed.count();
+}
+}  // namespace
+
+int main() {
+    std::uintmax_t statChecksum = 0U;
+    const double statPerLineLinesPerSecond = measureLinesPerSecond(true, statChecksum);
+    const double trackedSizeLinesPerSecond = measureLinesPerSecond(false, statChecksum);
+
+    std::printf("%-48s %14s %12s\n", "Scenario", "lines/s", "ns/line");
+    std::printf("%-48s %14.0f %12.2f\n", "file_size() stat per line (before)", statPerLineLinesPerSecond, 1e9 / statPerLineLinesPerSecond);
+    std::printf("%-48s %14.0f %12.2f\n", "size tracked in memory (after)", trackedSizeLinesPerSecond, 1e9 / trackedSizeLinesPerSecond);
+    std::printf("(checksum %ju)\n", statChecksum);
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * LevelGateBenchmark.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include <mutex>
+#include <string>
+
+#include "EquinoxLogger.h"
+
+namespace {
+constexpr std::size_t kDisabledIterations = 10000000U;
+constexpr std::size_t kEnabledIterations = 100000U;
+constexpr const char* kBenchmarkLogFile = "/tmp/equinox_level_gate_benchmark.log";
+
+template <typename Function>
+double measureNsPerCall(std::size_t iterations, Function&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        function(i);
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return static_cast<double>(elapsed.count()) / static_cast<double>(iterations);
+}
+
+/* Work a suppressed call used to do before the level was checked: format, copy and lock */
+void formatCopyAndLockWithoutLogging(std::mutex& mutex, std::size_t& sink, const std::string& format, std::size_t value, const char* text) {
+    char messageBuffer[4096];
+    int written = std::snprintf(messageBuffer, sizeof(messageBuffer), format.c_str(), value, text);
+    std::string formattedMessage(messageBuffer, static_cast<std::size_t>(written));
+    std::lock_guard<std::mutex> lock(mutex);
+    sink += formattedMessage.size();
+}
+}  // namespace
+
+int main() {
+    std::remove(kBenchmarkLogFile);
+    equinox::setup(equinox::level::LOG_LEVEL::info, "LevelGateBenchmark", equinox::logs_output::SINK::file, kBenchmarkLogFile, 0U, 0U);
+
+    const double disabledNs = measureNsPerCall(kDisabledIterations, [](std::size_t i) { equinox::trace("Suppressed trace value: %zu text: %s", i, "payload"); });
+
+    std::mutex mutex;
+    std::size_t sink = 0U;
+    const double formatBeforeCheckNs = measureNsPerCall(kDisabledIterations / 10U, [&](std::size_t i) {
+        formatCopyAndLockWithoutLogging(mutex, sink, "Suppressed trace value: %zu text: %s", i, "payload");
+    });
+
+    const double enabledNs = measureNsPerCall(kEnabledIterations, [](std::size_t i) { equinox::info("Enabled info value: %zu text: %s", i, "payload"); });
+    equinox::flush();
+
+    std::printf("%-48s %12s\n", "Scenario", "ns/call");
+    std::printf("%-48s %12.2f\n", "trace() below level (atomic gate)", disabledNs);
+    std::printf("%-48s %12.2f\n", "trace() below level (format + copy + lock)", formatBeforeCheckNs);
+    std::printf("%-48s %12.2f\n", "info() at level (enqueued to file sink)", enabledNs);
+    std::printf("(checksum %zu)\n", sink);
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * ThreadScalabilityBenchmark.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "EquinoxLogger.h"
+
+namespace {
+constexpr std::size_t kMessagesPerThread = 50000U;
+constexpr std::size_t kThreadCounts[] = {1U, 2U, 4U, 8U, 16U, 32U};
+constexpr std::chrono::seconds kDrainDelay{2};
+constexpr const char* kBenchmarkLogFile = "/tmp/equinox_thread_scalability_benchmark.log";
+
+/* Producer side throughput: all threads start together and log until each has sent its share */
+double measureMessagesPerSecond(std::size_t threadCount) {
+    std::atomic<std::size_t> readyThreads{0U};
+    std::atomic<bool> start{false};
+    std::vector<std::thread> producers;
+    producers.reserve(threadCount);
+
+    for (std::size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+        producers.emplace_back([&readyThreads, &start, threadIndex]() {
+            readyThreads.fetch_add(1U);
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+
+            for (std::size_t i = 0; i < kMessagesPerThread; ++i) {
+                equinox::info("Thread %zu message %zu text: %s", threadIndex, i, "payload");
+            }
+        });
+    }
+
+    while (readyThreads.load() != threadCount) {
+        std::this_thread::yield();
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    start.store(true);
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin);
+
+    return static_cast<double>(threadCount * kMessagesPerThread) / elapsed.count();
+}
+}  // namespace
+
+int main() {
+    const struct {
+        const char* name;
+        equinox::queue::TYPE type;
+    } kQueueTypes[] = {{"shared", equinox::queue::TYPE::shared},
+                       {"per_thread", equinox::queue::TYPE::per_thread},
+                       {"byte_ring", equinox::queue::TYPE::byte_ring},
+                       {"per_cpu", equinox::queue::TYPE::per_cpu}};
+
+    for (const auto& queueType : kQueueTypes) {
+        std::remove(kBenchmarkLogFile);
+        equinox::LoggerOptions options;
+        options.logFileName = kBenchmarkLogFile;
+        options.maxLogFileSizeBytes = 0U;
+        options.maxLogFiles = 0U;
+        options.queueType = queueType.type;
+        equinox::setup(equinox::level::LOG_LEVEL::info, "ThreadScalabilityBenchmark", equinox::logs_output::SINK::file, options);
+
+        std::printf("Queue: %s\n", queueType.name);
+        std::printf("%-12s %16s %16s\n", "Threads", "msgs/s", "speedup");
+        double singleThreadMessagesPerSecond = 0.0;
+        for (const std::size_t threadCount : kThreadCounts) {
+            const double messagesPerSecond = measureMessagesPerSecond(threadCount);
+            if (threadCount == 1U) {
+                singleThreadMessagesPerSecond = messagesPerSecond;
+            }
+            std::printf("%-12zu %16.0f %16.2f\n", threadCount, messagesPerSecond, messagesPerSecond / singleThreadMessagesPerSecond);
+            equinox::flush();
+        }
+        std::printf("\n");
+
+        /* Let the worker write out the backlog before the log file is set up again */
+        std::this_thread::sleep_for(kDrainDelay);
+    }
+    std::printf("(hardware threads: %u)\n", std::thread::hardware_concurrency());
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * AdaptiveBatchSize.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_ADAPTIVEBATCHSIZE_H_
+#define INCLUDE_ADAPTIVEBATCHSIZE_H_
+
+#include <cstddef>
+
+namespace equinox {
+
+    /*
+     * Batch size of the worker: fixed at the maximum, or in adaptive mode doubled after every full batch
+     * (the queue is deeper than the batch) and halved when a batch uses a quarter of it or less (the queue is idle).
+     */
+    class AdaptiveBatchSize {
+       public:
+        AdaptiveBatchSize(std::size_t minBatchSize, std::size_t maxBatchSize, bool adaptive);
+        void configure(std::size_t maxBatchSize, bool adaptive);
+        /* Called with the number of records the last batch of get() size consumed */
+        void update(std::size_t consumedRecords);
+        std::size_t get() const;
+
+       private:
+        std::size_t mMinBatchSize_;
+        std::size_t mMaxBatchSize_;
+        bool mAdaptive_;
+        std::size_t mBatchSize_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_ADAPTIVEBATCHSIZE_H_ */
@@ -55,9 +55,11 @@ class AsyncLogQueue : public IAsyncLogQueue {
  public:
   explicit AsyncLogQueue(size_t queue_max_size);
   ~AsyncLogQueue();
-  void enqueue(const std::string& log_message) override;
+  bool enqueue(const std::string& log_message) override;
+  bool tryEnqueue(const std::string& log_message) override;
   bool dequeue(std::vector<std::string>& out, size_t max_batch_size, uint32_t timeout_ms) override;
   void stop() override;
+  void setOverflowPolicy(overflow::POLICY policy, uint32_t block_timeout_ms, const LogRecordVisitor& dropped_record_visitor) override;
 
  protected:
   std::deque<std::string>& getLogMessagesQueue();
@@ -65,11 +67,19 @@ class AsyncLogQueue : public IAsyncLogQueue {
   bool getStopRequested();
 
  private:
+  bool push(const std::string& log_message, bool may_wait);
+
   size_t mQueueMaxSize_;
   std::deque<std::string> mLogMessagesQueue_;
   std::mutex mLogMessagesQueueMutex_;
   std::condition_variable mDataInQueueAvailableConditionVariable_;
+  std::condition_variable mSpaceInQueueAvailableConditionVariable_;
   bool mStopRequested_;
+  overflow::POLICY mOverflowPolicy_;
+  uint32_t mBlockTimeoutMs_;
+  LogRecordVisitor mDroppedRecordVisitor_;
+  size_t mWaitingProducers_;
+  size_t mWaitingConsumers_;
 };
 }  // namespace equinox
 
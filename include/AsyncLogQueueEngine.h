@@ -43,14 +43,23 @@
 #include <atomic>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
+#include "AdaptiveBatchSize.h"
 #include "AsyncLogQueue.h"
 #include "ConsoleLogsProducer.h"
+#include "DeferredMessageFormatter.h"
 #include "EquinoxLoggerCommon.h"
 #include "FileLogsProducer.h"
+#include "InFlightProducers.h"
 #include "IAsyncLogQueueEngine.h"
+#include "LogClock.h"
+#include "LogRecordHeader.h"
+#include "OverflowStats.h"
 #include "TimestampProducer.h"
+#include "WorkerParking.h"
 
 namespace equinox {
 
@@ -59,10 +68,14 @@ namespace equinox {
         explicit AsyncLogQueueEngine(std::shared_ptr<ITimestampProducer> timestamp_procducer, std::shared_ptr<IFileLogsProducer> fileLogsProducer,
                                      logs_output::SINK logsOutputSink);
         ~AsyncLogQueueEngine();
-        void processLogMessage(const std::string& messageToProcess);
+        bool processLogMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, std::string_view messageToProcess, bool nonBlocking);
+        bool processDeferredLogMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, const std::string& encodedMessage, bool nonBlocking);
+        std::uint64_t getDroppedMessagesCount(level::LOG_LEVEL msgLevel);
         void stopWorker();
         void startWorkerIfNeeded();
         void setLogsOutputSink(logs_output::SINK logsOutputSink);
+        void setLogPrefix(const std::string& logPrefix);
+        void configureQueue(const LoggerOptions& options);
         void flush();
 
        protected:
@@ -72,7 +85,50 @@ namespace equinox {
                             std::unique_ptr<IAsyncLogQueue> logMessageQueue);
 
        private:
-        std::unique_ptr<IAsyncLogQueue> mLogMessageQueue_;
+        void appendLogRecordHeader(std::string& logRecord, char recordType, level::LOG_LEVEL msgLevel, std::uint32_t callSiteId);
+        bool enqueueLogRecord(level::LOG_LEVEL msgLevel, const std::string& logRecord, bool nonBlocking);
+        void applyOverflowPolicy(IAsyncLogQueue& logMessageQueue, const LoggerOptions& options);
+        void writeDroppedMessagesMarker();
+        void writeRenderedMessage(const LogRecordMetadata& metadata);
+        void writePendingLines();
+        std::unique_ptr<IAsyncLogQueue> createLogMessageQueue(const LoggerOptions& options) const;
+        void waitForLogRecords(IAsyncLogQueue& logMessageQueue, const LogRecordVisitor& dispatch, std::size_t maxBatchSize,
+                               worker_wait::STRATEGY waitStrategy, std::size_t idleRounds);
+        void parkWorker(IAsyncLogQueue& logMessageQueue, const LogRecordVisitor& dispatch, std::size_t maxBatchSize);
+        bool renderLogRecord(std::string_view logRecord, std::string& renderedMessage);
+        void dispatchLogRecord(std::string_view logRecord);
+        /* Worker: writes what is in the replaced queues, frees the ones their producers left */
+        void drainRetiredLogMessageQueues(const LogRecordVisitor& dispatch, std::size_t maxBatchSize);
+
+        /* Producers enqueue to the current queue without locking, configureQueue() replaces it */
+        std::atomic<IAsyncLogQueue*> mLogMessageQueue_;
+        std::unique_ptr<IAsyncLogQueue> mOwnedLogMessageQueue_;
+        /* Producers holding mLogMessageQueue_, a replaced queue is retired once they left */
+        InFlightProducers mInFlightProducers_;
+        struct RetiredLogMessageQueue {
+            std::unique_ptr<IAsyncLogQueue> logMessageQueue;
+            /* No producer can enqueue to it any more, it is freed once drained */
+            bool producersLeft;
+        };
+        /* Replaced queues, oldest first, the worker writes their records before the ones in the current queue */
+        std::vector<RetiredLogMessageQueue> mRetiredLogMessageQueues_;
+        std::atomic<bool> mLogMessageQueuesRetired_;
+        std::mutex mRetiredLogMessageQueuesMutex_;
+        queue::TYPE mQueueType_;
+        bool mQueueHugePages_;
+        std::size_t mQueueCapacity_;
+        /* Read by the worker before every batch */
+        std::atomic<std::size_t> mBatchSize_;
+        std::atomic<bool> mAdaptiveBatching_;
+        std::atomic<uint32_t> mDequeueTimeoutMs_;
+        std::atomic<worker_wait::STRATEGY> mWorkerWaitStrategy_;
+        std::atomic<int> mWorkerCpu_;
+        std::atomic<int> mWorkerPriority_;
+        WorkerParking mWorkerParking_;
+        OverflowStats mOverflowStats_;
+        /* Sources are set by any thread, conversions only run on the worker */
+        LogClock mLogClock_;
+        std::mutex mQueueConfigMutex_;
         std::thread mWorkerThread_;
         std::atomic<bool> mIsWorkerRunning_;
         std::mutex mOutputMutex_;
@@ -81,6 +137,13 @@ namespace equinox {
         std::unique_ptr<IConsoleLogsProducer> mConsoleLogsProducer_;
         std::shared_ptr<IFileLogsProducer> mFileLogsProducer_;
         logs_output::SINK mLogsOutputSink_;
+        DeferredMessageFormatter mDeferredMessageFormatter_;
+        std::string mRenderedMessage_;
+        /* Worker only: the sinks buffered lines since the queue was last drained */
+        bool mConsoleLinesPending_;
+        bool mFileLinesPending_;
+        /* Worker only: the file sink wrote lines still waiting for their periodic sync */
+        bool mFileSyncPending_;
     };
 }  // namespace equinox
 
@@ -0,0 +1,104 @@
+/*
+ * ByteRingLogQueue.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_BYTERINGLOGQUEUE_H_
+#define INCLUDE_BYTERINGLOGQUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "IAsyncLogQueue.h"
+
+namespace equinox {
+
+/*
+ * Multi-producer/single-consumer queue keeping the records in one preallocated byte ring.
+ * A producer reserves space for a length-prefixed record, copies the message in place and commits it;
+ * the worker reads the committed records as string views, so no message is allocated on either side.
+ * Written records can not be taken back by a producer, so when the ring is full drop_oldest behaves like drop_newest.
+ */
+class ByteRingLogQueue : public IAsyncLogQueue {
+ public:
+  ByteRingLogQueue(size_t capacity_bytes, bool use_huge_pages);
+  ~ByteRingLogQueue();
+  ByteRingLogQueue(const ByteRingLogQueue&) = delete;
+  ByteRingLogQueue& operator=(const ByteRingLogQueue&) = delete;
+
+  bool enqueue(const std::string& log_message) override;
+  bool tryEnqueue(const std::string& log_message) override;
+  bool dequeue(std::vector<std::string>& out, size_t max_batch_size, uint32_t timeout_ms) override;
+  bool consume(const LogRecordVisitor& visitor, size_t max_batch_size, uint32_t timeout_ms) override;
+  void stop() override;
+  void setOverflowPolicy(overflow::POLICY policy, uint32_t block_timeout_ms, const LogRecordVisitor& dropped_record_visitor) override;
+
+ protected:
+  size_t getCapacity() const;
+  bool isBackedByHugePages() const;
+  uint64_t getDroppedMessagesCount() const;
+
+ private:
+  bool push(const std::string& log_message, bool may_wait);
+  bool tryWriteRecord(const std::string& log_message, size_t record_size);
+  size_t consumeCommittedRecords(const LogRecordVisitor& visitor, size_t max_batch_size);
+  bool hasPendingWork() const;
+
+  size_t mCapacity_;
+  size_t mMappingSize_;
+  char* mBuffer_;
+  bool mBackedByHugePages_;
+
+  alignas(64) std::atomic<uint64_t> mWritePosition_;
+  alignas(64) std::atomic<uint64_t> mReadPosition_;
+
+  alignas(64) std::mutex mWorkerMutex_;
+  std::condition_variable mWorkerConditionVariable_;
+  std::atomic<bool> mWorkerWaiting_;
+  std::atomic<bool> mStopRequested_;
+  std::atomic<uint64_t> mDroppedMessagesCount_;
+  std::atomic<overflow::POLICY> mOverflowPolicy_;
+  std::atomic<uint32_t> mBlockTimeoutMs_;
+};
+}  // namespace equinox
+
+#endif /* INCLUDE_BYTERINGLOGQUEUE_H_ */
@@ -40,12 +40,15 @@
 #ifndef INCLUDE_CONSOLELOGSPRODUCER_H_
 #define INCLUDE_CONSOLELOGSPRODUCER_H_
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
 
 #include "ColorFormatter.h"
 #include "EquinoxLoggerCommon.h"
+#include "LogLineTemplates.h"
+#include "LogRecordHeader.h"
 #include "TimestampProducer.h"
 
 namespace equinox {
@@ -53,23 +56,49 @@ namespace equinox {
     class EQUINOX_API IConsoleLogsProducer {
        public:
         virtual ~IConsoleLogsProducer() = default;
-        virtual void logMessage(const std::string&) = 0;
+        virtual void setLogPrefix(const std::string& logPrefix) = 0;
+        virtual void setFlushIntervalMs(std::uint32_t flushIntervalMs) = 0;
+        virtual void logMessage(const std::string&, const LogRecordMetadata& metadata) = 0;
+        /* Writes the buffered lines, the worker calls it whenever it drained the queue */
         virtual void flush() = 0;
     };
 
+    /*
+     * Lines of one batch are collected in a buffer and written to stdout with a single write(2), bypassing
+     * iostreams. The buffer is written when the worker drains the queue, when it fills up, or when its oldest
+     * line waited for the flush interval while the queue stayed busy. Not thread-safe, the worker serializes calls.
+     */
     class EQUINOX_API ConsoleLogsProducer : public IConsoleLogsProducer {
        public:
         ConsoleLogsProducer(std::shared_ptr<ITimestampProducer> timestampProducer);
+        ~ConsoleLogsProducer();
 
-        void logMessage(const std::string& format) override;
+        ConsoleLogsProducer(const ConsoleLogsProducer&) = delete;
+        ConsoleLogsProducer& operator=(const ConsoleLogsProducer&) = delete;
+
+        /* Renders the colored line templates of every level, not safe against a concurrent logMessage() */
+        void setLogPrefix(const std::string& logPrefix) override;
+        /* 0 writes every line as soon as it is logged */
+        void setFlushIntervalMs(std::uint32_t flushIntervalMs) override;
+        void logMessage(const std::string& format, const LogRecordMetadata& metadata) override;
         void flush() override;
 
        protected:
-        ConsoleLogsProducer(std::shared_ptr<ITimestampProducer> timestampProducer, std::shared_ptr<IColorFormatter> colorFormatter);
+        ConsoleLogsProducer(std::shared_ptr<ITimestampProducer> timestampProducer, std::shared_ptr<IColorFormatter> colorFormatter, int outputFd);
+        /* Coarse monotonic time, replaced in tests */
+        virtual std::int64_t readMonotonicNs() const;
 
        private:
+        void writePendingLines();
+
         std::shared_ptr<ITimestampProducer> mTimestampProducer_;
         std::shared_ptr<IColorFormatter> mColorFormatter_;
+        LogLineTemplates mLogLineTemplates_;
+        int mOutputFd_;
+        std::int64_t mFlushIntervalNs_;
+        std::string mPendingLines_;
+        /* When the oldest buffered line was logged */
+        std::int64_t mPendingSinceNs_;
     };
 
 } /*namespace equinox*/
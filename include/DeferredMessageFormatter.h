@@ -0,0 +1,70 @@
+/*
+ * DeferredMessageFormatter.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_DEFERREDMESSAGEFORMATTER_H_
+#define INCLUDE_DEFERREDMESSAGEFORMATTER_H_
+
+#include <cstddef>
+
+#include <string>
+#include <string_view>
+
+#include "EquinoxLoggerCommon.h"
+#include "EquinoxLoggerDeferred.h"
+
+namespace equinox {
+
+    class DeferredMessageFormatter {
+       public:
+        /**
+         * Formats a message captured by deferred::encodeMessage() and appends the result to the output
+         *
+         * @param encodedMessage The encoded format string and arguments
+         * @param output The string the formatted message is appended to
+         * @return false if the encoded message is malformed
+         */
+        bool format(std::string_view encodedMessage, std::string& output);
+
+       private:
+        std::string mStringArgument_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_DEFERREDMESSAGEFORMATTER_H_ */
@@ -42,8 +42,10 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "AsyncLogQueue.h"
 #include "AsyncLogQueueEngine.h"
@@ -59,10 +61,13 @@ namespace equinox {
     class EQUINOX_API EquinoxLoggerEngineImpl : public IEquinoxLoggerEngineImpl {
        public:
         EquinoxLoggerEngineImpl();
-        void logMessage(level::LOG_LEVEL msgLevel, const std::string& formatedOutputMessage) override;
-        bool setup(level::LOG_LEVEL logLevel, const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink, const std::string& logFileName,
-                   std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) override;
-        void changeLevel(level::LOG_LEVEL logLevel) override;
+        bool logMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, std::string_view formatedOutputMessage, bool nonBlocking) override;
+        bool logDeferredMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, const std::string& encodedMessage, bool nonBlocking) override;
+        std::uint64_t getDroppedMessagesCount(level::LOG_LEVEL msgLevel) override;
+        FileWriteStats getFileWriteStats() override;
+        bool setup(const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink, const std::string& logFileName, std::size_t maxLogFileSizeBytes,
+                   std::size_t maxLogFiles) override;
+        bool setup(const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink, const LoggerOptions& options) override;
         bool changeLogsOutputSink(logs_output::SINK logsOutputSink) override;
         void flush() override;
 
@@ -70,14 +75,13 @@ namespace equinox {
         EquinoxLoggerEngineImpl(std::shared_ptr<ITimestampProducer> mTimestampProducer, std::shared_ptr<IFileLogsProducer> mFileLogsProducer,
                                 std::unique_ptr<IAsyncLogQueueEngine> mAsyncLogQueueEngine);
         const std::string& getLogPrefix() const;
-        level::LOG_LEVEL getLogLevel() const;
         const std::string& getLogFileName() const;
         std::size_t getMaxLogFileSizeBytes() const;
         std::size_t getMaxLogFiles() const;
 
        private:
+        /* Only read by setup(), the logging threads never touch the prefix */
         std::string mLogPrefix_;
-        level::LOG_LEVEL mLogLevel_;
         std::string mLogFileName_;
         std::size_t mMaxLogFileSizeBytes_;
         std::size_t mMaxLogFiles_;
@@ -0,0 +1,85 @@
+/*
+ * FdLogWriter.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+#ifndef INCLUDE_FDLOGWRITER_H_
+#define INCLUDE_FDLOGWRITER_H_
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <string>
+
+namespace equinox {
+
+    /*
+     * Log file written with plain write() calls on a descriptor opened with O_APPEND. The caller hands over a
+     * whole batch, it goes out in as few calls as the kernel allows. Failures are returned as errno values,
+     * nothing throws.
+     */
+    class FdLogWriter {
+       public:
+        FdLogWriter();
+        virtual ~FdLogWriter();
+
+        FdLogWriter(const FdLogWriter&) = delete;
+        FdLogWriter& operator=(const FdLogWriter&) = delete;
+
+        /* 0 or the errno of open(), the file open until now is closed only once the new one is open */
+        int open(const std::string& fileName, bool truncate);
+        bool isOpen() const;
+        /* Retries interrupted and short writes, 0 or the errno of the write() that failed */
+        int write(const char* data, std::size_t size);
+        /* 0 or the errno of fdatasync() */
+        int sync();
+        /* 0 or the errno of close(), the descriptor is released either way */
+        int close();
+        int getFd() const;
+        /* Size of the file when it was opened plus every byte written since */
+        std::size_t getSize() const;
+
+       protected:
+        virtual ssize_t writeOnce(const char* data, std::size_t size);
+
+       private:
+        int mFd_;
+        std::size_t mSize_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_FDLOGWRITER_H_ */
@@ -41,73 +41,181 @@
 #define INCLUDE_FILELOGSPRODUCER_H_
 
 #include <cstddef>
+#include <cstdint>
 
-#include <fstream>
-#include <iostream>
+#include <deque>
 #include <memory>
 #include <mutex>
-#include <sstream>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "EquinoxLoggerCommon.h"
+#include "FdLogWriter.h"
+#include "FileWriteLatency.h"
 #include "IFileLogsProducer.h"
+#include "LogLineTemplates.h"
+#include "LogSegmentArchiver.h"
+#include "MappedLogSegment.h"
+#include "PageCacheDropBehind.h"
 #include "TimestampProducer.h"
+#include "UringLogWriter.h"
 
 namespace equinox {
 
+    /*
+     * Lines are collected in a buffer and written to the file together when the worker drained the queue or the
+     * buffer filled up, then synced according to the durability mode.
+     */
     class EQUINOX_API FileLogsProducer : public IFileLogsProducer {
        public:
         FileLogsProducer(std::shared_ptr<ITimestampProducer> timestampProducer)
             : mMessageBufferAccessLock_{},
               mTimestampProducer{timestampProducer},
-              mFdLogFile_{},
+              mFdLogWriter_{},
               mLogFileName_{},
               mMaxLogFileSizeBytes_{0U},
               mMaxLogFiles_{0U},
-              mNextRotationIndex_{1U} {}
+              mSegmentSequence_{1U},
+              mRotatedSegments_{},
+              mRotationPeriod_{LoggerOptions{}.fileRotationPeriod},
+              mRotationZone_{LoggerOptions{}.timestampZone},
+              mSegmentPeriod_{},
+              mNextRotationBoundaryNs_{INT64_MAX},
+              mLogFileSizeBytes_{0U},
+              mLogLineTemplates_{},
+              mPendingLines_{},
+              mDurabilityMode_{LoggerOptions{}.fileDurability},
+              mSyncIntervalNs_{0},
+              mSyncBytes_{LoggerOptions{}.fileSyncBytes},
+              mUnsyncedBytes_{0U},
+              mLastSyncNs_{0},
+              mFileWriteLatency_{},
+              mIoBackend_{LoggerOptions{}.fileIoBackend},
+              mMappedLogSegment_{},
+              mUringLogWriter_{mFileWriteLatency_},
+              mPageCacheMode_{LoggerOptions{}.filePageCache},
+              mPageCacheDropBehind_{},
+              mLogSegmentArchiver_{} {
+            setDurability(mDurabilityMode_, LoggerOptions{}.fileSyncIntervalMs, mSyncBytes_);
+        }
 
         ~FileLogsProducer() noexcept {
-            if (mFdLogFile_.is_open()) {
-                // LCOV_EXCL_START
-                try {
-                    mFdLogFile_.close();
-                } catch (std::ofstream::failure& ex) {
-                    std::cerr << "[EquinoxLogger] Warning: Failed to close log file in destructor: " << ex.what() << std::endl;
-                }
-                // LCOV_EXCL_STOP
+            writePendingLines();
+            if (mDurabilityMode_ != file_durability::MODE::os_buffered) {
+                syncLogFile(true);
             }
+            closeLogFile();
         }
 
         FileLogsProducer(const FileLogsProducer&) = delete;
         FileLogsProducer(const FileLogsProducer&&) = delete;
         FileLogsProducer& operator=(FileLogsProducer&) = delete;
 
-        void setupFile(const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) override;
-        void logMessage(const std::string& messageToLog) override;
+        int setupFile(const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) override;
+        void setLogPrefix(const std::string& logPrefix) override;
+        void setDurability(file_durability::MODE durabilityMode, std::uint32_t syncIntervalMs, std::size_t syncBytes) override;
+        void setIoBackend(file_io::BACKEND ioBackend) override;
+        void setPageCacheMode(file_page_cache::MODE pageCacheMode) override;
+        void setCompression(file_compression::MODE compressionMode) override;
+        void setRotationPeriod(file_rotation::PERIOD rotationPeriod, timestamp_format::ZONE rotationZone) override;
+        void logMessage(const std::string& messageToLog, const LogRecordMetadata& metadata) override;
         void flush() override;
+        std::optional<std::uint32_t> getSyncDelayMs() const override;
+        FileWriteStats getWriteStats() const override;
 
     protected:
-        void openLogFileAppend();
-        void openLogFileTruncate();
+        int openLogFileAppend();
+        int openLogFileTruncate();
+        int openLogFile(bool truncate);
+        int openFdLogWriter(bool truncate);
+        /* The write backend opens it before the full segment is closed, the others close that one first */
+        int openNextSegment();
+        int openMappedLogSegment(bool truncate);
+        int openUringLogWriter(bool truncate);
+        void closeLogFile();
+        bool isLogFileOpen() const;
+        /* The descriptor of the backend that has one, -1 otherwise */
+        int getLogFileFd() const;
         void rotateIfNeeded();
-        std::string buildRotatedFileName(std::size_t index) const;
+        /* Called by the first line at or past the boundary, the lines before it stay in the segment of their period */
+        void rotateAtBoundary(std::int64_t timestampNs);
+        void rotateSegment(const std::string& nextSegmentPeriod);
+        /* The only calendar math of the period rotation: the label of the period holding the timestamp, and the
+         * start of the next one returned */
+        std::int64_t computeSegmentPeriod(std::int64_t timestampNs, std::string& segmentPeriod) const;
+        /* The period the file is set up in, the lines carry their own timestamps */
+        virtual std::int64_t getWallClockNs() const;
+        /* A full segment rotates after the write unless the caller rotates it into the next period itself */
+        void writePendingLines(bool rotateWhenFull = true);
+        /* io_uring queues the sync unless waitForSync, the other backends always wait for it */
+        void syncLogFile(bool waitForSync = false);
+        bool isSyncDue() const;
+        std::string buildSegmentFileName(std::size_t sequence, const std::string& segmentPeriod) const;
+        /* The segment written now when rotating, the configured file otherwise */
+        std::string getSegmentFileName() const;
+        /* Finds the segments left by earlier runs, the newest one is continued unless it was archived */
+        void recoverSegments();
+        /* Renames a regular file at the configured name, left by rename-based rotation, into the next sequence */
+        void migrateLogFile(std::vector<std::pair<std::size_t, std::string>>& segments);
+        /* Hands the oldest rotated segments beyond the max log files to the archiver for removal */
+        void retireOldSegments();
+        /* Points a symbolic link at the configured file name to the segment written now */
+        void linkLogFileToSegment();
         bool isRotationEnabled() const;
         // for testing purposes only
-        std::ofstream& GetLogFileStream();
+        FdLogWriter& GetFdLogWriter();
         std::string& GetLogFileName();
         std::size_t& GetMaxLogFileSizeBytes();
         std::size_t& GetMaxLogFiles();
-        std::size_t& GetNextRotationIndex();
+        std::size_t& GetSegmentSequence();
+        std::deque<std::string>& GetRotatedSegments();
+        std::string& GetSegmentPeriod();
+        std::int64_t& GetNextRotationBoundaryNs();
+        std::size_t& GetLogFileSizeBytes();
+        MappedLogSegment& GetMappedLogSegment();
+        UringLogWriter& GetUringLogWriter();
+        file_io::BACKEND& GetIoBackend();
+        LogSegmentArchiver& GetLogSegmentArchiver();
 
 
     private:
-        std::mutex mMessageBufferAccessLock_;
+        mutable std::mutex mMessageBufferAccessLock_;
         std::shared_ptr<ITimestampProducer> mTimestampProducer;
-        std::ofstream mFdLogFile_;
+        FdLogWriter mFdLogWriter_;
         std::string mLogFileName_;
         std::size_t mMaxLogFileSizeBytes_;
         std::size_t mMaxLogFiles_;
-        std::size_t mNextRotationIndex_;
+        /* Segments are name_<sequence>.ext, or name_<period>_<sequence>.ext with a rotation period, never renamed,
+         * and the sequence only grows */
+        std::size_t mSegmentSequence_;
+        /* File names of the rotated segments on the disk, oldest first */
+        std::deque<std::string> mRotatedSegments_;
+        file_rotation::PERIOD mRotationPeriod_;
+        timestamp_format::ZONE mRotationZone_;
+        /* Label of the period written now, empty without a rotation period */
+        std::string mSegmentPeriod_;
+        /* Computed when the period starts, a line only compares its timestamp with it */
+        std::int64_t mNextRotationBoundaryNs_;
+        /* Seeded from the file when it is opened and advanced by every write, rotation never stats the file */
+        std::size_t mLogFileSizeBytes_;
+        /* Rendered without colors, files never get ANSI codes */
+        LogLineTemplates mLogLineTemplates_;
+        std::string mPendingLines_;
+        file_durability::MODE mDurabilityMode_;
+        std::int64_t mSyncIntervalNs_;
+        std::size_t mSyncBytes_;
+        std::size_t mUnsyncedBytes_;
+        std::int64_t mLastSyncNs_;
+        FileWriteLatency mFileWriteLatency_;
+        /* Takes effect when the file is opened next */
+        file_io::BACKEND mIoBackend_;
+        MappedLogSegment mMappedLogSegment_;
+        UringLogWriter mUringLogWriter_;
+        file_page_cache::MODE mPageCacheMode_;
+        PageCacheDropBehind mPageCacheDropBehind_;
+        LogSegmentArchiver mLogSegmentArchiver_;
     };
 } /*namespace equinox*/
 
@@ -33,15 +33,41 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "EquinoxLoggerCommon.h"
+
 namespace equinox {
+/* Receives one queued log record, the view is valid only during the call */
+using LogRecordVisitor = std::function<void(std::string_view)>;
+
 class IAsyncLogQueue {
  public:
   virtual ~IAsyncLogQueue() = default;
-  virtual void enqueue(const std::string& log_message) = 0;
+  /* Applies the overflow policy when the queue is full, returns false if the message was dropped */
+  virtual bool enqueue(const std::string& log_message) = 0;
+  /* Same as enqueue() but never waits, the block policy drops the message instead */
+  virtual bool tryEnqueue(const std::string& log_message) = 0;
+  /* The visitor receives every record removed by the drop_oldest policy */
+  virtual void setOverflowPolicy(overflow::POLICY policy, uint32_t block_timeout_ms, const LogRecordVisitor& dropped_record_visitor) = 0;
   virtual bool dequeue(std::vector<std::string>& out, size_t max_batch_size, uint32_t timeout_ms) = 0;
   virtual void stop() = 0;
+
+  /* Passes up to max_batch_size records to the visitor, queues storing records in place override it to avoid the copies */
+  virtual bool consume(const LogRecordVisitor& visitor, size_t max_batch_size, uint32_t timeout_ms) {
+    thread_local std::vector<std::string> batch;
+    batch.clear();
+    if (!dequeue(batch, max_batch_size, timeout_ms)) {
+      return false;
+    }
+
+    for (const auto& log_message : batch) {
+      visitor(log_message);
+    }
+    return true;
+  }
 };
 }  // namespace equinox
\ No newline at end of file
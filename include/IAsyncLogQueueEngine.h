@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "EquinoxLoggerCommon.h"
 
@@ -8,10 +10,16 @@ namespace equinox {
     class IAsyncLogQueueEngine {
        public:
         virtual ~IAsyncLogQueueEngine() = default;
-        virtual void processLogMessage(const std::string& messageToProcess) = 0;
+        /* Return false if the message was dropped by the overflow policy, nonBlocking never waits for space in the queue */
+        virtual bool processLogMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, std::string_view messageToProcess, bool nonBlocking) = 0;
+        virtual bool processDeferredLogMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, const std::string& encodedMessage, bool nonBlocking) = 0;
+        virtual std::uint64_t getDroppedMessagesCount(level::LOG_LEVEL msgLevel) = 0;
         virtual void stopWorker() = 0;
         virtual void startWorkerIfNeeded() = 0;
         virtual void setLogsOutputSink(logs_output::SINK logsOutputSink) = 0;
+        /* The sinks render the prefix into their line templates, messages still in the queue are written with the new one */
+        virtual void setLogPrefix(const std::string& logPrefix) = 0;
+        virtual void configureQueue(const LoggerOptions& options) = 0;
         virtual void flush() = 0;
     };
 }  // namespace equinox
\ No newline at end of file
@@ -39,14 +39,15 @@
 
 #pragma once
 
+#include <string_view>
+
 #include "EquinoxLoggerCommon.h"
 
 namespace equinox {
     class IColorFormatter {
        public:
         virtual ~IColorFormatter() = default;
-        virtual level::LOG_LEVEL extractLevelFromMessage(const std::string& message) = 0;
-        virtual std::string applyConsoleColors(const std::string& message, std::string_view color) = 0;
         virtual std::string_view getColorForLevel(level::LOG_LEVEL logLevel) = 0;
+        virtual std::string_view getColorReset() = 0;
     };
 }  // namespace equinox
\ No newline at end of file
@@ -39,7 +39,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "EquinoxLoggerCommon.h"
 
@@ -48,10 +50,15 @@ namespace equinox {
        public:
         virtual ~IEquinoxLoggerEngineImpl() = default;
 
-        virtual void logMessage(level::LOG_LEVEL msgLevel, const std::string& formatedOutputMessage) = 0;
-        virtual bool setup(level::LOG_LEVEL logLevel, const std::string& logPrefix, logs_output::SINK logsOutputSink, const std::string& logFileName,
-                           std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) = 0;
-        virtual void changeLevel(level::LOG_LEVEL logLevel) = 0;
+        /* Called concurrently by the logging threads, no engine lock is held; return false if the message was dropped.
+         * The engine owns the log level and only passes on the messages that are enabled. */
+        virtual bool logMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, std::string_view formatedOutputMessage, bool nonBlocking) = 0;
+        virtual bool logDeferredMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, const std::string& encodedMessage, bool nonBlocking) = 0;
+        virtual std::uint64_t getDroppedMessagesCount(level::LOG_LEVEL msgLevel) = 0;
+        virtual FileWriteStats getFileWriteStats() = 0;
+        virtual bool setup(const std::string& logPrefix, logs_output::SINK logsOutputSink, const std::string& logFileName, std::size_t maxLogFileSizeBytes,
+                           std::size_t maxLogFiles) = 0;
+        virtual bool setup(const std::string& logPrefix, logs_output::SINK logsOutputSink, const LoggerOptions& options) = 0;
         virtual bool changeLogsOutputSink(logs_output::SINK logsOutputSink) = 0;
         virtual void flush() = 0;
     };
@@ -1,16 +1,31 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <string>
 
 #include "EquinoxLoggerCommon.h"
+#include "LogRecordHeader.h"
 
 namespace equinox {
 
     class EQUINOX_API IFileLogsProducer {
        public:
         virtual ~IFileLogsProducer() = default;
-        virtual void setupFile(const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) = 0;
-        virtual void logMessage(const std::string& messageToLog) = 0;
+        /* 0 or the errno that kept the log file from opening */
+        virtual int setupFile(const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) = 0;
+        virtual void setLogPrefix(const std::string& logPrefix) = 0;
+        virtual void setDurability(file_durability::MODE durabilityMode, std::uint32_t syncIntervalMs, std::size_t syncBytes) = 0;
+        virtual void setIoBackend(file_io::BACKEND ioBackend) = 0;
+        virtual void setPageCacheMode(file_page_cache::MODE pageCacheMode) = 0;
+        virtual void setCompression(file_compression::MODE compressionMode) = 0;
+        /* Takes effect when the file is set up next, boundaries follow the zone of the timestamps */
+        virtual void setRotationPeriod(file_rotation::PERIOD rotationPeriod, timestamp_format::ZONE rotationZone) = 0;
+        virtual void logMessage(const std::string& messageToLog, const LogRecordMetadata& metadata) = 0;
+        /* Writes the buffered lines, the worker calls it whenever it drained the queue */
         virtual void flush() = 0;
+        /* Time left until the written lines are due for their periodic sync, none while no such sync is outstanding */
+        virtual std::optional<std::uint32_t> getSyncDelayMs() const = 0;
+        virtual FileWriteStats getWriteStats() const = 0;
     };
 }  // namespace equinox
\ No newline at end of file
@@ -38,16 +38,21 @@
 
 #pragma once
 
-#include <string>
+#include <cstddef>
+#include <cstdint>
 
 #include "EquinoxLoggerCommon.h"
 
 namespace equinox {
 
+    /* Longest timestamp formatTimestamp() writes: [YYYY-MM-DDTHH:MM:SS.nnnnnnnnn+HH:MM] */
+    constexpr std::size_t kMaxTimestampLength = 37U;
+
     class EQUINOX_API ITimestampProducer {
        public:
         virtual ~ITimestampProducer() = default;
-        virtual std::string getTimestamp() const = 0;
-        virtual std::string getTimestampInUs() = 0;
+        /* Writes a time given in nanoseconds since the epoch to a buffer of at least kMaxTimestampLength bytes, returns the length */
+        virtual std::size_t formatTimestamp(std::int64_t timestampNs, char* buffer) = 0;
+        virtual void setFormat(timestamp_format::ZONE zone, timestamp_format::PRECISION precision) = 0;
     };
 }  // namespace equinox
\ No newline at end of file
@@ -0,0 +1,83 @@
+/*
+ * InFlightProducers.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_INFLIGHTPRODUCERS_H_
+#define INCLUDE_INFLIGHTPRODUCERS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace equinox {
+
+    /*
+     * Tells when no producer can still be enqueuing to a replaced queue. Producers count themselves in a stripe of
+     * their own under the current epoch, waitForProducers() starts a new epoch and waits for the previous one to
+     * empty, so producers arriving meanwhile never keep it waiting.
+     */
+    class InFlightProducers {
+       public:
+        InFlightProducers();
+
+        /* Producers: returns the token to pass to leave(), anything loaded after it is seen by waitForProducers() */
+        std::uint32_t enter();
+        void leave(std::uint32_t token);
+
+        /* Returns once every producer that entered before the call left, one caller at a time */
+        void waitForProducers();
+
+       protected:
+        std::uint32_t getProducersCount() const;
+
+       private:
+        static constexpr std::size_t kStripesCount = 64U;
+
+        struct alignas(64) Stripe {
+            /* One counter per epoch parity */
+            std::atomic<std::uint32_t> producers[2];
+        };
+
+        alignas(64) std::atomic<std::uint32_t> mEpoch_;
+        std::array<Stripe, kStripesCount> mStripes_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_INFLIGHTPRODUCERS_H_ */
@@ -0,0 +1,98 @@
+/*
+ * LogClock.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_LOGCLOCK_H_
+#define INCLUDE_LOGCLOCK_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "EquinoxLoggerCommon.h"
+
+namespace equinox {
+
+    /*
+     * Logging threads stamp every record with a raw reading of the configured clock, the worker converts it to
+     * nanoseconds since the epoch. The conversion is calibrated against CLOCK_REALTIME on the worker only, at most
+     * once per calibration interval, so a logging thread never pays more than the clock read.
+     */
+    class LogClock {
+       public:
+        LogClock();
+        virtual ~LogClock() = default;
+
+        /* Any thread: tsc falls back to monotonic when the CPU has no invariant TSC */
+        void setSource(timestamp_clock::SOURCE source);
+        timestamp_clock::SOURCE getSource() const;
+
+        /* Any thread: the raw reading stored in the record */
+        static std::uint64_t readTicks(timestamp_clock::SOURCE source);
+        static bool isInvariantTscAvailable();
+
+        /* Worker only: converts a reading taken with the given source */
+        std::int64_t toNanosecondsSinceEpoch(timestamp_clock::SOURCE source, std::uint64_t ticks);
+
+       protected:
+        /* Clocks sampled by the calibration, replaced in tests */
+        virtual std::uint64_t readTsc() const;
+        virtual std::int64_t readMonotonicNs() const;
+        virtual std::int64_t readRealtimeNs() const;
+
+       private:
+        void calibrateMonotonic();
+        void calibrateTsc();
+
+        std::atomic<timestamp_clock::SOURCE> mSource_;
+
+        bool mMonotonicCalibrated_;
+        std::int64_t mMonotonicCalibrationNs_;
+        std::int64_t mMonotonicToRealtimeOffsetNs_;
+
+        /* Last calibration point: the TSC reading and the same moment on both clocks */
+        bool mTscCalibrated_;
+        std::uint64_t mTscAnchorTicks_;
+        std::int64_t mTscAnchorMonotonicNs_;
+        std::int64_t mTscAnchorRealtimeNs_;
+        double mNsPerTscTick_;
+        std::uint64_t mTscCalibrationIntervalTicks_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_LOGCLOCK_H_ */
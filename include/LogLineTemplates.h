@@ -0,0 +1,86 @@
+/*
+ * LogLineTemplates.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_LOGLINETEMPLATES_H_
+#define INCLUDE_LOGLINETEMPLATES_H_
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "EquinoxLoggerCommon.h"
+#include "IColorFormatter.h"
+
+namespace equinox {
+
+    /*
+     * Bytes written around every message of a level: the header "[color][prefix][LEVEL] " in front of it and the
+     * color reset after it. They are rendered once per level when the prefix is set, so a sink only copies them.
+     */
+    class LogLineTemplates {
+       public:
+        /* Longer prefixes are cut to keep the templates in fixed buffers */
+        static constexpr std::size_t kMaxLogPrefixLength = 128U;
+
+        LogLineTemplates();
+
+        /* Without a color formatter the templates carry no color codes */
+        void render(std::string_view logPrefix, IColorFormatter* colorFormatter);
+
+        std::string_view getHeader(level::LOG_LEVEL logLevel) const;
+        std::string_view getTrailer(level::LOG_LEVEL logLevel) const;
+
+       private:
+        static constexpr std::size_t kMaxColorLength = 16U;
+        static constexpr std::size_t kMaxLevelTagLength = 16U;
+        static constexpr std::size_t kLevelsCount = static_cast<std::size_t>(level::LOG_LEVEL::off) + 1U;
+
+        struct LevelTemplate {
+            std::array<char, kMaxColorLength + kMaxLogPrefixLength + kMaxLevelTagLength> header;
+            std::size_t headerLength;
+            std::array<char, kMaxColorLength> trailer;
+            std::size_t trailerLength;
+        };
+
+        std::array<LevelTemplate, kLevelsCount> mLevelTemplates_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_LOGLINETEMPLATES_H_ */
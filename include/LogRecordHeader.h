@@ -0,0 +1,72 @@
+/*
+ * LogRecordHeader.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_LOGRECORDHEADER_H_
+#define INCLUDE_LOGRECORDHEADER_H_
+
+#include <cstdint>
+
+#include "EquinoxLoggerCommon.h"
+
+namespace equinox {
+
+    /* Written by the logging thread in front of every queued record, copied in and out with memcpy */
+    struct LogRecordHeader {
+        level::LOG_LEVEL level;
+        timestamp_clock::SOURCE clockSource;
+        std::uint32_t threadId;
+        std::uint32_t callSiteId;
+        /* Raw reading of clockSource, converted by the worker */
+        std::uint64_t timestampTicks;
+    };
+
+    /* What the sinks get with every message, read from the record header instead of the message text */
+    struct LogRecordMetadata {
+        level::LOG_LEVEL level;
+        /* When the message was logged, in nanoseconds since the epoch */
+        std::int64_t timestampNs;
+        /* Kernel id of the logging thread */
+        std::uint32_t threadId;
+        /* Same for every message logged with the same format string */
+        std::uint32_t callSiteId;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_LOGRECORDHEADER_H_ */
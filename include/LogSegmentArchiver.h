@@ -0,0 +1,105 @@
+/*
+ * LogSegmentArchiver.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_LOGSEGMENTARCHIVER_H_
+#define INCLUDE_LOGSEGMENTARCHIVER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "EquinoxLoggerCommon.h"
+
+namespace equinox {
+
+    /*
+     * Low-priority thread the file sink hands rotated segments to. The worker only opens the next segment,
+     * compression of the full one and removal of the segments past the retention limit happen here, in the
+     * order they were handed over.
+     */
+    class LogSegmentArchiver {
+       public:
+        LogSegmentArchiver();
+        /* Archives the files handed over so far before it returns */
+        virtual ~LogSegmentArchiver();
+
+        LogSegmentArchiver(const LogSegmentArchiver&) = delete;
+        LogSegmentArchiver& operator=(const LogSegmentArchiver&) = delete;
+
+        void setCompression(file_compression::MODE compressionMode);
+        /* Drops the archived file from the page cache once it is on the disk */
+        void setDropPageCache(bool dropPageCache);
+        /* Worker: queues a closed rotated file and returns at once, the thread is started on first use */
+        void archive(const std::string& segmentFileName);
+        /* Worker: queues the removal of a rotated file and of its compressed copy */
+        void retire(const std::string& segmentFileName);
+        /* Blocks until every file handed over was archived */
+        void waitIdle();
+
+       protected:
+        /* Archiver thread: writes segmentFileName + ".gz" and removes segmentFileName, false leaves it uncompressed */
+        virtual bool compressSegment(const std::string& segmentFileName);
+
+       private:
+        struct SegmentTask {
+            std::string segmentFileName;
+            bool retire;
+        };
+
+        void queueTask(SegmentTask task);
+        void run();
+        void archiveSegment(const std::string& segmentFileName, file_compression::MODE compressionMode);
+        static void retireSegment(const std::string& segmentFileName);
+        static void dropFromPageCache(const std::string& fileName);
+
+        std::mutex mSegmentsLock_;
+        std::condition_variable mSegmentsChanged_;
+        std::deque<SegmentTask> mSegments_;
+        file_compression::MODE mCompressionMode_;
+        bool mDropPageCache_;
+        bool mArchiving_;
+        bool mStopping_;
+        std::thread mArchiverThread_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_LOGSEGMENTARCHIVER_H_ */
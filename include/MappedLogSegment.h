@@ -0,0 +1,87 @@
+/*
+ * MappedLogSegment.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_MAPPEDLOGSEGMENT_H_
+#define INCLUDE_MAPPEDLOGSEGMENT_H_
+
+#include <cstddef>
+#include <string>
+
+namespace equinox {
+
+    /*
+     * Log file preallocated with fallocate() and mapped into memory, lines are copied into the mapping and the
+     * kernel writes the pages back. The file keeps its preallocated size while it is open, close() cuts it to the
+     * bytes written.
+     */
+    class MappedLogSegment {
+       public:
+        MappedLogSegment();
+        ~MappedLogSegment();
+
+        MappedLogSegment(const MappedLogSegment&) = delete;
+        MappedLogSegment& operator=(const MappedLogSegment&) = delete;
+
+        /* Preallocates at least reserveBytes, appends after the lines already in the file unless truncate is set.
+         * An open segment is closed only once the new one is mapped. */
+        bool open(const std::string& fileName, std::size_t reserveBytes, bool truncate);
+        bool isOpen() const;
+        /* Grows the segment when the data does not fit */
+        bool append(const char* data, std::size_t size);
+        /* msync() of the pages written since the last sync */
+        bool sync();
+        void close();
+        std::size_t getSize() const;
+
+       protected:
+        std::size_t getCapacity() const;
+
+       private:
+        bool reserve(std::size_t capacityBytes);
+
+        int mFd_;
+        char* mMapping_;
+        std::size_t mCapacity_;
+        std::size_t mSize_;
+        std::size_t mSyncedSize_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_MAPPEDLOGSEGMENT_H_ */
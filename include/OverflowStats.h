@@ -0,0 +1,70 @@
+/*
+ * OverflowStats.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_OVERFLOWSTATS_H_
+#define INCLUDE_OVERFLOWSTATS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "EquinoxLoggerCommon.h"
+
+namespace equinox {
+
+    /* Counts messages lost to a full queue, per level and since the last gap marker written by the worker */
+    class OverflowStats {
+       public:
+        OverflowStats();
+        void recordDroppedMessage(level::LOG_LEVEL msgLevel);
+        std::uint64_t getDroppedMessagesCount(level::LOG_LEVEL msgLevel) const;
+        std::uint64_t getDroppedMessagesCount() const;
+        /* Returns the number of messages dropped since the previous call */
+        std::uint64_t takeDroppedMessagesSinceLastMarker();
+
+       private:
+        static constexpr std::size_t kLevelsCount = static_cast<std::size_t>(level::LOG_LEVEL::off);
+
+        std::array<std::atomic<std::uint64_t>, kLevelsCount> mDroppedMessagesPerLevel_;
+        std::atomic<std::uint64_t> mDroppedMessagesSinceLastMarker_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_OVERFLOWSTATS_H_ */
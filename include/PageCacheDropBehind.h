@@ -0,0 +1,79 @@
+/*
+ * PageCacheDropBehind.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_PAGECACHEDROPBEHIND_H_
+#define INCLUDE_PAGECACHEDROPBEHIND_H_
+
+#include <cstddef>
+
+namespace equinox {
+
+    /*
+     * Keeps a log file that only grows from filling the page cache: once a window of written bytes is full its
+     * writeback is started, and the window before it, written back by then, is dropped from the cache.
+     */
+    class PageCacheDropBehind {
+       public:
+        static constexpr std::size_t kDefaultWindowBytes = 4U * 1024U * 1024U;
+
+        explicit PageCacheDropBehind(std::size_t windowBytes = kDefaultWindowBytes);
+        virtual ~PageCacheDropBehind() = default;
+
+        /* A file was opened, its first fileSizeBytes are not tracked */
+        void reset(std::size_t fileSizeBytes);
+        /* The file now ends at fileSizeBytes */
+        void written(int fd, std::size_t fileSizeBytes);
+
+       protected:
+        /* Does not wait for the disk */
+        virtual void startWriteback(int fd, std::size_t offset, std::size_t length);
+        /* Waits until the range is on the disk, then drops it, dirty pages cannot be dropped */
+        virtual void dropWindow(int fd, std::size_t offset, std::size_t length);
+
+       private:
+        std::size_t mWindowBytes_;
+        /* Start of the window not handed to writeback yet */
+        std::size_t mWindowStart_;
+        /* Everything before it is dropped */
+        std::size_t mDroppedUntil_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_PAGECACHEDROPBEHIND_H_ */
@@ -0,0 +1,102 @@
+/*
+ * PerCpuLogQueue.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_PERCPULOGQUEUE_H_
+#define INCLUDE_PERCPULOGQUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "IAsyncLogQueue.h"
+
+namespace equinox {
+
+/*
+ * Queue with one byte ring per CPU, memory grows with the number of cores instead of the number of threads.
+ * A producer appends to the ring of the CPU it runs on under that ring's spinlock, which is only contended
+ * when a thread is preempted or migrated in the middle of an append. A single worker drains all rings.
+ * Messages are ordered per CPU only. Appended records can not be taken back, so when a ring is full
+ * drop_oldest behaves like drop_newest.
+ */
+class PerCpuLogQueue : public IAsyncLogQueue {
+ public:
+  PerCpuLogQueue(size_t cpu_ring_capacity_bytes, size_t cpu_count);
+  ~PerCpuLogQueue();
+  bool enqueue(const std::string& log_message) override;
+  bool tryEnqueue(const std::string& log_message) override;
+  bool dequeue(std::vector<std::string>& out, size_t max_batch_size, uint32_t timeout_ms) override;
+  bool consume(const LogRecordVisitor& visitor, size_t max_batch_size, uint32_t timeout_ms) override;
+  void stop() override;
+  void setOverflowPolicy(overflow::POLICY policy, uint32_t block_timeout_ms, const LogRecordVisitor& dropped_record_visitor) override;
+
+  class CpuRing;
+
+ protected:
+  size_t getCpuRingsCount() const;
+  size_t getCpuRingCapacity() const;
+  uint64_t getDroppedMessagesCount() const;
+  /* Ring used by the calling thread */
+  virtual size_t getCurrentCpu() const;
+
+ private:
+  bool push(const std::string& log_message, bool may_wait);
+  bool appendToCurrentCpuRing(const std::string& log_message);
+  size_t consumeCpuRings(const LogRecordVisitor& visitor, size_t max_batch_size);
+  bool hasPendingWork() const;
+
+  std::vector<std::unique_ptr<CpuRing>> mCpuRings_;
+  size_t mNextCpuRing_;
+
+  std::mutex mWorkerMutex_;
+  std::condition_variable mWorkerConditionVariable_;
+  std::atomic<bool> mWorkerWaiting_;
+  std::atomic<bool> mStopRequested_;
+  std::atomic<uint64_t> mDroppedMessagesCount_;
+  std::atomic<overflow::POLICY> mOverflowPolicy_;
+  std::atomic<uint32_t> mBlockTimeoutMs_;
+};
+}  // namespace equinox
+
+#endif /* INCLUDE_PERCPULOGQUEUE_H_ */
@@ -0,0 +1,106 @@
+/*
+ * PerThreadLogQueue.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_PERTHREADLOGQUEUE_H_
+#define INCLUDE_PERTHREADLOGQUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "IAsyncLogQueue.h"
+
+namespace equinox {
+
+/*
+ * Queue with one single-producer/single-consumer ring per logging thread.
+ * A thread registers its ring on the first enqueue and never locks afterwards; a single worker drains all rings
+ * and reclaims the ring of an exited thread once it is empty. Messages are ordered per thread only.
+ * A producer can not remove messages from its ring, so drop_oldest behaves like drop_newest.
+ */
+class PerThreadLogQueue : public IAsyncLogQueue {
+ public:
+  explicit PerThreadLogQueue(size_t ring_capacity);
+  ~PerThreadLogQueue();
+  bool enqueue(const std::string& log_message) override;
+  bool tryEnqueue(const std::string& log_message) override;
+  bool dequeue(std::vector<std::string>& out, size_t max_batch_size, uint32_t timeout_ms) override;
+  void stop() override;
+  void setOverflowPolicy(overflow::POLICY policy, uint32_t block_timeout_ms, const LogRecordVisitor& dropped_record_visitor) override;
+
+  class Ring;
+
+ protected:
+  size_t getRingsCount();
+  uint64_t getDroppedMessagesCount() const;
+
+ private:
+  bool push(const std::string& log_message, bool may_wait);
+  Ring& getThreadRing();
+  void collectRegisteredRings();
+  size_t drainRings(std::vector<std::string>& out, size_t max_batch_size);
+  bool hasPendingWork();
+
+  const uint64_t mQueueId_;
+  const size_t mRingCapacity_;
+
+  /* Rings registered by producers, moved to mRings_ by the worker */
+  std::vector<std::shared_ptr<Ring>> mRegisteredRings_;
+  std::atomic<bool> mRingsRegistered_;
+
+  /* Owned by the worker */
+  std::vector<std::shared_ptr<Ring>> mRings_;
+  size_t mNextRingIndex_;
+
+  std::mutex mWorkerMutex_;
+  std::condition_variable mWorkerConditionVariable_;
+  std::atomic<bool> mWorkerWaiting_;
+  std::atomic<bool> mStopRequested_;
+  std::atomic<uint64_t> mDroppedMessagesCount_;
+  std::atomic<overflow::POLICY> mOverflowPolicy_;
+  std::atomic<uint32_t> mBlockTimeoutMs_;
+};
+}  // namespace equinox
+
+#endif /* INCLUDE_PERTHREADLOGQUEUE_H_ */
@@ -40,7 +40,10 @@
 #ifndef INCLUDE_TIMESTAMPPRODUCER_H_
 #define INCLUDE_TIMESTAMPPRODUCER_H_
 
-#include <string>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
 
 #include "EquinoxLoggerCommon.h"
 #include "ITimestampProducer.h"
@@ -49,13 +52,36 @@ namespace equinox {
 
     class EQUINOX_API TimestampProducer : public ITimestampProducer {
        public:
-        TimestampProducer() : mTimestamp_{} {}
+        TimestampProducer();
+        virtual ~TimestampProducer() = default;
 
-        std::string getTimestamp() const override;
-        std::string getTimestampInUs() override;
+        /* Worker only: the date and time are formatted once per second, every line only adds its sub-second digits */
+        std::size_t formatTimestamp(std::int64_t timestampNs, char* buffer) override;
+        /* Any thread */
+        void setFormat(timestamp_format::ZONE zone, timestamp_format::PRECISION precision) override;
+
+       protected:
+        /* Offset of the local time zone from UTC at the given time, in seconds */
+        virtual long getLocalUtcOffsetSeconds(std::time_t seconds) const;
 
        private:
-        std::string mTimestamp_;
+        static constexpr std::size_t kCachedPrefixLength = 21U;
+        static constexpr std::size_t kMaxCachedSuffixLength = 7U;
+
+        void updateCachedSecond(std::int64_t seconds, timestamp_format::ZONE zone);
+
+        std::atomic<timestamp_format::ZONE> mZone_;
+        std::atomic<timestamp_format::PRECISION> mPrecision_;
+
+        bool mIsCacheValid_;
+        std::int64_t mCachedSecond_;
+        timestamp_format::ZONE mCachedZone_;
+        std::int64_t mCachedOffsetMinute_;
+        long mUtcOffsetSeconds_;
+        /* "[YYYY-MM-DDTHH:MM:SS." of the cached second, and "Z]" or "+HH:MM]" */
+        char mCachedPrefix_[kCachedPrefixLength];
+        char mCachedSuffix_[kMaxCachedSuffixLength];
+        std::size_t mCachedSuffixLength_;
     };
 
 } /*namespace equinox*/
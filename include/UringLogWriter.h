@@ -0,0 +1,142 @@
+/*
+ * UringLogWriter.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_URINGLOGWRITER_H_
+#define INCLUDE_URINGLOGWRITER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "FileWriteLatency.h"
+
+namespace equinox {
+
+    /*
+     * Log file written through io_uring: a batch is copied into one of a few registered buffers and submitted,
+     * the worker goes on formatting while up to kBufferCount writes are in flight. Completions are collected
+     * without waiting, the latencies recorded are from submission to completion.
+     */
+    class UringLogWriter {
+       public:
+        static constexpr std::size_t kBufferCount = 4U;
+        static constexpr std::size_t kBufferBytes = 256U * 1024U;
+
+        explicit UringLogWriter(FileWriteLatency& fileWriteLatency);
+        ~UringLogWriter();
+
+        UringLogWriter(const UringLogWriter&) = delete;
+        UringLogWriter& operator=(const UringLogWriter&) = delete;
+
+        /* Sets the ring up on first use, false when the kernel has no io_uring or it is disabled */
+        bool isAvailable();
+        /* An open file is closed only once the new one is open */
+        bool open(const std::string& fileName, bool truncate);
+        bool isOpen() const;
+        /* Waits only when every buffer is in flight */
+        bool write(const char* data, std::size_t size);
+        /* Queues an fdatasync() that starts once every write submitted before it completed */
+        bool sync();
+        /* Queues an fdatasync() and waits for it, false when it failed */
+        bool syncAndWait();
+        void reapCompletions();
+        /* Waits for the writes and syncs in flight */
+        void close();
+        /* Bytes written so far, without the ones of the writes that failed */
+        std::size_t getSize() const;
+        int getFd() const;
+
+       protected:
+        std::size_t getWritesInFlight() const;
+
+       private:
+        struct BufferState {
+            bool inFlight;
+            std::uint64_t offset;
+            std::size_t size;
+            std::int64_t submitNs;
+        };
+
+        bool setupRing();
+        void teardownRing();
+        void* prepareSqe();
+        bool submit(unsigned sqeCount);
+        bool waitForCompletion();
+        void waitForOperations();
+        bool registerFile(int fd);
+        void releaseFile();
+        void handleCompletion(std::uint64_t userData, std::int32_t result);
+        void completeWrite(std::uint64_t bufferIndex, std::size_t written);
+        int findFreeBuffer() const;
+
+        FileWriteLatency& mFileWriteLatency_;
+        int mRingFd_;
+        bool mRingUnavailable_;
+        void* mSqRing_;
+        std::size_t mSqRingSize_;
+        void* mCqRing_;
+        std::size_t mCqRingSize_;
+        void* mSqes_;
+        std::size_t mSqesSize_;
+        unsigned* mSqHead_;
+        unsigned* mSqTail_;
+        unsigned mSqMask_;
+        unsigned* mSqArray_;
+        unsigned* mCqHead_;
+        unsigned* mCqTail_;
+        unsigned mCqMask_;
+        void* mCqes_;
+        std::unique_ptr<char[]> mBuffers_;
+        std::array<BufferState, kBufferCount> mBufferStates_;
+        std::deque<std::int64_t> mSyncSubmitNs_;
+        std::size_t mOperationsInFlight_;
+        std::uint64_t mSyncsSubmitted_;
+        std::uint64_t mSyncsCompleted_;
+        bool mLastSyncFailed_;
+        int mFd_;
+        std::uint64_t mOffset_;
+        std::uint64_t mLostBytes_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_URINGLOGWRITER_H_ */
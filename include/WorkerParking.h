@@ -0,0 +1,77 @@
+/*
+ * WorkerParking.h
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCLUDE_WORKERPARKING_H_
+#define INCLUDE_WORKERPARKING_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace equinox {
+
+    /*
+     * Futex the idle worker sleeps on without a timeout. Producers pay one fence and one relaxed load per message
+     * and make the wake-up system call only while the worker is parked.
+     */
+    class WorkerParking {
+       public:
+        WorkerParking();
+
+        /* Worker: announces it is about to park, it has to check for work once more before calling park() */
+        std::uint32_t prepareToPark();
+        /* Worker: sleeps until a wake-up newer than the ticket */
+        void park(std::uint32_t ticket);
+        /* Worker: found work after prepareToPark() */
+        void cancelPark();
+
+        /* Producers: wakes the worker only if it is parked or about to park */
+        void notifyIfParked();
+        void wakeUp();
+
+       protected:
+        std::uint32_t getWakeUpsCount() const;
+
+       private:
+        std::atomic<std::uint32_t> mWakeUpSequence_;
+        std::atomic<bool> mParked_;
+    };
+
+} /*namespace equinox*/
+
+#endif /* INCLUDE_WORKERPARKING_H_ */
@@ -26,6 +26,7 @@ BUILD_BASE_DIR="$PROJECT_ROOT/build"
 # Default values
 BUILD_TYPE="Debug"
 BUILD_EXAMPLES=false
+BUILD_BENCHMARKS=false
 BUILD_TESTS=false
 SKIP_TESTS=false
 BUILD_SHARED=true
@@ -77,6 +78,7 @@ TARGETS:
     debug               Build library in Debug mode (default if no type specified)
     release             Build library in Release mode
     examples            Build example applications
+    benchmarks          Build benchmark applications (Release build recommended)
     tests               Build and run unit tests (added to current build type)
     unit                Alias for 'tests'
     format              Format all source files using .clang-format
@@ -103,6 +105,9 @@ EXAMPLES:
     # Build release library with examples and tests
     ./scripts/build.sh release examples tests
 
+    # Build release library with benchmarks
+    ./scripts/build.sh release benchmarks
+
     # Build debug library and examples
     ./scripts/build.sh debug examples
 
@@ -257,6 +262,12 @@ configure_cmake() {
            cmake_args+=("-DEQUINOX_LOGGER_EXAMPLES=OFF")
     fi
     
+    if [ "$BUILD_BENCHMARKS" = true ]; then
+           cmake_args+=("-DEQUINOX_LOGGER_BENCHMARKS=ON")
+    else
+           cmake_args+=("-DEQUINOX_LOGGER_BENCHMARKS=OFF")
+    fi
+
     if [ "$BUILD_TESTS" = true ]; then
            cmake_args+=("-DEQUINOX_LOGGER_TESTS=ON")
     else
@@ -381,6 +392,7 @@ format_code() {
         "$PROJECT_ROOT/api"
         "$PROJECT_ROOT/tests"
         "$PROJECT_ROOT/examples"
+        "$PROJECT_ROOT/benchmarks"
     )
 
     local existing_dirs=()
@@ -416,6 +428,7 @@ display_build_summary() {
     echo "Build Static:            $BUILD_STATIC"
     echo "Build Both:              $BUILD_BOTH"
     echo "Build Examples:          $BUILD_EXAMPLES"
+    echo "Build Benchmarks:        $BUILD_BENCHMARKS"
     echo "Build Tests:             $BUILD_TESTS"
     echo "Skip Running Tests:      $SKIP_TESTS"
     echo "Coverage (LCOV):         $ENABLE_COVERAGE"
@@ -443,6 +456,9 @@ parse_arguments() {
             examples)
                 BUILD_EXAMPLES=true
                 ;;
+            benchmarks)
+                BUILD_BENCHMARKS=true
+                ;;
             tests|unit)
                 BUILD_TESTS=true
                 ;;
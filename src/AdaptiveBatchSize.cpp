@@ -0,0 +1,69 @@
+/*
+ * AdaptiveBatchSize.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "AdaptiveBatchSize.h"
+
+#include <algorithm>
+
+equinox::AdaptiveBatchSize::AdaptiveBatchSize(std::size_t minBatchSize, std::size_t maxBatchSize, bool adaptive)
+    : mMinBatchSize_(std::max<std::size_t>(minBatchSize, 1U)), mMaxBatchSize_(mMinBatchSize_), mAdaptive_(false), mBatchSize_(mMinBatchSize_) {
+    configure(maxBatchSize, adaptive);
+}
+
+void equinox::AdaptiveBatchSize::configure(std::size_t maxBatchSize, bool adaptive) {
+    mMaxBatchSize_ = std::max<std::size_t>(maxBatchSize, 1U);
+    mAdaptive_ = adaptive;
+    mBatchSize_ = mAdaptive_ ? std::min(mMinBatchSize_, mMaxBatchSize_) : mMaxBatchSize_;
+}
+
+void equinox::AdaptiveBatchSize::update(std::size_t consumedRecords) {
+    if (!mAdaptive_) {
+        return;
+    }
+
+    if (consumedRecords >= mBatchSize_) {
+        mBatchSize_ = std::min(mBatchSize_ * 2U, mMaxBatchSize_);
+    } else if (consumedRecords <= mBatchSize_ / 4U) {
+        mBatchSize_ = std::max(mBatchSize_ / 2U, std::min(mMinBatchSize_, mMaxBatchSize_));
+    }
+}
+
+std::size_t equinox::AdaptiveBatchSize::get() const {
+    return mBatchSize_;
+}
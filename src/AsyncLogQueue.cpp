@@ -42,24 +42,72 @@
 #include <chrono>
 
 equinox::AsyncLogQueue::AsyncLogQueue(size_t queue_max_size)
-    : mQueueMaxSize_(queue_max_size), mLogMessagesQueueMutex_{}, mDataInQueueAvailableConditionVariable_{}, mStopRequested_(false) {}
+    : mQueueMaxSize_(queue_max_size),
+      mLogMessagesQueueMutex_{},
+      mDataInQueueAvailableConditionVariable_{},
+      mSpaceInQueueAvailableConditionVariable_{},
+      mStopRequested_(false),
+      mOverflowPolicy_(overflow::POLICY::drop_oldest),
+      mBlockTimeoutMs_(0U),
+      mDroppedRecordVisitor_{},
+      mWaitingProducers_(0U),
+      mWaitingConsumers_(0U) {}
 
 equinox::AsyncLogQueue::~AsyncLogQueue() = default;
 
-void equinox::AsyncLogQueue::enqueue(const std::string& log_message) {
+bool equinox::AsyncLogQueue::enqueue(const std::string& log_message) {
+  return push(log_message, true);
+}
+
+bool equinox::AsyncLogQueue::tryEnqueue(const std::string& log_message) {
+  return push(log_message, false);
+}
+
+bool equinox::AsyncLogQueue::push(const std::string& log_message, bool may_wait) {
   std::unique_lock<std::mutex> lock(mLogMessagesQueueMutex_);
   if (mLogMessagesQueue_.size() >= mQueueMaxSize_) {
-    mLogMessagesQueue_.pop_front();  // Remove the oldest log message to make room for the new one
+    switch (mOverflowPolicy_) {
+      case overflow::POLICY::drop_oldest:
+        if (mDroppedRecordVisitor_) {
+          mDroppedRecordVisitor_(mLogMessagesQueue_.front());
+        }
+        mLogMessagesQueue_.pop_front();  // Remove the oldest log message to make room for the new one
+        break;
+
+      case overflow::POLICY::block:
+        if (may_wait) {
+          ++mWaitingProducers_;
+          mSpaceInQueueAvailableConditionVariable_.wait_for(lock, std::chrono::milliseconds(mBlockTimeoutMs_),
+                                                            [this]() { return mLogMessagesQueue_.size() < mQueueMaxSize_ || mStopRequested_; });
+          --mWaitingProducers_;
+        }
+        if (mLogMessagesQueue_.size() >= mQueueMaxSize_) {
+          return false;
+        }
+        break;
+
+      case overflow::POLICY::drop_newest:
+      default:
+        return false;
+    }
   }
   mLogMessagesQueue_.push_back(log_message);
+  /* The worker polling the queue without waiting does not need the notification */
+  const bool consumerWaiting = mWaitingConsumers_ > 0U;
   lock.unlock();
-  mDataInQueueAvailableConditionVariable_.notify_one();
+  if (consumerWaiting) {
+    mDataInQueueAvailableConditionVariable_.notify_one();
+  }
+  return true;
 }
 
 bool equinox::AsyncLogQueue::dequeue(std::vector<std::string>& out, size_t max_batch_size, uint32_t timeout_ms) {
   std::unique_lock<std::mutex> lock(mLogMessagesQueueMutex_);
-  if (!mDataInQueueAvailableConditionVariable_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
-                                                        [this]() { return !mLogMessagesQueue_.empty() || mStopRequested_; })) {
+  ++mWaitingConsumers_;
+  const bool dataAvailable = mDataInQueueAvailableConditionVariable_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                                                              [this]() { return !mLogMessagesQueue_.empty() || mStopRequested_; });
+  --mWaitingConsumers_;
+  if (!dataAvailable) {
     return false;
   }
 
@@ -74,6 +122,10 @@ bool equinox::AsyncLogQueue::dequeue(std::vector<std::string>& out, size_t max_b
     mLogMessagesQueue_.pop_front();
   }
 
+  if (mWaitingProducers_ > 0U) {
+    mSpaceInQueueAvailableConditionVariable_.notify_all();
+  }
+
   return true;
 }
 
@@ -82,6 +134,14 @@ void equinox::AsyncLogQueue::stop() {
   mStopRequested_ = true;
   lock.unlock();
   mDataInQueueAvailableConditionVariable_.notify_all();
+  mSpaceInQueueAvailableConditionVariable_.notify_all();
+}
+
+void equinox::AsyncLogQueue::setOverflowPolicy(overflow::POLICY policy, uint32_t block_timeout_ms, const LogRecordVisitor& dropped_record_visitor) {
+  std::lock_guard<std::mutex> lock(mLogMessagesQueueMutex_);
+  mOverflowPolicy_ = policy;
+  mBlockTimeoutMs_ = block_timeout_ms;
+  mDroppedRecordVisitor_ = dropped_record_visitor;
 }
 
 std::deque<std::string>& equinox::AsyncLogQueue::getLogMessagesQueue() {
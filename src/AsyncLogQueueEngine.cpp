@@ -39,10 +39,80 @@
 
 #include "AsyncLogQueueEngine.h"
 
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#include "ByteRingLogQueue.h"
+#include "PerCpuLogQueue.h"
+#include "PerThreadLogQueue.h"
+
 namespace {
 static constexpr std::size_t kDefaultQueueMaxSize = 10000U;
-static constexpr std::size_t kDefaultBatchSize = 64U;
-static constexpr uint32_t kDefaultDequeueTimeoutMs = 50U;
+static constexpr std::size_t kDefaultPerThreadQueueSize = 1024U;
+static constexpr std::size_t kDefaultByteRingQueueSizeBytes = 4U * 1024U * 1024U;
+static constexpr std::size_t kDefaultPerCpuQueueSizeBytes = 256U * 1024U;
+static constexpr std::size_t kMinAdaptiveBatchSize = 4U;
+/* Empty polls of the adaptive wait strategy before it yields the CPU, and before it parks */
+static constexpr std::size_t kAdaptiveSpinRounds = 128U;
+static constexpr std::size_t kAdaptiveYieldRounds = 16U;
+
+/* Every queued log record starts with one byte telling the worker how to render it, followed by the LogRecordHeader */
+static constexpr char kTextLogRecord = 'T';
+static constexpr char kDeferredLogRecord = 'D';
+static constexpr std::size_t kLogRecordTypeOffset = 0U;
+static constexpr std::size_t kLogRecordHeaderOffset = 1U;
+static constexpr std::size_t kLogRecordHeaderSize = kLogRecordHeaderOffset + sizeof(equinox::LogRecordHeader);
+
+equinox::LogRecordHeader readLogRecordHeader(std::string_view logRecord) {
+  equinox::LogRecordHeader header;
+  std::memcpy(&header, logRecord.data() + kLogRecordHeaderOffset, sizeof(header));
+  return header;
+}
+
+std::uint32_t getCurrentThreadId() {
+  thread_local const auto threadId = static_cast<std::uint32_t>(syscall(SYS_gettid));
+  return threadId;
+}
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+/* Called on the worker thread; cpu -1 allows every CPU again and priority 0 restores the default policy */
+void applyWorkerThreadSettings(int cpu, int priority) {
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (cpu >= 0 && cpu < CPU_SETSIZE) {
+    CPU_SET(cpu, &cpuSet);
+  } else {
+    const long cpuCount = std::min<long>(sysconf(_SC_NPROCESSORS_CONF), CPU_SETSIZE);
+    for (long cpuIndex = 0; cpuIndex < cpuCount; ++cpuIndex) {
+      CPU_SET(static_cast<int>(cpuIndex), &cpuSet);
+    }
+  }
+  if (const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet); error != 0) {
+    std::cerr << "[EquinoxLogger] Failed to set the worker thread CPU affinity: " << std::strerror(error) << std::endl;
+  }
+
+  sched_param schedulingParameters{};
+  schedulingParameters.sched_priority = std::max(priority, 0);
+  if (const int error = pthread_setschedparam(pthread_self(), (priority > 0) ? SCHED_FIFO : SCHED_OTHER, &schedulingParameters); error != 0) {
+    std::cerr << "[EquinoxLogger] Failed to set the worker thread priority: " << std::strerror(error) << std::endl;
+  }
+}
 }  // namespace
 
 equinox::AsyncLogQueueEngine::AsyncLogQueueEngine(std::shared_ptr<ITimestampProducer> timestamp_procducer, std::shared_ptr<IFileLogsProducer> fileLogsProducer,
@@ -55,21 +125,124 @@ equinox::AsyncLogQueueEngine::AsyncLogQueueEngine(std::shared_ptr<ITimestampProd
                                                   std::unique_ptr<IConsoleLogsProducer> consoleLogsProducer,
                                                   std::shared_ptr<IFileLogsProducer> fileLogsProducer, logs_output::SINK logsOutputSink,
                                                   std::unique_ptr<IAsyncLogQueue> logMessageQueue)
-    : mLogMessageQueue_(std::move(logMessageQueue)),
+    : mLogMessageQueue_(logMessageQueue.get()),
+      mOwnedLogMessageQueue_(std::move(logMessageQueue)),
+      mInFlightProducers_{},
+      mRetiredLogMessageQueues_{},
+      mLogMessageQueuesRetired_(false),
+      mRetiredLogMessageQueuesMutex_{},
+      mQueueType_(queue::TYPE::shared),
+      mQueueHugePages_(false),
+      mQueueCapacity_(0U),
+      mBatchSize_(LoggerOptions{}.batchSize),
+      mAdaptiveBatching_(LoggerOptions{}.adaptiveBatching),
+      mDequeueTimeoutMs_(LoggerOptions{}.dequeueTimeoutMs),
+      mWorkerWaitStrategy_(LoggerOptions{}.workerWaitStrategy),
+      mWorkerCpu_(LoggerOptions{}.workerCpu),
+      mWorkerPriority_(LoggerOptions{}.workerPriority),
+      mWorkerParking_{},
+      mOverflowStats_{},
+      mLogClock_{},
+      mQueueConfigMutex_{},
       mWorkerThread_{},
       mIsWorkerRunning_(false),
       mOutputMutex_{},
       mTimestampProducer_(timestamp_procducer),
       mConsoleLogsProducer_(std::move(consoleLogsProducer)),
       mFileLogsProducer_(fileLogsProducer),
-      mLogsOutputSink_(logsOutputSink) {}
+      mLogsOutputSink_(logsOutputSink),
+      mDeferredMessageFormatter_{},
+      mRenderedMessage_{},
+      mConsoleLinesPending_(false),
+      mFileLinesPending_(false),
+      mFileSyncPending_(false) {
+  applyOverflowPolicy(*mOwnedLogMessageQueue_, LoggerOptions{});
+}
 
 equinox::AsyncLogQueueEngine::~AsyncLogQueueEngine() {
   stopWorker();
 }
 
-void equinox::AsyncLogQueueEngine::processLogMessage(const std::string& messageToProcess) {
-  mLogMessageQueue_->enqueue(messageToProcess);
+bool equinox::AsyncLogQueueEngine::processLogMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, std::string_view messageToProcess,
+                                                     bool nonBlocking) {
+  thread_local std::string logRecord;
+  logRecord.clear();
+  appendLogRecordHeader(logRecord, kTextLogRecord, msgLevel, callSiteId);
+  logRecord.append(messageToProcess);
+  return enqueueLogRecord(msgLevel, logRecord, nonBlocking);
+}
+
+bool equinox::AsyncLogQueueEngine::processDeferredLogMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, const std::string& encodedMessage,
+                                                             bool nonBlocking) {
+  thread_local std::string logRecord;
+  logRecord.clear();
+  appendLogRecordHeader(logRecord, kDeferredLogRecord, msgLevel, callSiteId);
+  logRecord.append(encodedMessage);
+  return enqueueLogRecord(msgLevel, logRecord, nonBlocking);
+}
+
+void equinox::AsyncLogQueueEngine::appendLogRecordHeader(std::string& logRecord, char recordType, level::LOG_LEVEL msgLevel, std::uint32_t callSiteId) {
+  LogRecordHeader header;
+  header.level = msgLevel;
+  /* The time is taken here, on the logging thread, so a backlog in the queue does not delay it */
+  header.clockSource = mLogClock_.getSource();
+  header.threadId = getCurrentThreadId();
+  header.callSiteId = callSiteId;
+  header.timestampTicks = LogClock::readTicks(header.clockSource);
+  logRecord.push_back(recordType);
+  logRecord.append(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+bool equinox::AsyncLogQueueEngine::enqueueLogRecord(level::LOG_LEVEL msgLevel, const std::string& logRecord, bool nonBlocking) {
+  const std::uint32_t producerToken = mInFlightProducers_.enter();
+  IAsyncLogQueue* logMessageQueue = mLogMessageQueue_.load(std::memory_order_seq_cst);
+  const bool enqueued = nonBlocking ? logMessageQueue->tryEnqueue(logRecord) : logMessageQueue->enqueue(logRecord);
+  mInFlightProducers_.leave(producerToken);
+  if (enqueued) {
+    /* With the timed strategy the worker waits inside the queue, which signals it itself */
+    if (mWorkerWaitStrategy_.load(std::memory_order_relaxed) != worker_wait::STRATEGY::timed) {
+      mWorkerParking_.notifyIfParked();
+    }
+    return true;
+  }
+
+  mOverflowStats_.recordDroppedMessage(msgLevel);
+  return false;
+}
+
+std::uint64_t equinox::AsyncLogQueueEngine::getDroppedMessagesCount(level::LOG_LEVEL msgLevel) {
+  return mOverflowStats_.getDroppedMessagesCount(msgLevel);
+}
+
+void equinox::AsyncLogQueueEngine::applyOverflowPolicy(IAsyncLogQueue& logMessageQueue, const LoggerOptions& options) {
+  /* Messages evicted by drop_oldest never come back from enqueue(), count them by the level stored in the record */
+  logMessageQueue.setOverflowPolicy(options.overflowPolicy, options.overflowBlockTimeoutMs, [this](std::string_view droppedLogRecord) {
+    if (droppedLogRecord.size() >= kLogRecordHeaderSize) {
+      mOverflowStats_.recordDroppedMessage(readLogRecordHeader(droppedLogRecord).level);
+    }
+  });
+}
+
+bool equinox::AsyncLogQueueEngine::renderLogRecord(std::string_view logRecord, std::string& renderedMessage) {
+  renderedMessage.clear();
+  if (logRecord.size() < kLogRecordHeaderSize) {
+    return false;
+  }
+
+  if (logRecord[kLogRecordTypeOffset] == kTextLogRecord) {
+    renderedMessage.append(logRecord.substr(kLogRecordHeaderSize));
+    return true;
+  }
+
+  if (logRecord[kLogRecordTypeOffset] != kDeferredLogRecord) {
+    return false;
+  }
+
+  if (!mDeferredMessageFormatter_.format(logRecord.substr(kLogRecordHeaderSize), renderedMessage)) {
+    std::cerr << "[EquinoxLogger] Malformed deferred log message" << std::endl;
+    return false;
+  }
+  return true;
 }
 
 void equinox::AsyncLogQueueEngine::startWorkerIfNeeded() {
@@ -79,45 +252,212 @@ void equinox::AsyncLogQueueEngine::startWorkerIfNeeded() {
   }
 
   mWorkerThread_ = std::thread([this]() {
-    std::vector<std::string> batch;
+    std::size_t consumedRecords = 0U;
+    const LogRecordVisitor dispatch = [this, &consumedRecords](std::string_view logRecord) {
+      ++consumedRecords;
+      dispatchLogRecord(logRecord);
+    };
+    IAsyncLogQueue* logMessageQueue = mLogMessageQueue_.load(std::memory_order_acquire);
+    std::size_t maxBatchSize = mBatchSize_.load(std::memory_order_relaxed);
+    bool adaptiveBatching = mAdaptiveBatching_.load(std::memory_order_relaxed);
+    AdaptiveBatchSize batchSize(kMinAdaptiveBatchSize, maxBatchSize, adaptiveBatching);
+    int workerCpu = LoggerOptions{}.workerCpu;
+    int workerPriority = LoggerOptions{}.workerPriority;
+    std::size_t idleRounds = 0U;
     while (true) {
-      batch.clear();
-      if (!mLogMessageQueue_->dequeue(batch, kDefaultBatchSize, kDefaultDequeueTimeoutMs)) {
-        if (!mIsWorkerRunning_.load()) {
-          break;
-        }
+      writeDroppedMessagesMarker();
+      if (workerCpu != mWorkerCpu_.load(std::memory_order_relaxed) || workerPriority != mWorkerPriority_.load(std::memory_order_relaxed)) {
+        workerCpu = mWorkerCpu_.load(std::memory_order_relaxed);
+        workerPriority = mWorkerPriority_.load(std::memory_order_relaxed);
+        applyWorkerThreadSettings(workerCpu, workerPriority);
+      }
+
+      if (maxBatchSize != mBatchSize_.load(std::memory_order_relaxed) || adaptiveBatching != mAdaptiveBatching_.load(std::memory_order_relaxed)) {
+        maxBatchSize = mBatchSize_.load(std::memory_order_relaxed);
+        adaptiveBatching = mAdaptiveBatching_.load(std::memory_order_relaxed);
+        batchSize.configure(maxBatchSize, adaptiveBatching);
+      }
+
+      /* Producers blocked in a replaced queue rely on the worker until they left it */
+      if (mLogMessageQueuesRetired_.load(std::memory_order_acquire)) {
+        drainRetiredLogMessageQueues(dispatch, maxBatchSize);
+      }
+      logMessageQueue = mLogMessageQueue_.load(std::memory_order_acquire);
+
+      const worker_wait::STRATEGY waitStrategy = mWorkerWaitStrategy_.load(std::memory_order_relaxed);
+      /* Buffered lines must not wait for the dequeue timeout, written ones not past their periodic sync */
+      const bool linesPending = mConsoleLinesPending_ || mFileLinesPending_;
+      uint32_t timeoutMs =
+          (waitStrategy == worker_wait::STRATEGY::timed && !linesPending) ? mDequeueTimeoutMs_.load(std::memory_order_relaxed) : 0U;
+      const bool waitForFileSync = !linesPending && mFileSyncPending_ && waitStrategy != worker_wait::STRATEGY::busy_poll;
+      if (waitForFileSync) {
+        const uint32_t syncDelayMs = mFileLogsProducer_->getSyncDelayMs().value_or(0U);
+        timeoutMs = (waitStrategy == worker_wait::STRATEGY::timed) ? std::min(timeoutMs, syncDelayMs) : syncDelayMs;
+      }
+      consumedRecords = 0U;
+      const std::size_t requestedRecords = batchSize.get();
+      const bool consumed = logMessageQueue->consume(dispatch, requestedRecords, timeoutMs);
+      batchSize.update(consumedRecords);
+      if (consumedRecords < requestedRecords) {
+        /* The queue is drained, nothing more joins the batch soon */
+        writePendingLines();
+      }
+      if (consumed) {
+        idleRounds = 0U;
         continue;
       }
 
-      for (const auto& message : batch) {
-        {
-          std::lock_guard<std::mutex> lock(mOutputMutex_);
-          switch (mLogsOutputSink_) {
-            case logs_output::SINK::console:
-              mConsoleLogsProducer_->logMessage(message);
-              break;
-
-            case logs_output::SINK::file:
-              mFileLogsProducer_->logMessage(message);
-              break;
-
-            case logs_output::SINK::console_and_file:
-              mConsoleLogsProducer_->logMessage(message);
-              mFileLogsProducer_->logMessage(message);
-              break;
-          }
-        }
+      if (!mIsWorkerRunning_.load() && !mLogMessageQueuesRetired_.load(std::memory_order_acquire)) {
+        break;
+      }
+      if (waitForFileSync) {
+        /* Already waited inside the queue, parking would hold the sync back until the next message */
+        continue;
       }
+      waitForLogRecords(*logMessageQueue, dispatch, maxBatchSize, waitStrategy, idleRounds++);
     }
   });
 }
 
+void equinox::AsyncLogQueueEngine::drainRetiredLogMessageQueues(const LogRecordVisitor& dispatch, std::size_t maxBatchSize) {
+  /* Only the worker frees them, the queues stay valid without the lock */
+  std::vector<std::pair<IAsyncLogQueue*, bool>> retiredLogMessageQueues;
+  {
+    std::lock_guard<std::mutex> lock(mRetiredLogMessageQueuesMutex_);
+    for (const auto& retiredLogMessageQueue : mRetiredLogMessageQueues_) {
+      retiredLogMessageQueues.emplace_back(retiredLogMessageQueue.logMessageQueue.get(), retiredLogMessageQueue.producersLeft);
+    }
+  }
+
+  /* Oldest first, a stopped queue hands out what it holds without waiting */
+  for (const auto& retiredLogMessageQueue : retiredLogMessageQueues) {
+    while (retiredLogMessageQueue.first->consume(dispatch, maxBatchSize, 0U)) {
+    }
+  }
+
+  /* Drained after their producers left, nothing can be added to them any more */
+  const auto drainedForGood = [&retiredLogMessageQueues](const RetiredLogMessageQueue& retiredLogMessageQueue) {
+    return std::find(retiredLogMessageQueues.begin(), retiredLogMessageQueues.end(), std::make_pair(retiredLogMessageQueue.logMessageQueue.get(), true)) !=
+           retiredLogMessageQueues.end();
+  };
+  std::lock_guard<std::mutex> lock(mRetiredLogMessageQueuesMutex_);
+  mRetiredLogMessageQueues_.erase(std::remove_if(mRetiredLogMessageQueues_.begin(), mRetiredLogMessageQueues_.end(), drainedForGood),
+                                  mRetiredLogMessageQueues_.end());
+  mLogMessageQueuesRetired_.store(!mRetiredLogMessageQueues_.empty(), std::memory_order_release);
+}
+
+void equinox::AsyncLogQueueEngine::waitForLogRecords(IAsyncLogQueue& logMessageQueue, const LogRecordVisitor& dispatch, std::size_t maxBatchSize,
+                                                     worker_wait::STRATEGY waitStrategy, std::size_t idleRounds) {
+  switch (waitStrategy) {
+    case worker_wait::STRATEGY::timed:
+      /* Already waited inside the queue */
+      break;
+
+    case worker_wait::STRATEGY::busy_poll:
+      cpuRelax();
+      break;
+
+    case worker_wait::STRATEGY::adaptive:
+      if (idleRounds < kAdaptiveSpinRounds) {
+        cpuRelax();
+        break;
+      }
+      if (idleRounds < kAdaptiveSpinRounds + kAdaptiveYieldRounds) {
+        std::this_thread::yield();
+        break;
+      }
+      parkWorker(logMessageQueue, dispatch, maxBatchSize);
+      break;
+
+    case worker_wait::STRATEGY::blocking:
+    default:
+      parkWorker(logMessageQueue, dispatch, maxBatchSize);
+      break;
+  }
+}
+
+void equinox::AsyncLogQueueEngine::parkWorker(IAsyncLogQueue& logMessageQueue, const LogRecordVisitor& dispatch, std::size_t maxBatchSize) {
+  const uint32_t ticket = mWorkerParking_.prepareToPark();
+  /* Anything published before the producers could see the worker parked has to be handled before sleeping */
+  if (!mIsWorkerRunning_.load() || mWorkerWaitStrategy_.load(std::memory_order_relaxed) == worker_wait::STRATEGY::timed ||
+      mLogMessageQueuesRetired_.load(std::memory_order_acquire) || logMessageQueue.consume(dispatch, maxBatchSize, 0U)) {
+    mWorkerParking_.cancelPark();
+    return;
+  }
+  mWorkerParking_.park(ticket);
+}
+
+void equinox::AsyncLogQueueEngine::dispatchLogRecord(std::string_view logRecord) {
+  if (!renderLogRecord(logRecord, mRenderedMessage_)) {
+    return;
+  }
+
+  const LogRecordHeader header = readLogRecordHeader(logRecord);
+  writeRenderedMessage(
+      LogRecordMetadata{header.level, mLogClock_.toNanosecondsSinceEpoch(header.clockSource, header.timestampTicks), header.threadId, header.callSiteId});
+}
+
+void equinox::AsyncLogQueueEngine::writeDroppedMessagesMarker() {
+  const std::uint64_t droppedMessagesCount = mOverflowStats_.takeDroppedMessagesSinceLastMarker();
+  if (droppedMessagesCount == 0U) {
+    return;
+  }
+
+  /* Marks the gap in the output, so a reader knows messages are missing at this point */
+  mRenderedMessage_.assign("[EquinoxLogger] ");
+  mRenderedMessage_.append(std::to_string(droppedMessagesCount));
+  mRenderedMessage_.append(" log messages dropped, the queue was full");
+  const timestamp_clock::SOURCE clockSource = mLogClock_.getSource();
+  writeRenderedMessage(
+      LogRecordMetadata{level::LOG_LEVEL::warning, mLogClock_.toNanosecondsSinceEpoch(clockSource, LogClock::readTicks(clockSource)), getCurrentThreadId(), 0U});
+}
+
+void equinox::AsyncLogQueueEngine::writeRenderedMessage(const LogRecordMetadata& metadata) {
+  std::lock_guard<std::mutex> lock(mOutputMutex_);
+  switch (mLogsOutputSink_) {
+    case logs_output::SINK::console:
+      mConsoleLogsProducer_->logMessage(mRenderedMessage_, metadata);
+      mConsoleLinesPending_ = true;
+      break;
+
+    case logs_output::SINK::file:
+      mFileLogsProducer_->logMessage(mRenderedMessage_, metadata);
+      mFileLinesPending_ = true;
+      break;
+
+    case logs_output::SINK::console_and_file:
+      mConsoleLogsProducer_->logMessage(mRenderedMessage_, metadata);
+      mConsoleLinesPending_ = true;
+      mFileLogsProducer_->logMessage(mRenderedMessage_, metadata);
+      mFileLinesPending_ = true;
+      break;
+  }
+}
+
+void equinox::AsyncLogQueueEngine::writePendingLines() {
+  if (!mConsoleLinesPending_ && !mFileLinesPending_ && !mFileSyncPending_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mOutputMutex_);
+  if (mConsoleLinesPending_) {
+    mConsoleLogsProducer_->flush();
+    mConsoleLinesPending_ = false;
+  }
+  if (mFileLinesPending_ || mFileSyncPending_) {
+    mFileLogsProducer_->flush();
+    mFileLinesPending_ = false;
+    mFileSyncPending_ = mFileLogsProducer_->getSyncDelayMs().has_value();
+  }
+}
+
 void equinox::AsyncLogQueueEngine::stopWorker() {
   if (!mIsWorkerRunning_.exchange(false)) {
     return;
   }
 
-  mLogMessageQueue_->stop();
+  mLogMessageQueue_.load(std::memory_order_acquire)->stop();
+  mWorkerParking_.wakeUp();
   if (mWorkerThread_.joinable()) {
     mWorkerThread_.join();
   }
@@ -128,6 +468,86 @@ void equinox::AsyncLogQueueEngine::setLogsOutputSink(logs_output::SINK logsOutpu
   mLogsOutputSink_ = logsOutputSink;
 }
 
+void equinox::AsyncLogQueueEngine::setLogPrefix(const std::string& logPrefix) {
+  /* The worker holds the same lock while a sink copies the templates */
+  std::lock_guard<std::mutex> lock(mOutputMutex_);
+  mConsoleLogsProducer_->setLogPrefix(logPrefix);
+  mFileLogsProducer_->setLogPrefix(logPrefix);
+}
+
+std::unique_ptr<equinox::IAsyncLogQueue> equinox::AsyncLogQueueEngine::createLogMessageQueue(const LoggerOptions& options) const {
+  const auto capacityOrDefault = [&options](std::size_t defaultCapacity) { return (options.queueCapacity > 0U) ? options.queueCapacity : defaultCapacity; };
+
+  switch (options.queueType) {
+    case queue::TYPE::per_thread:
+      return std::make_unique<PerThreadLogQueue>(capacityOrDefault(kDefaultPerThreadQueueSize));
+
+    case queue::TYPE::byte_ring:
+      return std::make_unique<ByteRingLogQueue>(capacityOrDefault(kDefaultByteRingQueueSizeBytes), options.queueHugePages);
+
+    case queue::TYPE::per_cpu:
+      return std::make_unique<PerCpuLogQueue>(capacityOrDefault(kDefaultPerCpuQueueSizeBytes),
+                                              static_cast<std::size_t>(std::max(1L, sysconf(_SC_NPROCESSORS_CONF))));
+
+    case queue::TYPE::shared:
+    default:
+      return std::make_unique<AsyncLogQueue>(capacityOrDefault(kDefaultQueueMaxSize));
+  }
+}
+
+void equinox::AsyncLogQueueEngine::configureQueue(const LoggerOptions& options) {
+  std::lock_guard<std::mutex> lock(mQueueConfigMutex_);
+  mBatchSize_.store(std::max<std::size_t>(options.batchSize, 1U), std::memory_order_relaxed);
+  mAdaptiveBatching_.store(options.adaptiveBatching, std::memory_order_relaxed);
+  mDequeueTimeoutMs_.store(options.dequeueTimeoutMs, std::memory_order_relaxed);
+  mWorkerWaitStrategy_.store(options.workerWaitStrategy, std::memory_order_relaxed);
+  mWorkerCpu_.store(options.workerCpu, std::memory_order_relaxed);
+  mWorkerPriority_.store(options.workerPriority, std::memory_order_relaxed);
+  mLogClock_.setSource(options.timestampClock);
+  if (mTimestampProducer_) {
+    mTimestampProducer_->setFormat(options.timestampZone, options.timestampPrecision);
+  }
+  {
+    std::lock_guard<std::mutex> outputLock(mOutputMutex_);
+    mConsoleLogsProducer_->setFlushIntervalMs(options.consoleFlushIntervalMs);
+  }
+
+  if (options.queueType == mQueueType_ && options.queueHugePages == mQueueHugePages_ && options.queueCapacity == mQueueCapacity_) {
+    applyOverflowPolicy(*mLogMessageQueue_.load(std::memory_order_acquire), options);
+    /* A parked worker picks up the new settings, producers would not wake it up after a switch to timed */
+    mWorkerParking_.wakeUp();
+    return;
+  }
+
+  std::unique_ptr<IAsyncLogQueue> logMessageQueue = createLogMessageQueue(options);
+  applyOverflowPolicy(*logMessageQueue, options);
+  mQueueType_ = options.queueType;
+  mQueueHugePages_ = options.queueHugePages;
+  mQueueCapacity_ = options.queueCapacity;
+  mLogMessageQueue_.store(logMessageQueue.get(), std::memory_order_seq_cst);
+  IAsyncLogQueue* replacedLogMessageQueue = mOwnedLogMessageQueue_.get();
+  {
+    std::lock_guard<std::mutex> retiredLock(mRetiredLogMessageQueuesMutex_);
+    mRetiredLogMessageQueues_.push_back(RetiredLogMessageQueue{std::exchange(mOwnedLogMessageQueue_, std::move(logMessageQueue)), false});
+    mLogMessageQueuesRetired_.store(true, std::memory_order_release);
+  }
+  mWorkerParking_.wakeUp();
+
+  /* A producer that loaded the replaced queue may still be enqueuing to it, the worker keeps draining it meanwhile */
+  mInFlightProducers_.waitForProducers();
+  /* Not freed before producersLeft is set; a worker waiting inside it returns at once */
+  replacedLogMessageQueue->stop();
+  {
+    std::lock_guard<std::mutex> retiredLock(mRetiredLogMessageQueuesMutex_);
+    for (auto& retiredLogMessageQueue : mRetiredLogMessageQueues_) {
+      if (retiredLogMessageQueue.logMessageQueue.get() == replacedLogMessageQueue) {
+        retiredLogMessageQueue.producersLeft = true;
+      }
+    }
+  }
+  mWorkerParking_.wakeUp();
+}
+
 void equinox::AsyncLogQueueEngine::flush() {
   std::lock_guard<std::mutex> lock(mOutputMutex_);
   mConsoleLogsProducer_->flush();
@@ -0,0 +1,286 @@
+/*
+ * ByteRingLogQueue.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "ByteRingLogQueue.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#include "OverflowWait.h"
+
+namespace {
+/*
+ * Record layout, every record starts at a multiple of kRecordAlignment:
+ * [uint32 state][uint32 length][message bytes][padding to kRecordAlignment]
+ * The state word is written last by the producer and zeroed again by the worker once the record is consumed.
+ */
+static constexpr uint32_t kRecordEmpty = 0U;
+static constexpr uint32_t kRecordCommitted = 1U;
+/* Fills the end of the ring when a record does not fit before the wrap, the length covers the whole gap */
+static constexpr uint32_t kRecordPadding = 2U;
+
+static constexpr size_t kRecordHeaderSize = 2U * sizeof(uint32_t);
+static constexpr size_t kRecordAlignment = 8U;
+static constexpr size_t kMinCapacity = 4096U;
+static constexpr size_t kHugePageSize = 2U * 1024U * 1024U;
+
+size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1U) & ~(alignment - 1U);
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+  size_t result = 1U;
+  while (result < value) {
+    result <<= 1U;
+  }
+  return result;
+}
+
+uint32_t loadRecordState(const char* record) {
+  return __atomic_load_n(reinterpret_cast<const uint32_t*>(record), __ATOMIC_ACQUIRE);
+}
+
+void storeRecordState(char* record, uint32_t state) {
+  __atomic_store_n(reinterpret_cast<uint32_t*>(record), state, __ATOMIC_RELEASE);
+}
+
+uint32_t loadRecordLength(const char* record) {
+  uint32_t length = 0U;
+  std::memcpy(&length, record + sizeof(uint32_t), sizeof(length));
+  return length;
+}
+
+void storeRecordLength(char* record, uint32_t length) {
+  std::memcpy(record + sizeof(uint32_t), &length, sizeof(length));
+}
+}  // namespace
+
+equinox::ByteRingLogQueue::ByteRingLogQueue(size_t capacity_bytes, bool use_huge_pages)
+    : mCapacity_(roundUpToPowerOfTwo(std::max(capacity_bytes, kMinCapacity))),
+      mMappingSize_(mCapacity_),
+      mBuffer_(nullptr),
+      mBackedByHugePages_(false),
+      mWritePosition_(0U),
+      mReadPosition_(0U),
+      mWorkerMutex_{},
+      mWorkerConditionVariable_{},
+      mWorkerWaiting_(false),
+      mStopRequested_(false),
+      mDroppedMessagesCount_(0U),
+      mOverflowPolicy_(overflow::POLICY::drop_oldest),
+      mBlockTimeoutMs_(0U) {
+  void* mapping = MAP_FAILED;
+  if (use_huge_pages) {
+    mMappingSize_ = alignUp(mCapacity_, kHugePageSize);
+    mapping = mmap(nullptr, mMappingSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    mBackedByHugePages_ = (mapping != MAP_FAILED);
+  }
+
+  if (mapping == MAP_FAILED) {
+    mapping = mmap(nullptr, mMappingSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    if (use_huge_pages) {
+      /* No reserved huge pages, let transparent huge pages back the ring if they are enabled */
+      madvise(mapping, mMappingSize_, MADV_HUGEPAGE);
+    }
+  }
+
+  /* Anonymous mappings are zeroed, so every state word starts as kRecordEmpty */
+  mBuffer_ = static_cast<char*>(mapping);
+}
+
+equinox::ByteRingLogQueue::~ByteRingLogQueue() {
+  munmap(mBuffer_, mMappingSize_);
+}
+
+bool equinox::ByteRingLogQueue::enqueue(const std::string& log_message) {
+  return push(log_message, mOverflowPolicy_.load(std::memory_order_relaxed) == overflow::POLICY::block);
+}
+
+bool equinox::ByteRingLogQueue::tryEnqueue(const std::string& log_message) {
+  return push(log_message, false);
+}
+
+bool equinox::ByteRingLogQueue::push(const std::string& log_message, bool may_wait) {
+  const size_t recordSize = alignUp(kRecordHeaderSize + log_message.size(), kRecordAlignment);
+  /* A record larger than half of the ring may never fit, waiting for it would only block the producer */
+  if (recordSize > mCapacity_ / 2U ||
+      (!tryWriteRecord(log_message, recordSize) &&
+       !(may_wait && retryUntilTimeout([this, &log_message, recordSize]() { return tryWriteRecord(log_message, recordSize); },
+                                       mBlockTimeoutMs_.load(std::memory_order_relaxed))))) {
+    mDroppedMessagesCount_.fetch_add(1U, std::memory_order_relaxed);
+    return false;
+  }
+
+  /* Pairs with the fence in consume(): either the worker sees the record or this thread sees it waiting */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (mWorkerWaiting_.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(mWorkerMutex_);
+    mWorkerConditionVariable_.notify_one();
+  }
+  return true;
+}
+
+bool equinox::ByteRingLogQueue::tryWriteRecord(const std::string& log_message, size_t record_size) {
+  /*
+   * A plain fetch-add could move the write position past the worker and there would be no way to give the space back,
+   * so the reservation is a compare-and-swap that only succeeds when the record fits.
+   */
+  uint64_t writePosition = mWritePosition_.load(std::memory_order_relaxed);
+  size_t paddingSize = 0U;
+  uint64_t reservationEnd = 0U;
+  do {
+    const size_t offset = static_cast<size_t>(writePosition & (mCapacity_ - 1U));
+    paddingSize = (offset + record_size > mCapacity_) ? mCapacity_ - offset : 0U;
+    reservationEnd = writePosition + paddingSize + record_size;
+    if (reservationEnd - mReadPosition_.load(std::memory_order_acquire) > mCapacity_) {
+      return false;
+    }
+  } while (!mWritePosition_.compare_exchange_weak(writePosition, reservationEnd, std::memory_order_relaxed));
+
+  if (paddingSize > 0U) {
+    char* padding = mBuffer_ + (writePosition & (mCapacity_ - 1U));
+    storeRecordLength(padding, static_cast<uint32_t>(paddingSize));
+    storeRecordState(padding, kRecordPadding);
+  }
+
+  char* record = mBuffer_ + ((writePosition + paddingSize) & (mCapacity_ - 1U));
+  storeRecordLength(record, static_cast<uint32_t>(log_message.size()));
+  std::memcpy(record + kRecordHeaderSize, log_message.data(), log_message.size());
+  storeRecordState(record, kRecordCommitted);
+  return true;
+}
+
+size_t equinox::ByteRingLogQueue::consumeCommittedRecords(const LogRecordVisitor& visitor, size_t max_batch_size) {
+  const uint64_t startPosition = mReadPosition_.load(std::memory_order_relaxed);
+  const uint64_t writePosition = mWritePosition_.load(std::memory_order_acquire);
+  uint64_t readPosition = startPosition;
+  size_t consumed = 0U;
+
+  while (readPosition < writePosition && consumed < max_batch_size) {
+    const char* record = mBuffer_ + (readPosition & (mCapacity_ - 1U));
+    const uint32_t state = loadRecordState(record);
+    if (state == kRecordEmpty) {
+      /* Reserved but not committed yet, the records behind it have to wait */
+      break;
+    }
+
+    const uint32_t length = loadRecordLength(record);
+    if (state == kRecordPadding) {
+      readPosition += length;
+      continue;
+    }
+
+    visitor(std::string_view(record + kRecordHeaderSize, length));
+    readPosition += alignUp(kRecordHeaderSize + length, kRecordAlignment);
+    ++consumed;
+  }
+
+  if (readPosition == startPosition) {
+    return consumed;
+  }
+
+  /* Producers rely on zeroed state words, the consumed range wraps at most once */
+  const size_t startOffset = static_cast<size_t>(startPosition & (mCapacity_ - 1U));
+  const size_t consumedBytes = static_cast<size_t>(readPosition - startPosition);
+  const size_t firstPart = std::min(consumedBytes, mCapacity_ - startOffset);
+  std::memset(mBuffer_ + startOffset, 0, firstPart);
+  std::memset(mBuffer_, 0, consumedBytes - firstPart);
+
+  mReadPosition_.store(readPosition, std::memory_order_release);
+  return consumed;
+}
+
+bool equinox::ByteRingLogQueue::hasPendingWork() const {
+  if (mStopRequested_.load(std::memory_order_acquire)) {
+    return true;
+  }
+  const uint64_t readPosition = mReadPosition_.load(std::memory_order_relaxed);
+  return loadRecordState(mBuffer_ + (readPosition & (mCapacity_ - 1U))) != kRecordEmpty;
+}
+
+bool equinox::ByteRingLogQueue::consume(const LogRecordVisitor& visitor, size_t max_batch_size, uint32_t timeout_ms) {
+  if (consumeCommittedRecords(visitor, max_batch_size) > 0U) {
+    return true;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mWorkerMutex_);
+    mWorkerWaiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    mWorkerConditionVariable_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]() { return hasPendingWork(); });
+    mWorkerWaiting_.store(false, std::memory_order_relaxed);
+  }
+
+  return consumeCommittedRecords(visitor, max_batch_size) > 0U;
+}
+
+bool equinox::ByteRingLogQueue::dequeue(std::vector<std::string>& out, size_t max_batch_size, uint32_t timeout_ms) {
+  return consume([&out](std::string_view logRecord) { out.emplace_back(logRecord); }, max_batch_size, timeout_ms);
+}
+
+void equinox::ByteRingLogQueue::stop() {
+  std::unique_lock<std::mutex> lock(mWorkerMutex_);
+  mStopRequested_.store(true, std::memory_order_release);
+  lock.unlock();
+  mWorkerConditionVariable_.notify_all();
+}
+
+void equinox::ByteRingLogQueue::setOverflowPolicy(overflow::POLICY policy, uint32_t block_timeout_ms, const LogRecordVisitor& /*dropped_record_visitor*/) {
+  mBlockTimeoutMs_.store(block_timeout_ms, std::memory_order_relaxed);
+  mOverflowPolicy_.store(policy, std::memory_order_relaxed);
+}
+
+size_t equinox::ByteRingLogQueue::getCapacity() const {
+  return mCapacity_;
+}
+
+bool equinox::ByteRingLogQueue::isBackedByHugePages() const {
+  return mBackedByHugePages_;
+}
+
+uint64_t equinox::ByteRingLogQueue::getDroppedMessagesCount() const {
+  return mDroppedMessagesCount_.load(std::memory_order_relaxed);
+}
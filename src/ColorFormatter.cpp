@@ -71,25 +71,8 @@ std::string_view ColorFormatter::getColorForLevel(level::LOG_LEVEL logLevel) {
   }
 }
 
-level::LOG_LEVEL ColorFormatter::extractLevelFromMessage(const std::string& message) {
-  if (message.find("[TRACE]") != std::string::npos) return level::LOG_LEVEL::trace;
-  if (message.find("[DEBUG]") != std::string::npos) return level::LOG_LEVEL::debug;
-  if (message.find("[INFO]") != std::string::npos) return level::LOG_LEVEL::info;
-  if (message.find("[WARNING]") != std::string::npos) return level::LOG_LEVEL::warning;
-  if (message.find("[ERROR]") != std::string::npos) return level::LOG_LEVEL::error;
-  if (message.find("[CRITICAL]") != std::string::npos) return level::LOG_LEVEL::critical;
-
-  // Default to info if not found
-  return level::LOG_LEVEL::info;
-}
-
-std::string ColorFormatter::applyConsoleColors(const std::string& message, std::string_view color) {
-  // If color is empty (default), return message as-is
-  if (color.empty()) {
-    return message;
-  }
-
-  return std::string(color) + message + std::string(kColorReset);
+std::string_view ColorFormatter::getColorReset() {
+  return kColorReset;
 }
 
 } /*namespace equinox*/
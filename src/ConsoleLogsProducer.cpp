@@ -37,30 +37,90 @@
  *
  */
 
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 #include <string_view>
 
 #include "ColorFormatter.h"
 #include "ConsoleLogsProducer.h"
 
+namespace {
+/* Buffered bytes that are written without waiting for the end of the batch */
+static constexpr std::size_t kMaxPendingBytes = 64U * 1024U;
+static constexpr std::int64_t kNanosecondsPerMillisecond = 1000000;
+}  // namespace
+
 equinox::ConsoleLogsProducer::ConsoleLogsProducer(std::shared_ptr<ITimestampProducer> timestampProducer)
-    : ConsoleLogsProducer(timestampProducer, std::make_shared<ColorFormatter>()) {}
+    : ConsoleLogsProducer(timestampProducer, std::make_shared<ColorFormatter>(), STDOUT_FILENO) {}
 
-equinox::ConsoleLogsProducer::ConsoleLogsProducer(std::shared_ptr<ITimestampProducer> timestampProducer, std::shared_ptr<IColorFormatter> colorFormatter)
-    : mTimestampProducer_{timestampProducer}, mColorFormatter_{colorFormatter} {}
+equinox::ConsoleLogsProducer::ConsoleLogsProducer(std::shared_ptr<ITimestampProducer> timestampProducer, std::shared_ptr<IColorFormatter> colorFormatter,
+                                                  int outputFd)
+    : mTimestampProducer_{timestampProducer},
+      mColorFormatter_{colorFormatter},
+      mLogLineTemplates_{},
+      mOutputFd_{outputFd},
+      mFlushIntervalNs_{static_cast<std::int64_t>(LoggerOptions{}.consoleFlushIntervalMs) * kNanosecondsPerMillisecond},
+      mPendingLines_{},
+      mPendingSinceNs_{0} {
+    mLogLineTemplates_.render("", mColorFormatter_.get());
+    mPendingLines_.reserve(kMaxPendingBytes);
+}
 
-void equinox::ConsoleLogsProducer::logMessage(const std::string& messageToLog) {
-    thread_local std::string buffer;
-    buffer.clear();
+equinox::ConsoleLogsProducer::~ConsoleLogsProducer() {
+    writePendingLines();
+}
 
-    level::LOG_LEVEL level = mColorFormatter_->extractLevelFromMessage(messageToLog);
-    std::string_view color = mColorFormatter_->getColorForLevel(level);
+void equinox::ConsoleLogsProducer::setLogPrefix(const std::string& logPrefix) {
+    mLogLineTemplates_.render(logPrefix, mColorFormatter_.get());
+}
 
-    std::string coloredMessage = mColorFormatter_->applyConsoleColors(messageToLog, color);
-    buffer = mTimestampProducer_->getTimestamp() + mTimestampProducer_->getTimestampInUs() + coloredMessage;
-    std::cout << buffer << std::endl;
+void equinox::ConsoleLogsProducer::setFlushIntervalMs(std::uint32_t flushIntervalMs) {
+    mFlushIntervalNs_ = static_cast<std::int64_t>(flushIntervalMs) * kNanosecondsPerMillisecond;
+}
+
+void equinox::ConsoleLogsProducer::logMessage(const std::string& messageToLog, const LogRecordMetadata& metadata) {
+    if (mPendingLines_.empty()) {
+        mPendingSinceNs_ = readMonotonicNs();
+    }
+
+    char timestamp[kMaxTimestampLength];
+    mPendingLines_.append(timestamp, mTimestampProducer_->formatTimestamp(metadata.timestampNs, timestamp));
+    mPendingLines_.append(mLogLineTemplates_.getHeader(metadata.level));
+    mPendingLines_.append(messageToLog);
+    mPendingLines_.append(mLogLineTemplates_.getTrailer(metadata.level));
+    mPendingLines_.push_back('\n');
+
+    if (mPendingLines_.size() >= kMaxPendingBytes || readMonotonicNs() - mPendingSinceNs_ >= mFlushIntervalNs_) {
+        writePendingLines();
+    }
 }
 
 void equinox::ConsoleLogsProducer::flush() {
-    std::cout.flush();
+    writePendingLines();
+}
+
+void equinox::ConsoleLogsProducer::writePendingLines() {
+    std::size_t writtenBytes = 0U;
+    while (writtenBytes < mPendingLines_.size()) {
+        const ssize_t result = ::write(mOutputFd_, mPendingLines_.data() + writtenBytes, mPendingLines_.size() - writtenBytes);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "[EquinoxLogger] Failed to write to the console: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        writtenBytes += static_cast<std::size_t>(result);
+    }
+    mPendingLines_.clear();
+}
+
+std::int64_t equinox::ConsoleLogsProducer::readMonotonicNs() const {
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    return static_cast<std::int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
 }
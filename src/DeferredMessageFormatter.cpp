@@ -0,0 +1,374 @@
+/*
+ * DeferredMessageFormatter.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "DeferredMessageFormatter.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <type_traits>
+
+namespace equinox {
+
+namespace {
+static constexpr std::size_t kMaxMessageSize = 4096U;
+static constexpr std::size_t kMaxConversionSpecSize = 40U;
+static constexpr std::string_view kFlagCharacters = "-+ #0'";
+static constexpr std::string_view kLengthModifierCharacters = "hlLqjzt";
+static constexpr const char* kNullString = "(null)";
+static constexpr const char* kInvalidArgument = "(invalid)";
+
+struct Argument {
+    deferred::ARGUMENT_TYPE type;
+    std::int64_t signedValue;
+    std::uint64_t unsignedValue;
+    double floatingValue;
+    long double longFloatingValue;
+    std::string_view stringValue;
+};
+
+class ArgumentReader {
+   public:
+    explicit ArgumentReader(std::string_view encodedArguments) : mEncodedArguments_{encodedArguments}, mOffset_{0U}, mMalformed_{false} {}
+
+    bool next(Argument& argument) {
+        if (mOffset_ >= mEncodedArguments_.size()) {
+            return false;
+        }
+
+        argument = Argument{};
+        argument.type = static_cast<deferred::ARGUMENT_TYPE>(mEncodedArguments_[mOffset_++]);
+        switch (argument.type) {
+            case deferred::ARGUMENT_TYPE::signed_integer:
+                return read(argument.signedValue);
+            case deferred::ARGUMENT_TYPE::unsigned_integer:
+                return read(argument.unsignedValue);
+            case deferred::ARGUMENT_TYPE::pointer:
+                return read(argument.unsignedValue);
+            case deferred::ARGUMENT_TYPE::floating:
+                return read(argument.floatingValue);
+            case deferred::ARGUMENT_TYPE::long_floating:
+                return read(argument.longFloatingValue);
+            case deferred::ARGUMENT_TYPE::null_string:
+                return true;
+            case deferred::ARGUMENT_TYPE::string: {
+                std::uint32_t stringSize = 0U;
+                if (!read(stringSize) || (mEncodedArguments_.size() - mOffset_) < stringSize) {
+                    return setMalformed();
+                }
+                argument.stringValue = mEncodedArguments_.substr(mOffset_, stringSize);
+                mOffset_ += stringSize;
+                return true;
+            }
+        }
+
+        return setMalformed();
+    }
+
+    bool isMalformed() const {
+        return mMalformed_;
+    }
+
+   private:
+    template <typename T>
+    bool read(T& value) {
+        if ((mEncodedArguments_.size() - mOffset_) < sizeof(T)) {
+            return setMalformed();
+        }
+        std::memcpy(&value, mEncodedArguments_.data() + mOffset_, sizeof(T));
+        mOffset_ += sizeof(T);
+        return true;
+    }
+
+    bool setMalformed() {
+        mMalformed_ = true;
+        mOffset_ = mEncodedArguments_.size();
+        return false;
+    }
+
+    std::string_view mEncodedArguments_;
+    std::size_t mOffset_;
+    bool mMalformed_;
+};
+
+long long asLongLong(const Argument& argument) {
+    switch (argument.type) {
+        case deferred::ARGUMENT_TYPE::signed_integer:
+            return static_cast<long long>(argument.signedValue);
+        case deferred::ARGUMENT_TYPE::unsigned_integer:
+        case deferred::ARGUMENT_TYPE::pointer:
+            return static_cast<long long>(argument.unsignedValue);
+        case deferred::ARGUMENT_TYPE::floating:
+            return static_cast<long long>(argument.floatingValue);
+        case deferred::ARGUMENT_TYPE::long_floating:
+            return static_cast<long long>(argument.longFloatingValue);
+        default:
+            return 0;
+    }
+}
+
+long double asLongDouble(const Argument& argument) {
+    switch (argument.type) {
+        case deferred::ARGUMENT_TYPE::floating:
+            return static_cast<long double>(argument.floatingValue);
+        case deferred::ARGUMENT_TYPE::long_floating:
+            return argument.longFloatingValue;
+        case deferred::ARGUMENT_TYPE::unsigned_integer:
+            return static_cast<long double>(argument.unsignedValue);
+        default:
+            return static_cast<long double>(asLongLong(argument));
+    }
+}
+
+template <typename T>
+void appendConversion(std::string& output, const char* conversionSpec, const int* starValues, std::size_t starCount, T value) {
+    char buffer[kMaxMessageSize];
+    int written = 0;
+
+    switch (starCount) {
+        case 0:
+            written = std::snprintf(buffer, sizeof(buffer), conversionSpec, value);
+            break;
+        case 1:
+            written = std::snprintf(buffer, sizeof(buffer), conversionSpec, starValues[0], value);
+            break;
+        default:
+            written = std::snprintf(buffer, sizeof(buffer), conversionSpec, starValues[0], starValues[1], value);
+            break;
+    }
+
+    if (written > 0) {
+        output.append(buffer, std::min(static_cast<std::size_t>(written), sizeof(buffer) - 1U));
+    }
+}
+/* printf reads the integer with the width its length modifier names, the captured 64-bit value is cut to that
+ * width the same way; without a modifier, and with h and hh, printf reads an int and narrows it itself */
+void appendIntegerConversion(std::string& output, char* conversionSpec, std::size_t conversionSpecSize, const int* starValues, std::size_t starCount,
+                             std::string_view lengthModifier, char conversion, long long value) {
+    conversionSpecSize += lengthModifier.copy(conversionSpec + conversionSpecSize, lengthModifier.size());
+    conversionSpec[conversionSpecSize++] = conversion;
+    conversionSpec[conversionSpecSize] = '\0';
+
+    const bool isSigned = (conversion == 'd') || (conversion == 'i');
+    if (lengthModifier == "l") {
+        isSigned ? appendConversion(output, conversionSpec, starValues, starCount, static_cast<long>(value))
+                 : appendConversion(output, conversionSpec, starValues, starCount, static_cast<unsigned long>(value));
+    } else if (lengthModifier == "ll" || lengthModifier == "q" || lengthModifier == "L") {
+        isSigned ? appendConversion(output, conversionSpec, starValues, starCount, value)
+                 : appendConversion(output, conversionSpec, starValues, starCount, static_cast<unsigned long long>(value));
+    } else if (lengthModifier == "j") {
+        isSigned ? appendConversion(output, conversionSpec, starValues, starCount, static_cast<std::intmax_t>(value))
+                 : appendConversion(output, conversionSpec, starValues, starCount, static_cast<std::uintmax_t>(value));
+    } else if (lengthModifier == "z") {
+        isSigned ? appendConversion(output, conversionSpec, starValues, starCount, static_cast<std::make_signed_t<std::size_t>>(value))
+                 : appendConversion(output, conversionSpec, starValues, starCount, static_cast<std::size_t>(value));
+    } else if (lengthModifier == "t") {
+        isSigned ? appendConversion(output, conversionSpec, starValues, starCount, static_cast<std::ptrdiff_t>(value))
+                 : appendConversion(output, conversionSpec, starValues, starCount, static_cast<std::make_unsigned_t<std::ptrdiff_t>>(value));
+    } else {
+        isSigned ? appendConversion(output, conversionSpec, starValues, starCount, static_cast<int>(value))
+                 : appendConversion(output, conversionSpec, starValues, starCount, static_cast<unsigned int>(value));
+    }
+}
+}  // namespace
+
+bool DeferredMessageFormatter::format(std::string_view encodedMessage, std::string& output) {
+    std::uint32_t formatSize = 0U;
+    if (encodedMessage.size() < sizeof(formatSize)) {
+        return false;
+    }
+    std::memcpy(&formatSize, encodedMessage.data(), sizeof(formatSize));
+    if ((encodedMessage.size() - sizeof(formatSize)) < formatSize) {
+        return false;
+    }
+
+    const std::string_view format = encodedMessage.substr(sizeof(formatSize), formatSize);
+    ArgumentReader argumentReader(encodedMessage.substr(sizeof(formatSize) + formatSize));
+    const std::size_t outputLimit = output.size() + kMaxMessageSize - 1U;
+
+    std::size_t position = 0U;
+    while (position < format.size()) {
+        const std::size_t percent = format.find('%', position);
+        if (percent == std::string_view::npos) {
+            output.append(format.substr(position));
+            break;
+        }
+
+        output.append(format.substr(position, percent - position));
+        std::size_t cursor = percent + 1U;
+
+        if (cursor < format.size() && format[cursor] == '%') {
+            output.push_back('%');
+            position = cursor + 1U;
+            continue;
+        }
+
+        char conversionSpec[kMaxConversionSpecSize];
+        std::size_t conversionSpecSize = 0U;
+        int starValues[2] = {0, 0};
+        std::size_t starCount = 0U;
+        bool argumentsMissing = false;
+        Argument argument{};
+
+        conversionSpec[conversionSpecSize++] = '%';
+        while (cursor < format.size() && kFlagCharacters.find(format[cursor]) != std::string_view::npos) {
+            conversionSpec[conversionSpecSize++] = format[cursor++];
+            if (conversionSpecSize >= kMaxConversionSpecSize - 8U) {
+                break;
+            }
+        }
+
+        for (int field = 0; field < 2 && cursor < format.size(); ++field) {
+            if (field == 1) {
+                if (format[cursor] != '.') {
+                    break;
+                }
+                conversionSpec[conversionSpecSize++] = format[cursor++];
+            }
+
+            if (cursor < format.size() && format[cursor] == '*') {
+                conversionSpec[conversionSpecSize++] = format[cursor++];
+                if (argumentReader.next(argument)) {
+                    starValues[starCount++] = static_cast<int>(asLongLong(argument));
+                } else {
+                    argumentsMissing = true;
+                }
+                continue;
+            }
+
+            while (cursor < format.size() && format[cursor] >= '0' && format[cursor] <= '9' && conversionSpecSize < kMaxConversionSpecSize - 8U) {
+                conversionSpec[conversionSpecSize++] = format[cursor++];
+            }
+        }
+
+        const std::size_t lengthModifierStart = cursor;
+        while (cursor < format.size() && kLengthModifierCharacters.find(format[cursor]) != std::string_view::npos && cursor - lengthModifierStart < 2U) {
+            ++cursor;
+        }
+        const std::string_view lengthModifier = format.substr(lengthModifierStart, cursor - lengthModifierStart);
+
+        if (cursor >= format.size()) {
+            output.append(format.substr(percent));
+            break;
+        }
+
+        const char conversion = format[cursor++];
+        position = cursor;
+
+        if (argumentsMissing || !argumentReader.next(argument)) {
+            output.append(format.substr(percent, cursor - percent));
+            continue;
+        }
+
+        switch (conversion) {
+            case 'd':
+            case 'i':
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+                appendIntegerConversion(output, conversionSpec, conversionSpecSize, starValues, starCount, lengthModifier, conversion, asLongLong(argument));
+                break;
+
+            case 'c':
+                conversionSpec[conversionSpecSize++] = conversion;
+                conversionSpec[conversionSpecSize] = '\0';
+                appendConversion(output, conversionSpec, starValues, starCount, static_cast<int>(asLongLong(argument)));
+                break;
+
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                if (argument.type == deferred::ARGUMENT_TYPE::long_floating) {
+                    conversionSpec[conversionSpecSize++] = 'L';
+                    conversionSpec[conversionSpecSize++] = conversion;
+                    conversionSpec[conversionSpecSize] = '\0';
+                    appendConversion(output, conversionSpec, starValues, starCount, asLongDouble(argument));
+                } else {
+                    conversionSpec[conversionSpecSize++] = conversion;
+                    conversionSpec[conversionSpecSize] = '\0';
+                    appendConversion(output, conversionSpec, starValues, starCount, static_cast<double>(asLongDouble(argument)));
+                }
+                break;
+
+            case 's':
+                conversionSpec[conversionSpecSize++] = conversion;
+                conversionSpec[conversionSpecSize] = '\0';
+                if (argument.type == deferred::ARGUMENT_TYPE::string) {
+                    mStringArgument_.assign(argument.stringValue);
+                    appendConversion(output, conversionSpec, starValues, starCount, mStringArgument_.c_str());
+                } else if (argument.type == deferred::ARGUMENT_TYPE::null_string) {
+                    appendConversion(output, conversionSpec, starValues, starCount, kNullString);
+                } else {
+                    output.append(kInvalidArgument);
+                }
+                break;
+
+            case 'p':
+                conversionSpec[conversionSpecSize++] = conversion;
+                conversionSpec[conversionSpecSize] = '\0';
+                appendConversion(output, conversionSpec, starValues, starCount,
+                                 reinterpret_cast<void*>(static_cast<std::uintptr_t>(asLongLong(argument))));
+                break;
+
+            case 'n':
+                /* Writing back through captured pointers is not supported */
+                break;
+
+            default:
+                output.append(format.substr(percent, cursor - percent));
+                break;
+        }
+    }
+
+    if (output.size() > outputLimit) {
+        output.resize(outputLimit);
+    }
+
+    return !argumentReader.isMalformed();
+}
+
+} /*namespace equinox*/
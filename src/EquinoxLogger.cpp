@@ -44,6 +44,11 @@ bool equinox::setup(equinox::level::LOG_LEVEL logLevel, const std::string& logPr
   return equinox::EquinoxLoggerEngine::getInstance().setup(logLevel, logPrefix, logsOutputSink, logFileName, maxLogFileSizeBytes, maxLogFiles);
 }
 
+bool equinox::setup(equinox::level::LOG_LEVEL logLevel, const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink,
+                    const equinox::LoggerOptions& options) {
+  return equinox::EquinoxLoggerEngine::getInstance().setup(logLevel, logPrefix, logsOutputSink, options);
+}
+
 void equinox::changeLevel(equinox::level::LOG_LEVEL logLevel) {
   equinox::EquinoxLoggerEngine::getInstance().changeLevel(logLevel);
 }
@@ -52,6 +57,18 @@ bool equinox::changeLogsOutputSink(logs_output::SINK logsOutputSink) {
   return equinox::EquinoxLoggerEngine::getInstance().changeLogsOutputSink(logsOutputSink);
 }
 
+void equinox::changeFormattingMode(formatting::MODE formattingMode) {
+  equinox::EquinoxLoggerEngine::getInstance().changeFormattingMode(formattingMode);
+}
+
 void equinox::flush() {
   equinox::EquinoxLoggerEngine::getInstance().flush();
 }
+
+std::uint64_t equinox::getDroppedMessagesCount(level::LOG_LEVEL msgLevel) {
+  return equinox::EquinoxLoggerEngine::getInstance().getDroppedMessagesCount(msgLevel);
+}
+
+equinox::FileWriteStats equinox::getFileWriteStats() {
+  return equinox::EquinoxLoggerEngine::getInstance().getFileWriteStats();
+}
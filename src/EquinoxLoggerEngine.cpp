@@ -40,10 +40,17 @@
 #include "EquinoxLoggerEngine.h"
 #include "EquinoxLoggerEngineImpl.h"
 
-equinox::EquinoxLoggerEngine::EquinoxLoggerEngine() : mEquinoxLoggerEngineImpl_{std::make_unique<EquinoxLoggerEngineImpl>()} {}
+equinox::EquinoxLoggerEngine::EquinoxLoggerEngine()
+    : mEquinoxLoggerEngineImpl_{std::make_unique<EquinoxLoggerEngineImpl>()},
+      mEngineMutex_{},
+      mFormattingMode_{formatting::MODE::immediate},
+      mLogLevel_{level::LOG_LEVEL::trace} {}
 
 equinox::EquinoxLoggerEngine::EquinoxLoggerEngine(std::unique_ptr<IEquinoxLoggerEngineImpl> mEquinoxLoggerEngineImpl)
-    : mEquinoxLoggerEngineImpl_{std::move(mEquinoxLoggerEngineImpl)} {}
+    : mEquinoxLoggerEngineImpl_{std::move(mEquinoxLoggerEngineImpl)},
+      mEngineMutex_{},
+      mFormattingMode_{formatting::MODE::immediate},
+      mLogLevel_{level::LOG_LEVEL::trace} {}
 
 equinox::EquinoxLoggerEngine& equinox::EquinoxLoggerEngine::getInstance() {
     static EquinoxLoggerEngine sEquinoxLoggerEngine;
@@ -53,19 +60,40 @@ equinox::EquinoxLoggerEngine& equinox::EquinoxLoggerEngine::getInstance() {
 bool equinox::EquinoxLoggerEngine::setup(equinox::level::LOG_LEVEL logLevel, const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink,
                                          const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) {
     std::lock_guard<std::mutex> lock(mEngineMutex_);
-    return mEquinoxLoggerEngineImpl_->setup(logLevel, logPrefix, logsOutputSink, logFileName, maxLogFileSizeBytes, maxLogFiles);
+    mLogLevel_.store(logLevel, std::memory_order_relaxed);
+    return mEquinoxLoggerEngineImpl_->setup(logPrefix, logsOutputSink, logFileName, maxLogFileSizeBytes, maxLogFiles);
+}
+
+bool equinox::EquinoxLoggerEngine::setup(equinox::level::LOG_LEVEL logLevel, const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink,
+                                         const LoggerOptions& options) {
+    std::lock_guard<std::mutex> lock(mEngineMutex_);
+    mLogLevel_.store(logLevel, std::memory_order_relaxed);
+    return mEquinoxLoggerEngineImpl_->setup(logPrefix, logsOutputSink, options);
 }
 
 void equinox::EquinoxLoggerEngine::changeLevel(level::LOG_LEVEL logLevel) {
     std::lock_guard<std::mutex> lock(mEngineMutex_);
-    mEquinoxLoggerEngineImpl_->changeLevel(logLevel);
+    mLogLevel_.store(logLevel, std::memory_order_relaxed);
 }
 
 bool equinox::EquinoxLoggerEngine::changeLogsOutputSink(logs_output::SINK logsOutputSink) {
     std::lock_guard<std::mutex> lock(mEngineMutex_);
     return mEquinoxLoggerEngineImpl_->changeLogsOutputSink(logsOutputSink);
 }
+
+void equinox::EquinoxLoggerEngine::changeFormattingMode(formatting::MODE formattingMode) {
+    mFormattingMode_.store(formattingMode, std::memory_order_relaxed);
+}
+
 void equinox::EquinoxLoggerEngine::flush() {
     std::lock_guard<std::mutex> lock(mEngineMutex_);
     mEquinoxLoggerEngineImpl_->flush();
+}
+
+std::uint64_t equinox::EquinoxLoggerEngine::getDroppedMessagesCount(level::LOG_LEVEL msgLevel) {
+    return mEquinoxLoggerEngineImpl_->getDroppedMessagesCount(msgLevel);
+}
+
+equinox::FileWriteStats equinox::EquinoxLoggerEngine::getFileWriteStats() {
+    return mEquinoxLoggerEngineImpl_->getFileWriteStats();
 }
\ No newline at end of file
@@ -37,11 +37,13 @@
  *
  */
 
+#include <cstring>
+#include <iostream>
+
 #include "EquinoxLoggerEngineImpl.h"
 
 equinox::EquinoxLoggerEngineImpl::EquinoxLoggerEngineImpl()
     : mLogPrefix_{},
-      mLogLevel_{},
       mLogFileName_{},
       mMaxLogFileSizeBytes_{kDefaultMaxLogFileSizeBytes},
       mMaxLogFiles_{kDefaultMaxLogFiles},
@@ -53,7 +55,6 @@ equinox::EquinoxLoggerEngineImpl::EquinoxLoggerEngineImpl(std::shared_ptr<ITimes
                                                           std::shared_ptr<IFileLogsProducer> mFileLogsProducer,
                                                           std::unique_ptr<IAsyncLogQueueEngine> mAsyncLogQueueEngine)
     : mLogPrefix_{},
-      mLogLevel_{},
       mLogFileName_{},
       mMaxLogFileSizeBytes_{kDefaultMaxLogFileSizeBytes},
       mMaxLogFiles_{kDefaultMaxLogFiles},
@@ -65,10 +66,6 @@ const std::string& equinox::EquinoxLoggerEngineImpl::getLogPrefix() const {
     return mLogPrefix_;
 }
 
-equinox::level::LOG_LEVEL equinox::EquinoxLoggerEngineImpl::getLogLevel() const {
-    return mLogLevel_;
-}
-
 const std::string& equinox::EquinoxLoggerEngineImpl::getLogFileName() const {
     return mLogFileName_;
 }
@@ -81,60 +78,45 @@ std::size_t equinox::EquinoxLoggerEngineImpl::getMaxLogFiles() const {
     return mMaxLogFiles_;
 }
 
-void equinox::EquinoxLoggerEngineImpl::logMessage(level::LOG_LEVEL msgLevel, const std::string& formatedOutputMessage) {
-    if ((msgLevel != level::LOG_LEVEL::off) and (msgLevel >= mLogLevel_)) {
-        thread_local std::string outputMessage;
-        outputMessage.clear();
-
-        switch (msgLevel) {
-            case level::LOG_LEVEL::critical:
-                outputMessage = mLogPrefix_ + std::string("[CRITICAL] ") + formatedOutputMessage;
-                break;
-
-            case level::LOG_LEVEL::debug:
-                outputMessage = mLogPrefix_ + std::string("[DEBUG] ") + formatedOutputMessage;
-                break;
-
-            case level::LOG_LEVEL::error:
-                outputMessage = mLogPrefix_ + std::string("[ERROR] ") + formatedOutputMessage;
-                break;
-
-            case level::LOG_LEVEL::info:
-                outputMessage = mLogPrefix_ + std::string("[INFO] ") + formatedOutputMessage;
-                break;
-
-            case level::LOG_LEVEL::trace:
-                outputMessage = mLogPrefix_ + std::string("[TRACE] ") + formatedOutputMessage;
-                break;
+bool equinox::EquinoxLoggerEngineImpl::logMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, std::string_view formatedOutputMessage, bool nonBlocking) {
+    /* The engine checked the level before formatting, off is not a level of a message */
+    if (msgLevel == level::LOG_LEVEL::off) {
+        return true;
+    }
+    /* Only the message is queued, the sinks add the prefix and the level tag from their line templates */
+    mAsyncLogQueueEngine_->startWorkerIfNeeded();
+    return mAsyncLogQueueEngine_->processLogMessage(msgLevel, callSiteId, formatedOutputMessage, nonBlocking);
+}
 
-            case level::LOG_LEVEL::warning:
-                outputMessage = mLogPrefix_ + std::string("[WARNING] ") + formatedOutputMessage;
-                break;
+bool equinox::EquinoxLoggerEngineImpl::logDeferredMessage(level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, const std::string& encodedMessage,
+                                                          bool nonBlocking) {
+    if (msgLevel == level::LOG_LEVEL::off) {
+        return true;
+    }
+    mAsyncLogQueueEngine_->startWorkerIfNeeded();
+    return mAsyncLogQueueEngine_->processDeferredLogMessage(msgLevel, callSiteId, encodedMessage, nonBlocking);
+}
 
-            case level::LOG_LEVEL::off:
-                // Should not reach here due to the check above, but included for completeness
-                break;
-        }
+std::uint64_t equinox::EquinoxLoggerEngineImpl::getDroppedMessagesCount(level::LOG_LEVEL msgLevel) {
+    return mAsyncLogQueueEngine_->getDroppedMessagesCount(msgLevel);
+}
 
-        mAsyncLogQueueEngine_->startWorkerIfNeeded();
-        mAsyncLogQueueEngine_->processLogMessage(outputMessage);
-    }
+equinox::FileWriteStats equinox::EquinoxLoggerEngineImpl::getFileWriteStats() {
+    return mFileLogsProducer_->getWriteStats();
 }
 
-bool equinox::EquinoxLoggerEngineImpl::setup(level::LOG_LEVEL logLevel, const std::string& logPrefix, logs_output::SINK logsOutputSink,
-                                             const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) {
-    mLogLevel_ = logLevel;
-    mLogPrefix_ = std::string("[" + logPrefix + "]");
+bool equinox::EquinoxLoggerEngineImpl::setup(const std::string& logPrefix, logs_output::SINK logsOutputSink, const std::string& logFileName,
+                                             std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) {
+    mLogPrefix_ = "[" + logPrefix + "]";
+    mAsyncLogQueueEngine_->setLogPrefix(mLogPrefix_);
     mAsyncLogQueueEngine_->setLogsOutputSink(logsOutputSink);
     mLogFileName_ = logFileName;
     mMaxLogFileSizeBytes_ = maxLogFileSizeBytes;
     mMaxLogFiles_ = maxLogFiles;
 
     if (equinox::logs_output::SINK::file == logsOutputSink or equinox::logs_output::SINK::console_and_file == logsOutputSink) {
-        try {
-            mFileLogsProducer_->setupFile(mLogFileName_, mMaxLogFileSizeBytes_, mMaxLogFiles_);
-        } catch (const std::exception& ex) {
-            std::cerr << "[EquinoxLogger] Failed to setup log file: " << ex.what() << std::endl;
+        if (const int error = mFileLogsProducer_->setupFile(mLogFileName_, mMaxLogFileSizeBytes_, mMaxLogFiles_); error != 0) {
+            std::cerr << "[EquinoxLogger] Failed to setup log file: " << std::strerror(error) << std::endl;
             return false;
         }
     }
@@ -143,18 +125,22 @@ bool equinox::EquinoxLoggerEngineImpl::setup(level::LOG_LEVEL logLevel, const st
     return true;
 }
 
-void equinox::EquinoxLoggerEngineImpl::changeLevel(level::LOG_LEVEL logLevel) {
-    mLogLevel_ = logLevel;
+bool equinox::EquinoxLoggerEngineImpl::setup(const std::string& logPrefix, logs_output::SINK logsOutputSink, const LoggerOptions& options) {
+    mAsyncLogQueueEngine_->configureQueue(options);
+    mFileLogsProducer_->setIoBackend(options.fileIoBackend);
+    mFileLogsProducer_->setDurability(options.fileDurability, options.fileSyncIntervalMs, options.fileSyncBytes);
+    mFileLogsProducer_->setPageCacheMode(options.filePageCache);
+    mFileLogsProducer_->setCompression(options.fileCompression);
+    mFileLogsProducer_->setRotationPeriod(options.fileRotationPeriod, options.timestampZone);
+    return setup(logPrefix, logsOutputSink, options.logFileName, options.maxLogFileSizeBytes, options.maxLogFiles);
 }
 
 bool equinox::EquinoxLoggerEngineImpl::changeLogsOutputSink(logs_output::SINK logsOutputSink) {
     mAsyncLogQueueEngine_->setLogsOutputSink(logsOutputSink);
 
     if (equinox::logs_output::SINK::file == logsOutputSink or equinox::logs_output::SINK::console_and_file == logsOutputSink) {
-        try {
-            mFileLogsProducer_->setupFile(mLogFileName_, mMaxLogFileSizeBytes_, mMaxLogFiles_);
-        } catch (const std::exception& ex) {
-            std::cerr << "[EquinoxLogger] Failed to switch to file output: " << ex.what() << std::endl;
+        if (const int error = mFileLogsProducer_->setupFile(mLogFileName_, mMaxLogFileSizeBytes_, mMaxLogFiles_); error != 0) {
+            std::cerr << "[EquinoxLogger] Failed to switch to file output: " << std::strerror(error) << std::endl;
             return false;
         }
     }
@@ -0,0 +1,129 @@
+/*
+ * FdLogWriter.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include "FdLogWriter.h"
+
+equinox::FdLogWriter::FdLogWriter() : mFd_{-1}, mSize_{0U} {}
+
+equinox::FdLogWriter::~FdLogWriter() {
+    close();
+}
+
+int equinox::FdLogWriter::open(const std::string& fileName, bool truncate) {
+    /* Every write lands at the end of the file, also when another process appends to it */
+    const int fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+    if (fd < 0) {
+        return errno;
+    }
+
+    struct stat fileStat {};
+    if (::fstat(fd, &fileStat) != 0) {
+        const int error = errno;  // LCOV_EXCL_LINE
+        ::close(fd);  // LCOV_EXCL_LINE
+        return error;  // LCOV_EXCL_LINE
+    }
+
+    close();
+    mFd_ = fd;
+    mSize_ = static_cast<std::size_t>(fileStat.st_size);
+    return 0;
+}
+
+bool equinox::FdLogWriter::isOpen() const {
+    return mFd_ >= 0;
+}
+
+int equinox::FdLogWriter::write(const char* data, std::size_t size) {
+    if (mFd_ < 0) {
+        return EBADF;
+    }
+
+    while (size > 0U) {
+        const ssize_t written = writeOnce(data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        if (written == 0) {
+            /* Nothing was written and nothing reported, retrying would spin */
+            return EIO;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+        mSize_ += static_cast<std::size_t>(written);
+    }
+    return 0;
+}
+
+int equinox::FdLogWriter::sync() {
+    if (mFd_ < 0) {
+        return EBADF;
+    }
+    return (fdatasync(mFd_) == 0) ? 0 : errno;
+}
+
+int equinox::FdLogWriter::close() {
+    if (mFd_ < 0) {
+        return 0;
+    }
+
+    const int result = ::close(mFd_);
+    mFd_ = -1;
+    /* On Linux the descriptor is gone after EINTR too, retrying could close someone else's */
+    return (result == 0 or errno == EINTR) ? 0 : errno;
+}
+
+int equinox::FdLogWriter::getFd() const {
+    return mFd_;
+}
+
+std::size_t equinox::FdLogWriter::getSize() const {
+    return mSize_;
+}
+
+ssize_t equinox::FdLogWriter::writeOnce(const char* data, std::size_t size) {
+    return ::write(mFd_, data, size);
+}
@@ -37,150 +37,564 @@
  *
  */
 
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <ctime>
 #include <filesystem>
 #include <iostream>
-#include <stdexcept>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "FileLogsProducer.h"
 
-void equinox::FileLogsProducer::setupFile(const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) {
+namespace {
+/* Buffered bytes that are written without waiting for the end of the batch */
+static constexpr std::size_t kMaxPendingBytes = 256U * 1024U;
+static constexpr std::int64_t kNanosecondsPerMillisecond = 1000000;
+static constexpr std::int64_t kNanosecondsPerSecond = 1000000000;
+static constexpr std::string_view kCompressedExtension = ".gz";
+/* Characters of the 2026-10-17 and 2026-10-17T14 period labels */
+static constexpr std::string_view kSegmentPeriodCharacters = "0123456789-T";
+static constexpr std::size_t kMaxSegmentPeriodLength = 32U;
+
+std::int64_t steadyClockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Matches <prefix>[<period>_]<sequence><extension>, optionally followed by the extension the archiver adds */
+bool parseSegment(std::string_view fileName, std::string_view prefix, std::string_view extension, std::size_t& sequence,
+                  std::string& segmentPeriod) {
+    if (fileName.size() > kCompressedExtension.size() and fileName.substr(fileName.size() - kCompressedExtension.size()) == kCompressedExtension) {
+        fileName.remove_suffix(kCompressedExtension.size());
+    }
+    if (fileName.size() <= prefix.size() + extension.size() or fileName.substr(0U, prefix.size()) != prefix or
+        fileName.substr(fileName.size() - extension.size()) != extension) {
+        return false;
+    }
+
+    std::string_view digits = fileName.substr(prefix.size(), fileName.size() - prefix.size() - extension.size());
+    segmentPeriod.clear();
+    if (const std::size_t separator = digits.rfind('_'); separator != std::string_view::npos) {
+        const std::string_view period = digits.substr(0U, separator);
+        if (period.empty() or period.find_first_not_of(kSegmentPeriodCharacters) != std::string_view::npos) {
+            return false;
+        }
+        segmentPeriod.assign(period);
+        digits.remove_prefix(separator + 1U);
+    }
+    if (digits.empty()) {
+        return false;
+    }
+    /* Sequences are written without leading zeros, another spelling is not a segment */
+    if (digits.front() == '0') {
+        return false;
+    }
+    const auto [parsedUntil, error] = std::from_chars(digits.data(), digits.data() + digits.size(), sequence);
+    return (error == std::errc{}) and (parsedUntil == digits.data() + digits.size());
+}
+}  // namespace
+
+int equinox::FileLogsProducer::setupFile(const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles) {
+    std::lock_guard<std::mutex> lock(mMessageBufferAccessLock_);
     mLogFileName_ = logFileName;
     mMaxLogFileSizeBytes_ = maxLogFileSizeBytes;
     mMaxLogFiles_ = maxLogFiles;
-    mNextRotationIndex_ = 1U;
 
-    if (mFdLogFile_.is_open()) {
-        try {
-            mFdLogFile_.close();
-        } catch (std::ofstream::failure& ex) {  // LCOV_EXCL_LINE
-            std::cerr << "[EquinoxLogger] Exception when closing file: " << ex.what() << std::endl;  // LCOV_EXCL_LINE
-        }  // LCOV_EXCL_LINE
+    if (isLogFileOpen()) {
+        writePendingLines();
+        if (mDurabilityMode_ != file_durability::MODE::os_buffered) {
+            syncLogFile(true);
+        }
+        closeLogFile();
     }
 
-    openLogFileAppend();
-
-    if (!mFdLogFile_.is_open()) {
-        throw std::runtime_error("Failed to open log file: " + mLogFileName_);
+    mSegmentPeriod_.clear();
+    mNextRotationBoundaryNs_ = INT64_MAX;
+    if (mRotationPeriod_ != file_rotation::PERIOD::none and isRotationEnabled()) {
+        mNextRotationBoundaryNs_ = computeSegmentPeriod(getWallClockNs(), mSegmentPeriod_);
+    }
+    recoverSegments();
+    const int error = openLogFileAppend();
+    if (error == 0 and isRotationEnabled()) {
+        linkLogFileToSegment();
     }
+    if (mPageCacheMode_ == file_page_cache::MODE::drop_behind and mMappedLogSegment_.isOpen()) {
+        std::cerr << "[EquinoxLogger] The mmap backend keeps its mapped pages, the page cache is dropped behind rotated files only" << std::endl;
+    }
+    return error;
 }
 
-void equinox::FileLogsProducer::openLogFileAppend() {
-    if (mFdLogFile_.is_open()) {
-        return;
+int equinox::FileLogsProducer::openLogFileAppend() {
+    return openLogFile(false);
+}
+
+int equinox::FileLogsProducer::openLogFileTruncate() {
+    return openLogFile(true);
+}
+
+int equinox::FileLogsProducer::openLogFile(bool truncate) {
+    if (isLogFileOpen()) {
+        return 0;
+    }
+    if (mIoBackend_ == file_io::BACKEND::mmap) {
+        return openMappedLogSegment(truncate);
+    }
+    if (mIoBackend_ == file_io::BACKEND::io_uring) {
+        return openUringLogWriter(truncate);
     }
 
-    mFdLogFile_.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    return openFdLogWriter(truncate);
+}
 
-    try {
-        mFdLogFile_.open(mLogFileName_, std::ofstream::out | std::ofstream::app);
-    } catch (std::ofstream::failure& ex) {
-        std::cerr << "[EquinoxLogger] Failed to open log file: " << mLogFileName_ << " - " << ex.what() << std::endl;
-        mFdLogFile_.clear();
+int equinox::FileLogsProducer::openFdLogWriter(bool truncate) {
+    const std::string segmentFileName = getSegmentFileName();
+    if (const int error = mFdLogWriter_.open(segmentFileName, truncate); error != 0) {
+        std::cerr << "[EquinoxLogger] Failed to open log file: " << segmentFileName << " - " << std::strerror(error) << std::endl;
+        return error;
     }
+    mLogFileSizeBytes_ = mFdLogWriter_.getSize();
+    mUnsyncedBytes_ = 0U;
+    mLastSyncNs_ = steadyClockNs();
+    mPageCacheDropBehind_.reset(mLogFileSizeBytes_);
+    return 0;
 }
 
-void equinox::FileLogsProducer::openLogFileTruncate() {
-    if (mFdLogFile_.is_open()) {
-        return;
+int equinox::FileLogsProducer::openMappedLogSegment(bool truncate) {
+    /* A rotated segment never grows past the size limit by more than one batch */
+    if (!mMappedLogSegment_.open(getSegmentFileName(), isRotationEnabled() ? mMaxLogFileSizeBytes_ : 0U, truncate)) {
+        /* The segment already said what failed */
+        return EIO;
     }
+    mLogFileSizeBytes_ = mMappedLogSegment_.getSize();
+    mUnsyncedBytes_ = 0U;
+    mLastSyncNs_ = steadyClockNs();
+    return 0;
+}
 
-    mFdLogFile_.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+int equinox::FileLogsProducer::openUringLogWriter(bool truncate) {
+    if (!mUringLogWriter_.isAvailable()) {
+        std::cerr << "[EquinoxLogger] io_uring is not available, the file sink falls back to the write backend" << std::endl;
+        mIoBackend_ = file_io::BACKEND::write;
+        return openLogFile(truncate);
+    }
+    if (!mUringLogWriter_.open(getSegmentFileName(), truncate)) {
+        /* The writer already said what failed */
+        return EIO;
+    }
+    mLogFileSizeBytes_ = mUringLogWriter_.getSize();
+    mUnsyncedBytes_ = 0U;
+    mLastSyncNs_ = steadyClockNs();
+    mPageCacheDropBehind_.reset(mLogFileSizeBytes_);
+    return 0;
+}
 
-    try {
-        mFdLogFile_.open(mLogFileName_, std::ofstream::out | std::ofstream::trunc);
-    } catch (std::ofstream::failure& ex) {
-        std::cerr << "[EquinoxLogger] Failed to open log file: " << mLogFileName_ << " - " << ex.what() << std::endl;
-        mFdLogFile_.clear();
+int equinox::FileLogsProducer::openNextSegment() {
+    /* Until it is open the lines keep going to the full segment, a failed open loses none */
+    if (mFdLogWriter_.isOpen()) {
+        return openFdLogWriter(true);
+    }
+    if (mMappedLogSegment_.isOpen()) {
+        return openMappedLogSegment(true);
+    }
+    if (mUringLogWriter_.isOpen()) {
+        return openUringLogWriter(true);
     }
+    return openLogFile(true);
+}
+
+void equinox::FileLogsProducer::closeLogFile() {
+    /* Cuts the preallocated tail off, the rotated file ends with its last line */
+    mMappedLogSegment_.close();
+    /* Waits for the writes in flight, the next file gets the registered file slot */
+    mUringLogWriter_.close();
+    if (const int error = mFdLogWriter_.close(); error != 0) {
+        std::cerr << "[EquinoxLogger] Failed to close log file: " << mLogFileName_ << " - " << std::strerror(error) << std::endl;  // LCOV_EXCL_LINE
+    }
+}
+
+bool equinox::FileLogsProducer::isLogFileOpen() const {
+    return mFdLogWriter_.isOpen() or mMappedLogSegment_.isOpen() or mUringLogWriter_.isOpen();
+}
+
+int equinox::FileLogsProducer::getLogFileFd() const {
+    return mUringLogWriter_.isOpen() ? mUringLogWriter_.getFd() : mFdLogWriter_.getFd();
 }
 
 bool equinox::FileLogsProducer::isRotationEnabled() const {
-    return (mMaxLogFileSizeBytes_ > 0U) && (mMaxLogFiles_ > 0U);
+    return ((mMaxLogFileSizeBytes_ > 0U) or (mRotationPeriod_ != file_rotation::PERIOD::none)) && (mMaxLogFiles_ > 0U);
 }
 
-std::string equinox::FileLogsProducer::buildRotatedFileName(std::size_t index) const {
+std::string equinox::FileLogsProducer::buildSegmentFileName(std::size_t sequence, const std::string& segmentPeriod) const {
     std::filesystem::path basePath(mLogFileName_);
-    std::string rotatedName = basePath.stem().string() + "_" + std::to_string(index) + basePath.extension().string();
-    return (basePath.parent_path() / rotatedName).string();
+    std::string segmentName = basePath.stem().string() + "_";
+    if (!segmentPeriod.empty()) {
+        segmentName += segmentPeriod + "_";
+    }
+    segmentName += std::to_string(sequence) + basePath.extension().string();
+    return (basePath.parent_path() / segmentName).string();
 }
 
-void equinox::FileLogsProducer::rotateIfNeeded() {
+std::string equinox::FileLogsProducer::getSegmentFileName() const {
+    return isRotationEnabled() ? buildSegmentFileName(mSegmentSequence_, mSegmentPeriod_) : mLogFileName_;
+}
+
+std::int64_t equinox::FileLogsProducer::computeSegmentPeriod(std::int64_t timestampNs, std::string& segmentPeriod) const {
+    const std::time_t seconds = static_cast<std::time_t>(timestampNs / kNanosecondsPerSecond);
+    std::tm dateTime{};
+    if (mRotationZone_ == timestamp_format::ZONE::utc) {
+        gmtime_r(&seconds, &dateTime);
+    } else {
+        localtime_r(&seconds, &dateTime);
+    }
+
+    const bool daily = (mRotationPeriod_ == file_rotation::PERIOD::daily);
+    char label[kMaxSegmentPeriodLength];
+    segmentPeriod.assign(label, std::strftime(label, sizeof(label), daily ? "%Y-%m-%d" : "%Y-%m-%dT%H", &dateTime));
+
+    dateTime.tm_sec = 0;
+    dateTime.tm_min = 0;
+    if (daily) {
+        dateTime.tm_hour = 0;
+        ++dateTime.tm_mday;
+    } else {
+        ++dateTime.tm_hour;
+    }
+    /* The next hour or midnight can be on the other side of a DST change, which shifts some zones by half an hour */
+    dateTime.tm_isdst = -1;
+    const std::time_t nextBoundary = (mRotationZone_ == timestamp_format::ZONE::utc) ? timegm(&dateTime) : std::mktime(&dateTime);
+    return static_cast<std::int64_t>(nextBoundary) * kNanosecondsPerSecond;
+}
+
+std::int64_t equinox::FileLogsProducer::getWallClockNs() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void equinox::FileLogsProducer::recoverSegments() {
+    mSegmentSequence_ = 1U;
+    mRotatedSegments_.clear();
     if (!isRotationEnabled()) {
         return;
     }
 
+    const std::filesystem::path basePath(mLogFileName_);
+    const std::filesystem::path directory = basePath.parent_path().empty() ? std::filesystem::path(".") : basePath.parent_path();
+    const std::string prefix = basePath.stem().string() + "_";
+    const std::string extension = basePath.extension().string();
+
+    std::vector<std::pair<std::size_t, std::string>> segments;
     std::error_code errorCode;
-    std::uintmax_t fileSize = std::filesystem::file_size(mLogFileName_, errorCode);
+    for (std::filesystem::directory_iterator entry(directory, errorCode), end; !errorCode and entry != end; entry.increment(errorCode)) {
+        std::size_t sequence = 0U;
+        std::string segmentPeriod;
+        if (parseSegment(entry->path().filename().string(), prefix, extension, sequence, segmentPeriod)) {
+            segments.emplace_back(sequence, std::move(segmentPeriod));
+        }
+    }
     if (errorCode) {
-        std::cerr << "[EquinoxLogger] Failed to check file size: " << errorCode.message() << std::endl;
-        return;
+        std::cerr << "[EquinoxLogger] Failed to look for earlier log files: " << directory.string() << " - " << errorCode.message() << std::endl;
     }
 
-    if (fileSize < mMaxLogFileSizeBytes_) {
+    /* A segment compressed while the archiver was stopped shows up twice */
+    std::sort(segments.begin(), segments.end());
+    migrateLogFile(segments);
+    segments.erase(std::unique(segments.begin(), segments.end()), segments.end());
+    for (const auto& [sequence, segmentPeriod] : segments) {
+        mRotatedSegments_.push_back(buildSegmentFileName(sequence, segmentPeriod));
+    }
+    if (!segments.empty()) {
+        mSegmentSequence_ = segments.back().first + 1U;
+        /* A segment of an earlier period is not continued, its lines would end up under the wrong name */
+        if (segments.back().second == mSegmentPeriod_ and
+            !std::filesystem::exists(mRotatedSegments_.back() + std::string(kCompressedExtension), errorCode)) {
+            mSegmentSequence_ = segments.back().first;
+            mRotatedSegments_.pop_back();
+        }
+    }
+    retireOldSegments();
+}
+
+void equinox::FileLogsProducer::migrateLogFile(std::vector<std::pair<std::size_t, std::string>>& segments) {
+    /* Releases that rotated by renaming wrote to the configured name itself, its lines become the newest segment */
+    std::error_code errorCode;
+    if (!std::filesystem::is_regular_file(std::filesystem::symlink_status(mLogFileName_, errorCode))) {
         return;
     }
 
-    try {
-        mFdLogFile_.close();
-    } catch (std::ofstream::failure& ex) {  // LCOV_EXCL_LINE
-        std::cerr << "[EquinoxLogger] Exception when closing file during rotation: " << ex.what() << std::endl;  // LCOV_EXCL_LINE
-    }  // LCOV_EXCL_LINE
+    const std::size_t sequence = segments.empty() ? 1U : segments.back().first + 1U;
+    const std::string segmentFileName = buildSegmentFileName(sequence, "");
+    std::filesystem::rename(mLogFileName_, segmentFileName, errorCode);
+    if (errorCode) {
+        std::cerr << "[EquinoxLogger] Failed to move log file into its segments: " << mLogFileName_ << " - " << errorCode.message() << std::endl;  // LCOV_EXCL_LINE
+        return;  // LCOV_EXCL_LINE
+    }
+    segments.emplace_back(sequence, "");
+}
 
-    std::string rotatedFileName = buildRotatedFileName(mNextRotationIndex_);
-    std::filesystem::remove(rotatedFileName, errorCode);
-    errorCode.clear();
-    std::filesystem::rename(mLogFileName_, rotatedFileName, errorCode);
+void equinox::FileLogsProducer::linkLogFileToSegment() {
+    const std::filesystem::path logFilePath(mLogFileName_);
+    std::error_code errorCode;
+    const std::filesystem::file_status logFileStatus = std::filesystem::symlink_status(logFilePath, errorCode);
+    if (std::filesystem::exists(logFileStatus) and !std::filesystem::is_symlink(logFileStatus)) {
+        std::cerr << "[EquinoxLogger] Log file is not a link, it is left as it is: " << mLogFileName_ << std::endl;
+        return;
+    }
 
+    /* Relative, the directory can be moved; replaced by rename() so readers never miss the link */
+    const std::filesystem::path temporaryLinkPath(mLogFileName_ + ".link");
+    std::filesystem::remove(temporaryLinkPath, errorCode);
+    std::filesystem::create_symlink(std::filesystem::path(getSegmentFileName()).filename(), temporaryLinkPath, errorCode);
+    if (!errorCode) {
+        std::filesystem::rename(temporaryLinkPath, logFilePath, errorCode);
+    }
     if (errorCode) {
-        std::cerr << "[EquinoxLogger] Failed to rotate log file: " << errorCode.message() << std::endl;
-        openLogFileAppend();
+        std::cerr << "[EquinoxLogger] Failed to link log file to its segment: " << mLogFileName_ << " - " << errorCode.message() << std::endl;  // LCOV_EXCL_LINE
+    }
+}
+
+void equinox::FileLogsProducer::retireOldSegments() {
+    while (mRotatedSegments_.size() > mMaxLogFiles_) {
+        mLogSegmentArchiver_.retire(mRotatedSegments_.front());
+        mRotatedSegments_.pop_front();
+    }
+}
+
+void equinox::FileLogsProducer::rotateIfNeeded() {
+    if (!isRotationEnabled() or !isLogFileOpen()) {
         return;
     }
 
-    if (mMaxLogFiles_ > 0U) {
-        mNextRotationIndex_ = (mNextRotationIndex_ % mMaxLogFiles_) + 1U;
+    if (mMaxLogFileSizeBytes_ == 0U or mLogFileSizeBytes_ < mMaxLogFileSizeBytes_) {
+        return;
+    }
+
+    rotateSegment(mSegmentPeriod_);
+}
+
+void equinox::FileLogsProducer::rotateAtBoundary(std::int64_t timestampNs) {
+    /* A segment filled by these lines is rotated once, into the next period, not first into an empty one of its own */
+    writePendingLines(false);
+
+    std::string nextSegmentPeriod;
+    mNextRotationBoundaryNs_ = computeSegmentPeriod(timestampNs, nextSegmentPeriod);
+    /* The hour repeated when the clocks go back keeps its segment */
+    if (nextSegmentPeriod != mSegmentPeriod_ and isLogFileOpen()) {
+        rotateSegment(nextSegmentPeriod);
+    } else {
+        rotateIfNeeded();
+    }
+}
+
+void equinox::FileLogsProducer::rotateSegment(const std::string& nextSegmentPeriod) {
+    if (mDurabilityMode_ != file_durability::MODE::os_buffered) {
+        syncLogFile(true);
+    }
+
+    const std::string rotatedFileName = getSegmentFileName();
+    const std::string rotatedSegmentPeriod = mSegmentPeriod_;
+    mSegmentPeriod_ = nextSegmentPeriod;
+    ++mSegmentSequence_;
+    if (const int error = openNextSegment(); error != 0) {
+        std::cerr << "[EquinoxLogger] Failed to rotate log file: " << std::strerror(error) << std::endl;
+        --mSegmentSequence_;
+        mSegmentPeriod_ = rotatedSegmentPeriod;
+        /* Does nothing when the full segment is still open */
+        openLogFileAppend();
+        return;
     }
 
-    openLogFileTruncate();
+    mRotatedSegments_.push_back(rotatedFileName);
+    linkLogFileToSegment();
+    mLogSegmentArchiver_.archive(rotatedFileName);
+    retireOldSegments();
+}
+
+void equinox::FileLogsProducer::setLogPrefix(const std::string& logPrefix) {
+    std::lock_guard<std::mutex> lock(mMessageBufferAccessLock_);
+    mLogLineTemplates_.render(logPrefix, nullptr);
+}
+
+void equinox::FileLogsProducer::setDurability(file_durability::MODE durabilityMode, std::uint32_t syncIntervalMs, std::size_t syncBytes) {
+    std::lock_guard<std::mutex> lock(mMessageBufferAccessLock_);
+    mDurabilityMode_ = durabilityMode;
+    mSyncIntervalNs_ = static_cast<std::int64_t>(syncIntervalMs) * kNanosecondsPerMillisecond;
+    mSyncBytes_ = syncBytes;
+}
+
+void equinox::FileLogsProducer::setIoBackend(file_io::BACKEND ioBackend) {
+    std::lock_guard<std::mutex> lock(mMessageBufferAccessLock_);
+    mIoBackend_ = ioBackend;
+}
+
+void equinox::FileLogsProducer::setPageCacheMode(file_page_cache::MODE pageCacheMode) {
+    std::lock_guard<std::mutex> lock(mMessageBufferAccessLock_);
+    mPageCacheMode_ = pageCacheMode;
+    mLogSegmentArchiver_.setDropPageCache(pageCacheMode == file_page_cache::MODE::drop_behind);
+}
+
+void equinox::FileLogsProducer::setCompression(file_compression::MODE compressionMode) {
+    mLogSegmentArchiver_.setCompression(compressionMode);
+}
+
+void equinox::FileLogsProducer::setRotationPeriod(file_rotation::PERIOD rotationPeriod, timestamp_format::ZONE rotationZone) {
+    std::lock_guard<std::mutex> lock(mMessageBufferAccessLock_);
+    mRotationPeriod_ = rotationPeriod;
+    mRotationZone_ = rotationZone;
 }
 
-void equinox::FileLogsProducer::logMessage(const std::string& messageToLog) {
+void equinox::FileLogsProducer::logMessage(const std::string& messageToLog, const LogRecordMetadata& metadata) {
     std::lock_guard<std::mutex> lock(mMessageBufferAccessLock_);
 
-    if (!mFdLogFile_.is_open()) {
+    if (!isLogFileOpen()) {
         std::cerr << "[EquinoxLogger] Log file is not open, cannot write message" << std::endl;
         return;
     }
 
-    thread_local std::string buffer;
-    buffer.clear();
-    buffer = mTimestampProducer->getTimestamp() + mTimestampProducer->getTimestampInUs() + messageToLog;
+    if (metadata.timestampNs >= mNextRotationBoundaryNs_) {
+        rotateAtBoundary(metadata.timestampNs);
+    }
 
-    try {
-        mFdLogFile_ << buffer << std::endl;
-        mFdLogFile_.flush();
-    } catch (std::ofstream::failure& ex) {  // LCOV_EXCL_LINE
-        std::cerr << "[EquinoxLogger] Failed to write to log file: " << ex.what() << std::endl;  // LCOV_EXCL_LINE
-        return;  // LCOV_EXCL_LINE
-    }  // LCOV_EXCL_LINE
+    char timestamp[kMaxTimestampLength];
+    mPendingLines_.append(timestamp, mTimestampProducer->formatTimestamp(metadata.timestampNs, timestamp));
+    mPendingLines_.append(mLogLineTemplates_.getHeader(metadata.level));
+    mPendingLines_.append(messageToLog);
+    mPendingLines_.push_back('\n');
+
+    if (mDurabilityMode_ == file_durability::MODE::sync_on_error and metadata.level >= level::LOG_LEVEL::error) {
+        writePendingLines();
+        syncLogFile(true);
+    } else if (mPendingLines_.size() >= kMaxPendingBytes) {
+        writePendingLines();
+    }
+}
+
+void equinox::FileLogsProducer::writePendingLines(bool rotateWhenFull) {
+    if (mPendingLines_.empty() or !isLogFileOpen()) {
+        return;
+    }
+
+    const std::int64_t writeStartNs = steadyClockNs();
+    if (mMappedLogSegment_.isOpen()) {
+        if (!mMappedLogSegment_.append(mPendingLines_.data(), mPendingLines_.size())) {
+            std::cerr << "[EquinoxLogger] Failed to write to log file: " << mLogFileName_ << std::endl;  // LCOV_EXCL_LINE
+            mPendingLines_.clear();  // LCOV_EXCL_LINE
+            return;  // LCOV_EXCL_LINE
+        }
+    } else if (mUringLogWriter_.isOpen()) {
+        if (!mUringLogWriter_.write(mPendingLines_.data(), mPendingLines_.size())) {
+            std::cerr << "[EquinoxLogger] Failed to write to log file: " << mLogFileName_ << std::endl;  // LCOV_EXCL_LINE
+            mPendingLines_.clear();  // LCOV_EXCL_LINE
+            return;  // LCOV_EXCL_LINE
+        }
+    } else if (const int error = mFdLogWriter_.write(mPendingLines_.data(), mPendingLines_.size()); error != 0) {
+        std::cerr << "[EquinoxLogger] Failed to write to log file: " << mLogFileName_ << " - " << std::strerror(error) << std::endl;
+        mFileWriteLatency_.recordFailedWrite();
+        /* Whatever went out before the failure is in the file */
+        mLogFileSizeBytes_ = mFdLogWriter_.getSize();
+        mPendingLines_.clear();
+        return;
+    }
+    mUnsyncedBytes_ += mPendingLines_.size();
+    if (mUringLogWriter_.isOpen()) {
+        /* io_uring records its writes when they complete, the lines of the failed ones are not in the size */
+        mLogFileSizeBytes_ = mUringLogWriter_.getSize();
+    } else {
+        mFileWriteLatency_.recordWrite(static_cast<std::uint64_t>(steadyClockNs() - writeStartNs));
+        mLogFileSizeBytes_ += mPendingLines_.size();
+    }
+    mPendingLines_.clear();
+    /* Under sustained load the worker seldom drains the queue, the writes have to keep the syncs going */
+    if (isSyncDue()) {
+        syncLogFile();
+    }
+    if (mPageCacheMode_ == file_page_cache::MODE::drop_behind) {
+        mPageCacheDropBehind_.written(getLogFileFd(), mLogFileSizeBytes_);
+    }
+
+    if (rotateWhenFull) {
+        rotateIfNeeded();
+    }
+}
+
+bool equinox::FileLogsProducer::isSyncDue() const {
+    switch (mDurabilityMode_) {
+        case file_durability::MODE::batch_sync:
+            return true;
 
-    rotateIfNeeded();
+        case file_durability::MODE::periodic_sync:
+            return (mUnsyncedBytes_ >= mSyncBytes_) or (steadyClockNs() - mLastSyncNs_ >= mSyncIntervalNs_);
+
+        case file_durability::MODE::os_buffered:
+        case file_durability::MODE::sync_on_error:
+        default:
+            return false;
+    }
+}
+
+void equinox::FileLogsProducer::syncLogFile(bool waitForSync) {
+    if (mUnsyncedBytes_ == 0U or !isLogFileOpen()) {
+        return;
+    }
+
+    if (mUringLogWriter_.isOpen()) {
+        /* Otherwise queued behind the writes in flight, the latency is recorded when it completes.
+         * The lines stay unsynced when the sync failed, the next one covers them again. */
+        if (waitForSync ? !mUringLogWriter_.syncAndWait() : !mUringLogWriter_.sync()) {
+            return;
+        }
+        mUnsyncedBytes_ = 0U;
+        mLastSyncNs_ = steadyClockNs();
+        return;
+    }
+
+    const std::int64_t syncStartNs = steadyClockNs();
+    bool synced = true;
+    if (mMappedLogSegment_.isOpen()) {
+        synced = mMappedLogSegment_.sync();
+    } else if (const int error = mFdLogWriter_.sync(); error != 0) {
+        std::cerr << "[EquinoxLogger] Failed to sync log file: " << std::strerror(error) << std::endl;  // LCOV_EXCL_LINE
+        synced = false;  // LCOV_EXCL_LINE
+    }
+    mLastSyncNs_ = steadyClockNs();
+    mFileWriteLatency_.recordSync(static_cast<std::uint64_t>(mLastSyncNs_ - syncStartNs));
+    if (!synced) {
+        mFileWriteLatency_.recordFailedSync();
+        return;
+    }
+    mUnsyncedBytes_ = 0U;
 }
 
 void equinox::FileLogsProducer::flush() {
     std::lock_guard<std::mutex> lock(mMessageBufferAccessLock_);
-    if (mFdLogFile_.is_open()) {
-        try {
-            mFdLogFile_.flush();
-        } catch (std::ofstream::failure& ex) {  // LCOV_EXCL_LINE
-            std::cerr << "[EquinoxLogger] Failed to flush log file: " << ex.what() << std::endl;  // LCOV_EXCL_LINE
-        }  // LCOV_EXCL_LINE
+    writePendingLines();
+    mUringLogWriter_.reapCompletions();
+    if (isSyncDue()) {
+        syncLogFile();
+    }
+}
+
+std::optional<std::uint32_t> equinox::FileLogsProducer::getSyncDelayMs() const {
+    std::lock_guard<std::mutex> lock(mMessageBufferAccessLock_);
+    if (mDurabilityMode_ != file_durability::MODE::periodic_sync or mUnsyncedBytes_ == 0U or !isLogFileOpen()) {
+        return std::nullopt;
     }
+    const std::int64_t delayNs = std::max<std::int64_t>(mLastSyncNs_ + mSyncIntervalNs_ - steadyClockNs(), 0);
+    /* Rounded up, waking up before the sync is due would only wait again */
+    return static_cast<std::uint32_t>(
+        std::min<std::int64_t>((delayNs + kNanosecondsPerMillisecond - 1) / kNanosecondsPerMillisecond, std::numeric_limits<std::uint32_t>::max()));
+}
+
+equinox::FileWriteStats equinox::FileLogsProducer::getWriteStats() const {
+    return mFileWriteLatency_.getStats();
 }
 
 // for testing purposes only
-std::ofstream& equinox::FileLogsProducer::GetLogFileStream(){
-    return mFdLogFile_;
+equinox::FdLogWriter& equinox::FileLogsProducer::GetFdLogWriter(){
+    return mFdLogWriter_;
 }
 
 std::string& equinox::FileLogsProducer::GetLogFileName(){
@@ -195,7 +609,39 @@ std::size_t& equinox::FileLogsProducer::GetMaxLogFiles(){
     return mMaxLogFiles_;
 }
 
-std::size_t& equinox::FileLogsProducer::GetNextRotationIndex(){
-    return mNextRotationIndex_;
+std::size_t& equinox::FileLogsProducer::GetSegmentSequence(){
+    return mSegmentSequence_;
+}
+
+std::deque<std::string>& equinox::FileLogsProducer::GetRotatedSegments(){
+    return mRotatedSegments_;
+}
+
+std::string& equinox::FileLogsProducer::GetSegmentPeriod(){
+    return mSegmentPeriod_;
+}
+
+std::int64_t& equinox::FileLogsProducer::GetNextRotationBoundaryNs(){
+    return mNextRotationBoundaryNs_;
+}
+
+std::size_t& equinox::FileLogsProducer::GetLogFileSizeBytes(){
+    return mLogFileSizeBytes_;
+}
+
+equinox::UringLogWriter& equinox::FileLogsProducer::GetUringLogWriter(){
+    return mUringLogWriter_;
+}
+
+equinox::file_io::BACKEND& equinox::FileLogsProducer::GetIoBackend(){
+    return mIoBackend_;
+}
+
+equinox::MappedLogSegment& equinox::FileLogsProducer::GetMappedLogSegment(){
+    return mMappedLogSegment_;
+}
+
+equinox::LogSegmentArchiver& equinox::FileLogsProducer::GetLogSegmentArchiver(){
+    return mLogSegmentArchiver_;
 }
 
@@ -0,0 +1,80 @@
+/*
+ * FileWriteLatency.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "FileWriteLatency.h"
+
+equinox::FileWriteLatency::FileWriteLatency() : mWrite_{{0U}, {0U}, {0U}}, mSync_{{0U}, {0U}, {0U}}, mFailedWrites_{0U}, mFailedSyncs_{0U} {}
+
+void equinox::FileWriteLatency::recordWrite(std::uint64_t durationNs) {
+    record(mWrite_, durationNs);
+}
+
+void equinox::FileWriteLatency::recordSync(std::uint64_t durationNs) {
+    record(mSync_, durationNs);
+}
+
+void equinox::FileWriteLatency::recordFailedWrite() {
+    mFailedWrites_.fetch_add(1U, std::memory_order_relaxed);
+}
+
+void equinox::FileWriteLatency::recordFailedSync() {
+    mFailedSyncs_.fetch_add(1U, std::memory_order_relaxed);
+}
+
+void equinox::FileWriteLatency::record(Latency& latency, std::uint64_t durationNs) {
+    /* Only the worker records, so the maximum needs no compare-exchange loop */
+    latency.count.fetch_add(1U, std::memory_order_relaxed);
+    latency.totalNs.fetch_add(durationNs, std::memory_order_relaxed);
+    if (durationNs > latency.maxNs.load(std::memory_order_relaxed)) {
+        latency.maxNs.store(durationNs, std::memory_order_relaxed);
+    }
+}
+
+equinox::FileWriteStats equinox::FileWriteLatency::getStats() const {
+    FileWriteStats stats;
+    stats.writeCount = mWrite_.count.load(std::memory_order_relaxed);
+    stats.writeTotalNs = mWrite_.totalNs.load(std::memory_order_relaxed);
+    stats.writeMaxNs = mWrite_.maxNs.load(std::memory_order_relaxed);
+    stats.syncCount = mSync_.count.load(std::memory_order_relaxed);
+    stats.syncTotalNs = mSync_.totalNs.load(std::memory_order_relaxed);
+    stats.syncMaxNs = mSync_.maxNs.load(std::memory_order_relaxed);
+    stats.failedWriteCount = mFailedWrites_.load(std::memory_order_relaxed);
+    stats.failedSyncCount = mFailedSyncs_.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,94 @@
+/*
+ * InFlightProducers.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "InFlightProducers.h"
+
+#include <thread>
+
+namespace {
+std::atomic<std::uint32_t> gNextStripe{0U};
+
+/* Threads are spread over the stripes in the order they first log */
+std::uint32_t getThreadStripe(std::size_t stripesCount) {
+    thread_local const std::uint32_t stripe = gNextStripe.fetch_add(1U, std::memory_order_relaxed);
+    return static_cast<std::uint32_t>(stripe % stripesCount);
+}
+}  // namespace
+
+equinox::InFlightProducers::InFlightProducers() : mEpoch_(0U), mStripes_{} {
+    for (Stripe& stripe : mStripes_) {
+        stripe.producers[0].store(0U, std::memory_order_relaxed);
+        stripe.producers[1].store(0U, std::memory_order_relaxed);
+    }
+}
+
+std::uint32_t equinox::InFlightProducers::enter() {
+    const std::uint32_t stripe = getThreadStripe(kStripesCount);
+    while (true) {
+        const std::uint32_t parity = mEpoch_.load(std::memory_order_seq_cst) & 1U;
+        std::atomic<std::uint32_t>& producers = mStripes_[stripe].producers[parity];
+        producers.fetch_add(1U, std::memory_order_seq_cst);
+        /* Counted under the epoch still current, a waiter that started it sees this producer */
+        if ((mEpoch_.load(std::memory_order_seq_cst) & 1U) == parity) {
+            return (stripe << 1U) | parity;
+        }
+        producers.fetch_sub(1U, std::memory_order_release);
+    }
+}
+
+void equinox::InFlightProducers::leave(std::uint32_t token) {
+    mStripes_[token >> 1U].producers[token & 1U].fetch_sub(1U, std::memory_order_release);
+}
+
+void equinox::InFlightProducers::waitForProducers() {
+    const std::uint32_t parity = mEpoch_.fetch_add(1U, std::memory_order_seq_cst) & 1U;
+    for (const Stripe& stripe : mStripes_) {
+        while (stripe.producers[parity].load(std::memory_order_acquire) != 0U) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+std::uint32_t equinox::InFlightProducers::getProducersCount() const {
+    std::uint32_t producersCount = 0U;
+    for (const Stripe& stripe : mStripes_) {
+        producersCount += stripe.producers[0].load(std::memory_order_acquire) + stripe.producers[1].load(std::memory_order_acquire);
+    }
+    return producersCount;
+}
@@ -0,0 +1,205 @@
+/*
+ * LogClock.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "LogClock.h"
+
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+namespace {
+/* How long the worker keeps using one calibration */
+static constexpr std::int64_t kCalibrationIntervalNs = 1000000000;
+/* Shortest period the first TSC rate is measured over */
+static constexpr std::int64_t kMinTscCalibrationNs = 1000000;
+static constexpr std::int64_t kNanosecondsPerSecond = 1000000000;
+
+std::int64_t readClockNs(clockid_t clockId) {
+    timespec now{};
+    clock_gettime(clockId, &now);
+    return static_cast<std::int64_t>(now.tv_sec) * kNanosecondsPerSecond + now.tv_nsec;
+}
+
+std::uint64_t readTscTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(readClockNs(CLOCK_MONOTONIC));
+#endif
+}
+}  // namespace
+
+equinox::LogClock::LogClock()
+    : mSource_(LoggerOptions{}.timestampClock),
+      mMonotonicCalibrated_(false),
+      mMonotonicCalibrationNs_(0),
+      mMonotonicToRealtimeOffsetNs_(0),
+      mTscCalibrated_(false),
+      mTscAnchorTicks_(0U),
+      mTscAnchorMonotonicNs_(0),
+      mTscAnchorRealtimeNs_(0),
+      mNsPerTscTick_(1.0),
+      mTscCalibrationIntervalTicks_(0U) {}
+
+void equinox::LogClock::setSource(timestamp_clock::SOURCE source) {
+    if (source == timestamp_clock::SOURCE::tsc && !isInvariantTscAvailable()) {
+        std::cerr << "[EquinoxLogger] The CPU has no invariant TSC, timestamps are taken from CLOCK_MONOTONIC" << std::endl;
+        source = timestamp_clock::SOURCE::monotonic;
+    }
+    mSource_.store(source, std::memory_order_relaxed);
+}
+
+equinox::timestamp_clock::SOURCE equinox::LogClock::getSource() const {
+    return mSource_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t equinox::LogClock::readTicks(timestamp_clock::SOURCE source) {
+    switch (source) {
+        case timestamp_clock::SOURCE::tsc:
+            return readTscTicks();
+
+        case timestamp_clock::SOURCE::realtime_coarse:
+            return static_cast<std::uint64_t>(readClockNs(CLOCK_REALTIME_COARSE));
+
+        case timestamp_clock::SOURCE::monotonic:
+        default:
+            return static_cast<std::uint64_t>(readClockNs(CLOCK_MONOTONIC));
+    }
+}
+
+bool equinox::LogClock::isInvariantTscAvailable() {
+#if defined(__x86_64__) || defined(__i386__)
+    /* CPUID.80000007H:EDX[8], the TSC ticks at a constant rate in every P-, C- and T-state */
+    static const bool invariantTscAvailable = []() {
+        unsigned int eax = 0U;
+        unsigned int ebx = 0U;
+        unsigned int ecx = 0U;
+        unsigned int edx = 0U;
+        return __get_cpuid(0x80000007U, &eax, &ebx, &ecx, &edx) != 0 && (edx & (1U << 8U)) != 0U;
+    }();
+    return invariantTscAvailable;
+#else
+    return false;
+#endif
+}
+
+std::int64_t equinox::LogClock::toNanosecondsSinceEpoch(timestamp_clock::SOURCE source, std::uint64_t ticks) {
+    switch (source) {
+        case timestamp_clock::SOURCE::realtime_coarse:
+            return static_cast<std::int64_t>(ticks);
+
+        case timestamp_clock::SOURCE::tsc:
+            /* Readings taken before the last calibration are older than the anchor, they never trigger a new one */
+            if (!mTscCalibrated_ || static_cast<std::int64_t>(ticks - mTscAnchorTicks_) >= static_cast<std::int64_t>(mTscCalibrationIntervalTicks_)) {
+                calibrateTsc();
+            }
+            return mTscAnchorRealtimeNs_ + std::llround(static_cast<double>(static_cast<std::int64_t>(ticks - mTscAnchorTicks_)) * mNsPerTscTick_);
+
+        case timestamp_clock::SOURCE::monotonic:
+        default:
+            if (!mMonotonicCalibrated_ || static_cast<std::int64_t>(ticks) - mMonotonicCalibrationNs_ >= kCalibrationIntervalNs) {
+                calibrateMonotonic();
+            }
+            return static_cast<std::int64_t>(ticks) + mMonotonicToRealtimeOffsetNs_;
+    }
+}
+
+void equinox::LogClock::calibrateMonotonic() {
+    const std::int64_t monotonicBeforeNs = readMonotonicNs();
+    const std::int64_t realtimeNs = readRealtimeNs();
+    const std::int64_t monotonicAfterNs = readMonotonicNs();
+
+    mMonotonicCalibrationNs_ = monotonicBeforeNs + (monotonicAfterNs - monotonicBeforeNs) / 2;
+    mMonotonicToRealtimeOffsetNs_ = realtimeNs - mMonotonicCalibrationNs_;
+    mMonotonicCalibrated_ = true;
+}
+
+void equinox::LogClock::calibrateTsc() {
+    std::uint64_t tscTicks = 0U;
+    std::int64_t monotonicNs = 0;
+    std::int64_t realtimeNs = 0;
+    const auto sampleClocks = [this, &tscTicks, &monotonicNs, &realtimeNs]() {
+        const std::uint64_t tscBeforeTicks = readTsc();
+        monotonicNs = readMonotonicNs();
+        realtimeNs = readRealtimeNs();
+        const std::uint64_t tscAfterTicks = readTsc();
+        tscTicks = tscBeforeTicks + (tscAfterTicks - tscBeforeTicks) / 2U;
+    };
+
+    sampleClocks();
+    if (!mTscCalibrated_) {
+        /* There is no rate to start from, measure one over a short wait; happens once on the worker */
+        mTscAnchorTicks_ = tscTicks;
+        mTscAnchorMonotonicNs_ = monotonicNs;
+        while (monotonicNs - mTscAnchorMonotonicNs_ < kMinTscCalibrationNs) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            sampleClocks();
+        }
+    }
+
+    /* The rate follows CLOCK_MONOTONIC, steps of the wall clock only move the anchor */
+    if (tscTicks > mTscAnchorTicks_ && monotonicNs > mTscAnchorMonotonicNs_) {
+        mNsPerTscTick_ = static_cast<double>(monotonicNs - mTscAnchorMonotonicNs_) / static_cast<double>(tscTicks - mTscAnchorTicks_);
+    }
+    mTscAnchorTicks_ = tscTicks;
+    mTscAnchorMonotonicNs_ = monotonicNs;
+    mTscAnchorRealtimeNs_ = realtimeNs;
+    mTscCalibrationIntervalTicks_ = static_cast<std::uint64_t>(std::llround(static_cast<double>(kCalibrationIntervalNs) / mNsPerTscTick_));
+    mTscCalibrated_ = true;
+}
+
+std::uint64_t equinox::LogClock::readTsc() const {
+    return readTscTicks();
+}
+
+std::int64_t equinox::LogClock::readMonotonicNs() const {
+    return readClockNs(CLOCK_MONOTONIC);
+}
+
+std::int64_t equinox::LogClock::readRealtimeNs() const {
+    return readClockNs(CLOCK_REALTIME);
+}
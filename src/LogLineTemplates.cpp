@@ -0,0 +1,108 @@
+/*
+ * LogLineTemplates.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "LogLineTemplates.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+std::string_view getLevelTag(equinox::level::LOG_LEVEL logLevel) {
+    switch (logLevel) {
+        case equinox::level::LOG_LEVEL::trace:
+            return "[TRACE] ";
+        case equinox::level::LOG_LEVEL::debug:
+            return "[DEBUG] ";
+        case equinox::level::LOG_LEVEL::info:
+            return "[INFO] ";
+        case equinox::level::LOG_LEVEL::warning:
+            return "[WARNING] ";
+        case equinox::level::LOG_LEVEL::error:
+            return "[ERROR] ";
+        case equinox::level::LOG_LEVEL::critical:
+            return "[CRITICAL] ";
+        case equinox::level::LOG_LEVEL::off:
+        default:
+            // Should not be logged due to the level check, but included for completeness
+            return "";
+    }
+}
+
+std::size_t copyTruncated(std::string_view source, char* destination, std::size_t capacity) {
+    const std::size_t length = std::min(source.size(), capacity);
+    std::memcpy(destination, source.data(), length);
+    return length;
+}
+}  // namespace
+
+equinox::LogLineTemplates::LogLineTemplates() : mLevelTemplates_{} {
+    render("", nullptr);
+}
+
+void equinox::LogLineTemplates::render(std::string_view logPrefix, IColorFormatter* colorFormatter) {
+    logPrefix = logPrefix.substr(0U, kMaxLogPrefixLength);
+    for (std::size_t levelIndex = 0U; levelIndex < kLevelsCount; ++levelIndex) {
+        const auto logLevel = static_cast<level::LOG_LEVEL>(levelIndex);
+        const std::string_view color = (colorFormatter != nullptr) ? colorFormatter->getColorForLevel(logLevel) : std::string_view{};
+        const std::string_view reset = color.empty() ? std::string_view{} : colorFormatter->getColorReset();
+        LevelTemplate& levelTemplate = mLevelTemplates_[levelIndex];
+
+        std::size_t headerLength = copyTruncated(color, levelTemplate.header.data(), kMaxColorLength);
+        headerLength += copyTruncated(logPrefix, levelTemplate.header.data() + headerLength, kMaxLogPrefixLength);
+        headerLength += copyTruncated(getLevelTag(logLevel), levelTemplate.header.data() + headerLength, kMaxLevelTagLength);
+        levelTemplate.headerLength = headerLength;
+        levelTemplate.trailerLength = copyTruncated(reset, levelTemplate.trailer.data(), kMaxColorLength);
+    }
+}
+
+std::string_view equinox::LogLineTemplates::getHeader(level::LOG_LEVEL logLevel) const {
+    const auto levelIndex = static_cast<std::size_t>(logLevel);
+    if (levelIndex >= kLevelsCount) {
+        return {};
+    }
+    return std::string_view(mLevelTemplates_[levelIndex].header.data(), mLevelTemplates_[levelIndex].headerLength);
+}
+
+std::string_view equinox::LogLineTemplates::getTrailer(level::LOG_LEVEL logLevel) const {
+    const auto levelIndex = static_cast<std::size_t>(logLevel);
+    if (levelIndex >= kLevelsCount) {
+        return {};
+    }
+    return std::string_view(mLevelTemplates_[levelIndex].trailer.data(), mLevelTemplates_[levelIndex].trailerLength);
+}
@@ -0,0 +1,257 @@
+/*
+ * LogSegmentArchiver.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifdef EQUINOX_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "LogSegmentArchiver.h"
+
+namespace {
+#ifdef EQUINOX_HAS_ZLIB
+static constexpr std::size_t kReadBufferSize = 64U * 1024U;
+#endif
+/* linux/ioprio.h values, the header is missing on older systems */
+static constexpr int kIoPriorityWhoProcess = 1;
+static constexpr int kIoPriorityClassIdle = 3;
+static constexpr int kIoPriorityClassShift = 13;
+
+/* Called on the archiver thread, it only runs when no other thread wants the CPU or the disk */
+void applyArchiverThreadSettings() {
+    sched_param schedulingParameters{};
+    if (const int error = pthread_setschedparam(pthread_self(), SCHED_IDLE, &schedulingParameters); error != 0) {
+        std::cerr << "[EquinoxLogger] Failed to set the archiver thread priority: " << std::strerror(error) << std::endl;  // LCOV_EXCL_LINE
+    }
+    if (syscall(SYS_ioprio_set, kIoPriorityWhoProcess, 0, kIoPriorityClassIdle << kIoPriorityClassShift) != 0) {
+        std::cerr << "[EquinoxLogger] Failed to set the archiver thread I/O priority: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+    }
+}
+}  // namespace
+
+equinox::LogSegmentArchiver::LogSegmentArchiver()
+    : mSegmentsLock_{},
+      mSegmentsChanged_{},
+      mSegments_{},
+      mCompressionMode_{LoggerOptions{}.fileCompression},
+      mDropPageCache_{false},
+      mArchiving_{false},
+      mStopping_{false},
+      mArchiverThread_{} {}
+
+equinox::LogSegmentArchiver::~LogSegmentArchiver() {
+    {
+        std::lock_guard<std::mutex> lock(mSegmentsLock_);
+        mStopping_ = true;
+    }
+    mSegmentsChanged_.notify_all();
+    if (mArchiverThread_.joinable()) {
+        mArchiverThread_.join();
+    }
+}
+
+void equinox::LogSegmentArchiver::setCompression(file_compression::MODE compressionMode) {
+#ifndef EQUINOX_HAS_ZLIB
+    if (compressionMode == file_compression::MODE::gzip) {
+        std::cerr << "[EquinoxLogger] Built without zlib, rotated log files are kept uncompressed" << std::endl;
+        compressionMode = file_compression::MODE::none;
+    }
+#endif
+    std::lock_guard<std::mutex> lock(mSegmentsLock_);
+    mCompressionMode_ = compressionMode;
+}
+
+void equinox::LogSegmentArchiver::setDropPageCache(bool dropPageCache) {
+    std::lock_guard<std::mutex> lock(mSegmentsLock_);
+    mDropPageCache_ = dropPageCache;
+}
+
+void equinox::LogSegmentArchiver::archive(const std::string& segmentFileName) {
+    queueTask(SegmentTask{segmentFileName, false});
+}
+
+void equinox::LogSegmentArchiver::retire(const std::string& segmentFileName) {
+    queueTask(SegmentTask{segmentFileName, true});
+}
+
+void equinox::LogSegmentArchiver::queueTask(SegmentTask task) {
+    {
+        std::lock_guard<std::mutex> lock(mSegmentsLock_);
+        mSegments_.push_back(std::move(task));
+        if (!mArchiverThread_.joinable()) {
+            mArchiverThread_ = std::thread([this]() { run(); });
+        }
+    }
+    mSegmentsChanged_.notify_all();
+}
+
+void equinox::LogSegmentArchiver::waitIdle() {
+    std::unique_lock<std::mutex> lock(mSegmentsLock_);
+    mSegmentsChanged_.wait(lock, [this]() { return mSegments_.empty() and !mArchiving_; });
+}
+
+void equinox::LogSegmentArchiver::run() {
+    applyArchiverThreadSettings();
+
+    std::unique_lock<std::mutex> lock(mSegmentsLock_);
+    while (true) {
+        mSegmentsChanged_.wait(lock, [this]() { return !mSegments_.empty() or mStopping_; });
+        if (mSegments_.empty()) {
+            return;
+        }
+
+        const SegmentTask task = std::move(mSegments_.front());
+        mSegments_.pop_front();
+        const file_compression::MODE compressionMode = mCompressionMode_;
+        const bool dropArchivedPages = mDropPageCache_;
+        mArchiving_ = true;
+        lock.unlock();
+
+        if (task.retire) {
+            retireSegment(task.segmentFileName);
+        } else {
+            archiveSegment(task.segmentFileName, compressionMode);
+            if (dropArchivedPages) {
+                const std::string compressedFileName = task.segmentFileName + ".gz";
+                dropFromPageCache(std::filesystem::exists(compressedFileName) ? compressedFileName : task.segmentFileName);
+            }
+        }
+
+        lock.lock();
+        mArchiving_ = false;
+        mSegmentsChanged_.notify_all();
+    }
+}
+
+void equinox::LogSegmentArchiver::archiveSegment(const std::string& segmentFileName, file_compression::MODE compressionMode) {
+    if (compressionMode == file_compression::MODE::gzip) {
+        compressSegment(segmentFileName);
+    }
+}
+
+void equinox::LogSegmentArchiver::retireSegment(const std::string& segmentFileName) {
+    /* Whichever of the two the segment was archived as */
+    for (const std::string& fileName : {segmentFileName, segmentFileName + ".gz"}) {
+        std::error_code errorCode;
+        std::filesystem::remove(fileName, errorCode);
+        if (errorCode) {
+            std::cerr << "[EquinoxLogger] Failed to remove old log file: " << fileName << " - " << errorCode.message() << std::endl;  // LCOV_EXCL_LINE
+        }
+    }
+}
+
+void equinox::LogSegmentArchiver::dropFromPageCache(const std::string& fileName) {
+    const int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    /* Dirty pages are not dropped, they have to reach the disk first */
+    if (::fdatasync(fd) != 0) {
+        std::cerr << "[EquinoxLogger] Failed to sync archived log file: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+    }
+    if (const int error = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED); error != 0) {
+        std::cerr << "[EquinoxLogger] Failed to drop archived log file pages: " << std::strerror(error) << std::endl;  // LCOV_EXCL_LINE
+    }
+    ::close(fd);
+}
+
+bool equinox::LogSegmentArchiver::compressSegment(const std::string& segmentFileName) {
+#ifdef EQUINOX_HAS_ZLIB
+    const std::string compressedFileName = segmentFileName + ".gz";
+    const std::string temporaryFileName = compressedFileName + ".tmp";
+
+    const int segmentFd = ::open(segmentFileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (segmentFd < 0) {
+        std::cerr << "[EquinoxLogger] Failed to open rotated log file: " << segmentFileName << " - " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    gzFile compressedFile = gzopen(temporaryFileName.c_str(), "wb");
+    if (compressedFile == nullptr) {
+        std::cerr << "[EquinoxLogger] Failed to create compressed log file: " << temporaryFileName << std::endl;  // LCOV_EXCL_LINE
+        ::close(segmentFd);  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+
+    std::vector<char> readBuffer(kReadBufferSize);
+    bool compressed = true;
+    while (true) {
+        const ssize_t readBytes = ::read(segmentFd, readBuffer.data(), readBuffer.size());
+        if (readBytes == 0) {
+            break;
+        }
+        if (readBytes < 0) {
+            if (errno == EINTR) {  // LCOV_EXCL_LINE
+                continue;  // LCOV_EXCL_LINE
+            }
+            compressed = false;  // LCOV_EXCL_LINE
+            break;  // LCOV_EXCL_LINE
+        }
+        if (gzwrite(compressedFile, readBuffer.data(), static_cast<unsigned>(readBytes)) != static_cast<int>(readBytes)) {
+            compressed = false;  // LCOV_EXCL_LINE
+            break;  // LCOV_EXCL_LINE
+        }
+    }
+    ::close(segmentFd);
+    compressed = (gzclose(compressedFile) == Z_OK) and compressed;
+
+    if (!compressed or std::rename(temporaryFileName.c_str(), compressedFileName.c_str()) != 0) {
+        std::cerr << "[EquinoxLogger] Failed to compress rotated log file: " << segmentFileName << std::endl;  // LCOV_EXCL_LINE
+        std::remove(temporaryFileName.c_str());  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+
+    std::remove(segmentFileName.c_str());
+    return true;
+#else
+    std::cerr << "[EquinoxLogger] Built without zlib, cannot compress: " << segmentFileName << std::endl;
+    return false;
+#endif
+}
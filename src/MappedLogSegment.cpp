@@ -0,0 +1,189 @@
+/*
+ * MappedLogSegment.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#include "MappedLogSegment.h"
+
+namespace {
+/* Smallest preallocation and growth step, rounded up to whole pages */
+static constexpr std::size_t kMinReserveBytes = 4U * 1024U * 1024U;
+
+std::size_t roundUpToPages(std::size_t bytes) {
+    const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return (bytes + pageSize - 1U) / pageSize * pageSize;
+}
+}  // namespace
+
+equinox::MappedLogSegment::MappedLogSegment() : mFd_{-1}, mMapping_{nullptr}, mCapacity_{0U}, mSize_{0U}, mSyncedSize_{0U} {}
+
+equinox::MappedLogSegment::~MappedLogSegment() {
+    close();
+}
+
+bool equinox::MappedLogSegment::open(const std::string& fileName, std::size_t reserveBytes, bool truncate) {
+    /* Mapped beside the open segment, which keeps taking the lines when this one fails */
+    MappedLogSegment nextSegment;
+    nextSegment.mFd_ = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+    if (nextSegment.mFd_ < 0) {
+        std::cerr << "[EquinoxLogger] Failed to open log file: " << fileName << " - " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat fileStatus {};
+    if (::fstat(nextSegment.mFd_, &fileStatus) != 0) {
+        std::cerr << "[EquinoxLogger] Failed to check file size: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+        ::close(nextSegment.mFd_);  // LCOV_EXCL_LINE
+        nextSegment.mFd_ = -1;  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+    /* close() cuts the file to mSize_, a failed preallocation leaves it as it was */
+    nextSegment.mSize_ = static_cast<std::size_t>(fileStatus.st_size);
+
+    if (!nextSegment.reserve(std::max({reserveBytes, nextSegment.mSize_, kMinReserveBytes}))) {
+        return false;
+    }
+
+    /* A segment the process did not close keeps its zero padding, the lines end before it */
+    while (nextSegment.mSize_ > 0U and nextSegment.mMapping_[nextSegment.mSize_ - 1U] == '\0') {
+        --nextSegment.mSize_;
+    }
+    nextSegment.mSyncedSize_ = nextSegment.mSize_;
+
+    close();
+    std::swap(mFd_, nextSegment.mFd_);
+    std::swap(mMapping_, nextSegment.mMapping_);
+    std::swap(mCapacity_, nextSegment.mCapacity_);
+    std::swap(mSize_, nextSegment.mSize_);
+    std::swap(mSyncedSize_, nextSegment.mSyncedSize_);
+    return true;
+}
+
+bool equinox::MappedLogSegment::isOpen() const {
+    return mMapping_ != nullptr;
+}
+
+bool equinox::MappedLogSegment::reserve(std::size_t capacityBytes) {
+    capacityBytes = roundUpToPages(capacityBytes);
+    if (capacityBytes <= mCapacity_) {
+        return true;
+    }
+
+    /* Blocks are allocated now instead of when a write first touches them */
+    if (::fallocate(mFd_, 0, 0, static_cast<off_t>(capacityBytes)) != 0) {
+        if (errno != EOPNOTSUPP or ::ftruncate(mFd_, static_cast<off_t>(capacityBytes)) != 0) {
+            std::cerr << "[EquinoxLogger] Failed to preallocate log file: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+
+    void* mapping = (mMapping_ == nullptr) ? ::mmap(nullptr, capacityBytes, PROT_READ | PROT_WRITE, MAP_SHARED, mFd_, 0)
+                                           : ::mremap(mMapping_, mCapacity_, capacityBytes, MREMAP_MAYMOVE);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "[EquinoxLogger] Failed to map log file: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+    mMapping_ = static_cast<char*>(mapping);
+    mCapacity_ = capacityBytes;
+    return true;
+}
+
+bool equinox::MappedLogSegment::append(const char* data, std::size_t size) {
+    if (!isOpen()) {
+        return false;
+    }
+    if (mSize_ + size > mCapacity_ and !reserve(std::max(mSize_ + size, mCapacity_ + kMinReserveBytes))) {
+        return false;
+    }
+
+    std::memcpy(mMapping_ + mSize_, data, size);
+    mSize_ += size;
+    return true;
+}
+
+bool equinox::MappedLogSegment::sync() {
+    if (!isOpen() or mSyncedSize_ == mSize_) {
+        return true;
+    }
+
+    /* msync() takes a page aligned start */
+    const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t syncStart = mSyncedSize_ / pageSize * pageSize;
+    if (::msync(mMapping_ + syncStart, mSize_ - syncStart, MS_SYNC) != 0) {
+        std::cerr << "[EquinoxLogger] Failed to sync log file: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+    mSyncedSize_ = mSize_;
+    return true;
+}
+
+void equinox::MappedLogSegment::close() {
+    if (mMapping_ != nullptr) {
+        ::munmap(mMapping_, mCapacity_);
+        mMapping_ = nullptr;
+    }
+    if (mFd_ >= 0) {
+        /* Drops the preallocated tail, the file ends with the last line */
+        if (::ftruncate(mFd_, static_cast<off_t>(mSize_)) != 0) {
+            std::cerr << "[EquinoxLogger] Failed to truncate log file: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+        }
+        ::close(mFd_);
+        mFd_ = -1;
+    }
+    mCapacity_ = 0U;
+    mSize_ = 0U;
+    mSyncedSize_ = 0U;
+}
+
+std::size_t equinox::MappedLogSegment::getSize() const {
+    return mSize_;
+}
+
+std::size_t equinox::MappedLogSegment::getCapacity() const {
+    return mCapacity_;
+}
@@ -0,0 +1,70 @@
+/*
+ * OverflowStats.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "OverflowStats.h"
+
+equinox::OverflowStats::OverflowStats() : mDroppedMessagesPerLevel_{}, mDroppedMessagesSinceLastMarker_{0U} {}
+
+void equinox::OverflowStats::recordDroppedMessage(level::LOG_LEVEL msgLevel) {
+    const std::size_t levelIndex = static_cast<std::size_t>(msgLevel);
+    if (levelIndex < kLevelsCount) {
+        mDroppedMessagesPerLevel_[levelIndex].fetch_add(1U, std::memory_order_relaxed);
+    }
+    mDroppedMessagesSinceLastMarker_.fetch_add(1U, std::memory_order_relaxed);
+}
+
+std::uint64_t equinox::OverflowStats::getDroppedMessagesCount(level::LOG_LEVEL msgLevel) const {
+    const std::size_t levelIndex = static_cast<std::size_t>(msgLevel);
+    return (levelIndex < kLevelsCount) ? mDroppedMessagesPerLevel_[levelIndex].load(std::memory_order_relaxed) : 0U;
+}
+
+std::uint64_t equinox::OverflowStats::getDroppedMessagesCount() const {
+    std::uint64_t droppedMessagesCount = 0U;
+    for (const auto& droppedMessages : mDroppedMessagesPerLevel_) {
+        droppedMessagesCount += droppedMessages.load(std::memory_order_relaxed);
+    }
+    return droppedMessagesCount;
+}
+
+std::uint64_t equinox::OverflowStats::takeDroppedMessagesSinceLastMarker() {
+    if (mDroppedMessagesSinceLastMarker_.load(std::memory_order_relaxed) == 0U) {
+        return 0U;
+    }
+    return mDroppedMessagesSinceLastMarker_.exchange(0U, std::memory_order_relaxed);
+}
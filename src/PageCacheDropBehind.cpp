@@ -0,0 +1,86 @@
+/*
+ * PageCacheDropBehind.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include <fcntl.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include "PageCacheDropBehind.h"
+
+equinox::PageCacheDropBehind::PageCacheDropBehind(std::size_t windowBytes) : mWindowBytes_{windowBytes}, mWindowStart_{0U}, mDroppedUntil_{0U} {}
+
+void equinox::PageCacheDropBehind::reset(std::size_t fileSizeBytes) {
+    mWindowStart_ = fileSizeBytes;
+    mDroppedUntil_ = fileSizeBytes;
+}
+
+void equinox::PageCacheDropBehind::written(int fd, std::size_t fileSizeBytes) {
+    if (fd < 0) {
+        return;
+    }
+
+    /* The size shrinks when io_uring loses the lines of a failed write, the windows stay where they are */
+    while (fileSizeBytes > mWindowStart_ and fileSizeBytes - mWindowStart_ >= mWindowBytes_) {
+        startWriteback(fd, mWindowStart_, mWindowBytes_);
+        if (mWindowStart_ > mDroppedUntil_) {
+            /* Its writeback started one window ago, waiting for it rarely blocks */
+            dropWindow(fd, mDroppedUntil_, mWindowStart_ - mDroppedUntil_);
+            mDroppedUntil_ = mWindowStart_;
+        }
+        mWindowStart_ += mWindowBytes_;
+    }
+}
+
+void equinox::PageCacheDropBehind::startWriteback(int fd, std::size_t offset, std::size_t length) {
+    if (::sync_file_range(fd, static_cast<off64_t>(offset), static_cast<off64_t>(length), SYNC_FILE_RANGE_WRITE) != 0) {
+        std::cerr << "[EquinoxLogger] Failed to start log file writeback: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+    }
+}
+
+void equinox::PageCacheDropBehind::dropWindow(int fd, std::size_t offset, std::size_t length) {
+    if (::sync_file_range(fd, static_cast<off64_t>(offset), static_cast<off64_t>(length),
+                          SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER) != 0) {
+        std::cerr << "[EquinoxLogger] Failed to write back log file: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+    }
+    if (const int error = ::posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_DONTNEED); error != 0) {
+        std::cerr << "[EquinoxLogger] Failed to drop log file pages: " << std::strerror(error) << std::endl;  // LCOV_EXCL_LINE
+    }
+}
@@ -0,0 +1,274 @@
+/*
+ * PerCpuLogQueue.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "PerCpuLogQueue.h"
+
+#include <sched.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "OverflowWait.h"
+
+namespace {
+static constexpr size_t kCacheLineSize = 64U;
+static constexpr size_t kMinCpuRingCapacity = 4096U;
+static constexpr int kSpinsBeforeYield = 64;
+
+/* Record layout: [uint32 length][message bytes][padding to kRecordAlignment] */
+static constexpr size_t kRecordHeaderSize = sizeof(uint32_t);
+static constexpr size_t kRecordAlignment = sizeof(uint32_t);
+/* Length of the record filling the end of the ring when the next one does not fit before the wrap */
+static constexpr uint32_t kWrapMarker = UINT32_MAX;
+
+size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1U) & ~(alignment - 1U);
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+  size_t result = 1U;
+  while (result < value) {
+    result <<= 1U;
+  }
+  return result;
+}
+}  // namespace
+
+/* Byte ring of one CPU, producers are serialized by the spinlock and the worker reads without locking */
+class equinox::PerCpuLogQueue::CpuRing {
+ public:
+  explicit CpuRing(size_t capacity) : mCapacity_(capacity), mBuffer_(new char[capacity]) {}
+
+  /* A record larger than half of the ring may never fit */
+  bool canHold(size_t message_size) const { return alignUp(kRecordHeaderSize + message_size, kRecordAlignment) <= mCapacity_ / 2U; }
+
+  bool append(const std::string& log_message) {
+    const size_t recordSize = alignUp(kRecordHeaderSize + log_message.size(), kRecordAlignment);
+    if (!canHold(log_message.size())) {
+      return false;
+    }
+
+    lock();
+    const uint64_t writePosition = mWritePosition_.load(std::memory_order_relaxed);
+    const size_t offset = static_cast<size_t>(writePosition & (mCapacity_ - 1U));
+    const size_t wrapSize = (offset + recordSize > mCapacity_) ? mCapacity_ - offset : 0U;
+    if (writePosition + wrapSize + recordSize - mReadPosition_.load(std::memory_order_acquire) > mCapacity_) {
+      unlock();
+      return false;
+    }
+
+    if (wrapSize > 0U) {
+      std::memcpy(mBuffer_.get() + offset, &kWrapMarker, sizeof(kWrapMarker));
+    }
+
+    char* record = mBuffer_.get() + ((writePosition + wrapSize) & (mCapacity_ - 1U));
+    const uint32_t length = static_cast<uint32_t>(log_message.size());
+    std::memcpy(record, &length, sizeof(length));
+    std::memcpy(record + kRecordHeaderSize, log_message.data(), log_message.size());
+    mWritePosition_.store(writePosition + wrapSize + recordSize, std::memory_order_release);
+    unlock();
+    return true;
+  }
+
+  size_t consume(const LogRecordVisitor& visitor, size_t max_count) {
+    uint64_t readPosition = mReadPosition_.load(std::memory_order_relaxed);
+    const uint64_t writePosition = mWritePosition_.load(std::memory_order_acquire);
+    size_t consumed = 0U;
+
+    while (readPosition < writePosition && consumed < max_count) {
+      const size_t offset = static_cast<size_t>(readPosition & (mCapacity_ - 1U));
+      uint32_t length = 0U;
+      std::memcpy(&length, mBuffer_.get() + offset, sizeof(length));
+      if (length == kWrapMarker) {
+        readPosition += mCapacity_ - offset;
+        continue;
+      }
+
+      visitor(std::string_view(mBuffer_.get() + offset + kRecordHeaderSize, length));
+      readPosition += alignUp(kRecordHeaderSize + length, kRecordAlignment);
+      ++consumed;
+    }
+
+    mReadPosition_.store(readPosition, std::memory_order_release);
+    return consumed;
+  }
+
+  bool empty() const { return mReadPosition_.load(std::memory_order_relaxed) == mWritePosition_.load(std::memory_order_acquire); }
+
+  size_t capacity() const { return mCapacity_; }
+
+ private:
+  void lock() {
+    int spins = 0;
+    while (mLocked_.exchange(true, std::memory_order_acquire)) {
+      /* The holder was most likely preempted, spinning would only delay it */
+      if (++spins >= kSpinsBeforeYield) {
+        spins = 0;
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void unlock() { mLocked_.store(false, std::memory_order_release); }
+
+  const size_t mCapacity_;
+  const std::unique_ptr<char[]> mBuffer_;
+  /* Producer and worker sides live on separate cache lines */
+  alignas(kCacheLineSize) std::atomic<bool> mLocked_{false};
+  std::atomic<uint64_t> mWritePosition_{0U};
+  alignas(kCacheLineSize) std::atomic<uint64_t> mReadPosition_{0U};
+};
+
+equinox::PerCpuLogQueue::PerCpuLogQueue(size_t cpu_ring_capacity_bytes, size_t cpu_count)
+    : mCpuRings_{},
+      mNextCpuRing_(0U),
+      mWorkerMutex_{},
+      mWorkerConditionVariable_{},
+      mWorkerWaiting_(false),
+      mStopRequested_(false),
+      mDroppedMessagesCount_(0U),
+      mOverflowPolicy_(overflow::POLICY::drop_oldest),
+      mBlockTimeoutMs_(0U) {
+  const size_t cpuRingCapacity = roundUpToPowerOfTwo(std::max(cpu_ring_capacity_bytes, kMinCpuRingCapacity));
+  mCpuRings_.reserve(std::max<size_t>(cpu_count, 1U));
+  for (size_t cpu = 0; cpu < std::max<size_t>(cpu_count, 1U); ++cpu) {
+    mCpuRings_.push_back(std::make_unique<CpuRing>(cpuRingCapacity));
+  }
+}
+
+equinox::PerCpuLogQueue::~PerCpuLogQueue() = default;
+
+size_t equinox::PerCpuLogQueue::getCurrentCpu() const {
+  /* glibc answers from the rseq area it registers for every thread, so this is a plain memory read */
+  const int cpu = sched_getcpu();
+  return (cpu < 0) ? 0U : static_cast<size_t>(cpu);
+}
+
+bool equinox::PerCpuLogQueue::enqueue(const std::string& log_message) {
+  return push(log_message, mOverflowPolicy_.load(std::memory_order_relaxed) == overflow::POLICY::block);
+}
+
+bool equinox::PerCpuLogQueue::tryEnqueue(const std::string& log_message) {
+  return push(log_message, false);
+}
+
+bool equinox::PerCpuLogQueue::appendToCurrentCpuRing(const std::string& log_message) {
+  /* The thread may migrate right after the lookup, the spinlock keeps the append correct on any ring */
+  return mCpuRings_[getCurrentCpu() % mCpuRings_.size()]->append(log_message);
+}
+
+bool equinox::PerCpuLogQueue::push(const std::string& log_message, bool may_wait) {
+  if (!appendToCurrentCpuRing(log_message) &&
+      !(may_wait && mCpuRings_.front()->canHold(log_message.size()) &&
+        retryUntilTimeout([this, &log_message]() { return appendToCurrentCpuRing(log_message); }, mBlockTimeoutMs_.load(std::memory_order_relaxed)))) {
+    mDroppedMessagesCount_.fetch_add(1U, std::memory_order_relaxed);
+    return false;
+  }
+
+  /* Pairs with the fence in consume(): either the worker sees the record or this thread sees it waiting */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (mWorkerWaiting_.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(mWorkerMutex_);
+    mWorkerConditionVariable_.notify_one();
+  }
+  return true;
+}
+
+size_t equinox::PerCpuLogQueue::consumeCpuRings(const LogRecordVisitor& visitor, size_t max_batch_size) {
+  size_t consumed = 0U;
+  /* Start from a different ring every batch so a busy CPU can not starve the others */
+  for (size_t visited = 0; visited < mCpuRings_.size() && consumed < max_batch_size; ++visited) {
+    consumed += mCpuRings_[(mNextCpuRing_ + visited) % mCpuRings_.size()]->consume(visitor, max_batch_size - consumed);
+  }
+  mNextCpuRing_ = (mNextCpuRing_ + 1U) % mCpuRings_.size();
+  return consumed;
+}
+
+bool equinox::PerCpuLogQueue::hasPendingWork() const {
+  if (mStopRequested_.load(std::memory_order_acquire)) {
+    return true;
+  }
+  return std::any_of(mCpuRings_.begin(), mCpuRings_.end(), [](const std::unique_ptr<CpuRing>& cpuRing) { return !cpuRing->empty(); });
+}
+
+bool equinox::PerCpuLogQueue::consume(const LogRecordVisitor& visitor, size_t max_batch_size, uint32_t timeout_ms) {
+  if (consumeCpuRings(visitor, max_batch_size) > 0U) {
+    return true;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mWorkerMutex_);
+    mWorkerWaiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    mWorkerConditionVariable_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]() { return hasPendingWork(); });
+    mWorkerWaiting_.store(false, std::memory_order_relaxed);
+  }
+
+  return consumeCpuRings(visitor, max_batch_size) > 0U;
+}
+
+bool equinox::PerCpuLogQueue::dequeue(std::vector<std::string>& out, size_t max_batch_size, uint32_t timeout_ms) {
+  return consume([&out](std::string_view logRecord) { out.emplace_back(logRecord); }, max_batch_size, timeout_ms);
+}
+
+void equinox::PerCpuLogQueue::stop() {
+  std::unique_lock<std::mutex> lock(mWorkerMutex_);
+  mStopRequested_.store(true, std::memory_order_release);
+  lock.unlock();
+  mWorkerConditionVariable_.notify_all();
+}
+
+void equinox::PerCpuLogQueue::setOverflowPolicy(overflow::POLICY policy, uint32_t block_timeout_ms, const LogRecordVisitor& /*dropped_record_visitor*/) {
+  mBlockTimeoutMs_.store(block_timeout_ms, std::memory_order_relaxed);
+  mOverflowPolicy_.store(policy, std::memory_order_relaxed);
+}
+
+size_t equinox::PerCpuLogQueue::getCpuRingsCount() const {
+  return mCpuRings_.size();
+}
+
+size_t equinox::PerCpuLogQueue::getCpuRingCapacity() const {
+  return mCpuRings_.front()->capacity();
+}
+
+uint64_t equinox::PerCpuLogQueue::getDroppedMessagesCount() const {
+  return mDroppedMessagesCount_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,280 @@
+/*
+ * PerThreadLogQueue.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "PerThreadLogQueue.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "OverflowWait.h"
+
+namespace {
+static constexpr size_t kCacheLineSize = 64U;
+
+std::atomic<uint64_t> gNextQueueId{0U};
+
+size_t roundUpToPowerOfTwo(size_t value) {
+  size_t result = 1U;
+  while (result < value) {
+    result <<= 1U;
+  }
+  return result;
+}
+}  // namespace
+
+/*
+ * Wait-free single-producer/single-consumer ring. The worker copies the messages out so the slots keep their
+ * string buffers between laps and the producer only allocates for a message longer than the slot held before.
+ */
+class equinox::PerThreadLogQueue::Ring {
+ public:
+  explicit Ring(size_t capacity) : mSlots_(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2U))), mMask_(mSlots_.size() - 1U) {}
+
+  bool push(const std::string& log_message) {
+    const size_t tail = mTail_.load(std::memory_order_relaxed);
+    if (tail - mCachedHead_ == mSlots_.size()) {
+      mCachedHead_ = mHead_.load(std::memory_order_acquire);
+      if (tail - mCachedHead_ == mSlots_.size()) {
+        return false;
+      }
+    }
+
+    mSlots_[tail & mMask_].assign(log_message);
+    mTail_.store(tail + 1U, std::memory_order_release);
+    return true;
+  }
+
+  size_t pop(std::vector<std::string>& out, size_t max_count) {
+    const size_t head = mHead_.load(std::memory_order_relaxed);
+    const size_t count = std::min(max_count, mTail_.load(std::memory_order_acquire) - head);
+    for (size_t i = 0; i < count; ++i) {
+      out.emplace_back(mSlots_[(head + i) & mMask_]);
+    }
+    mHead_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  bool empty() const { return mHead_.load(std::memory_order_acquire) == mTail_.load(std::memory_order_acquire); }
+
+  void markProducerExited() { mProducerExited_.store(true, std::memory_order_release); }
+  bool producerExited() const { return mProducerExited_.load(std::memory_order_acquire); }
+
+ private:
+  std::vector<std::string> mSlots_;
+  const size_t mMask_;
+  alignas(kCacheLineSize) std::atomic<size_t> mHead_{0U};
+  alignas(kCacheLineSize) std::atomic<size_t> mTail_{0U};
+  size_t mCachedHead_{0U};
+  std::atomic<bool> mProducerExited_{false};
+};
+
+namespace {
+/* Rings of the current thread, one per queue it logged to; the destructor runs when the thread exits */
+class ThreadRings {
+ public:
+  ~ThreadRings() {
+    for (auto& entry : mEntries_) {
+      entry.ring->markProducerExited();
+    }
+  }
+
+  std::shared_ptr<equinox::PerThreadLogQueue::Ring> find(uint64_t queueId) const {
+    for (const auto& entry : mEntries_) {
+      if (entry.queueId == queueId) {
+        return entry.ring;
+      }
+    }
+    return nullptr;
+  }
+
+  void add(uint64_t queueId, std::shared_ptr<equinox::PerThreadLogQueue::Ring> ring) {
+    /* Forget rings of destroyed queues, this thread holds their last reference */
+    mEntries_.erase(std::remove_if(mEntries_.begin(), mEntries_.end(), [](const Entry& entry) { return entry.ring.use_count() == 1; }), mEntries_.end());
+    mEntries_.push_back(Entry{queueId, std::move(ring)});
+  }
+
+ private:
+  struct Entry {
+    uint64_t queueId;
+    std::shared_ptr<equinox::PerThreadLogQueue::Ring> ring;
+  };
+
+  std::vector<Entry> mEntries_;
+};
+
+thread_local ThreadRings tThreadRings;
+thread_local uint64_t tLastQueueId = UINT64_MAX;
+thread_local equinox::PerThreadLogQueue::Ring* tLastRing = nullptr;
+}  // namespace
+
+equinox::PerThreadLogQueue::PerThreadLogQueue(size_t ring_capacity)
+    : mQueueId_(gNextQueueId.fetch_add(1U)),
+      mRingCapacity_(ring_capacity),
+      mRegisteredRings_{},
+      mRingsRegistered_(false),
+      mRings_{},
+      mNextRingIndex_(0U),
+      mWorkerMutex_{},
+      mWorkerConditionVariable_{},
+      mWorkerWaiting_(false),
+      mStopRequested_(false),
+      mDroppedMessagesCount_(0U),
+      mOverflowPolicy_(overflow::POLICY::drop_oldest),
+      mBlockTimeoutMs_(0U) {}
+
+equinox::PerThreadLogQueue::~PerThreadLogQueue() = default;
+
+equinox::PerThreadLogQueue::Ring& equinox::PerThreadLogQueue::getThreadRing() {
+  if (tLastQueueId == mQueueId_) {
+    return *tLastRing;
+  }
+
+  std::shared_ptr<Ring> ring = tThreadRings.find(mQueueId_);
+  if (!ring) {
+    ring = std::make_shared<Ring>(mRingCapacity_);
+    tThreadRings.add(mQueueId_, ring);
+
+    std::lock_guard<std::mutex> lock(mWorkerMutex_);
+    mRegisteredRings_.push_back(ring);
+    mRingsRegistered_.store(true, std::memory_order_release);
+  }
+
+  tLastQueueId = mQueueId_;
+  tLastRing = ring.get();
+  return *ring;
+}
+
+bool equinox::PerThreadLogQueue::enqueue(const std::string& log_message) {
+  return push(log_message, mOverflowPolicy_.load(std::memory_order_relaxed) == overflow::POLICY::block);
+}
+
+bool equinox::PerThreadLogQueue::tryEnqueue(const std::string& log_message) {
+  return push(log_message, false);
+}
+
+bool equinox::PerThreadLogQueue::push(const std::string& log_message, bool may_wait) {
+  Ring& ring = getThreadRing();
+  if (!ring.push(log_message) &&
+      !(may_wait && retryUntilTimeout([&ring, &log_message]() { return ring.push(log_message); }, mBlockTimeoutMs_.load(std::memory_order_relaxed)))) {
+    mDroppedMessagesCount_.fetch_add(1U, std::memory_order_relaxed);
+    return false;
+  }
+
+  /* Pairs with the fence in dequeue(): either the worker sees the message or this thread sees it waiting */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (mWorkerWaiting_.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(mWorkerMutex_);
+    mWorkerConditionVariable_.notify_one();
+  }
+  return true;
+}
+
+void equinox::PerThreadLogQueue::collectRegisteredRings() {
+  if (!mRingsRegistered_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mWorkerMutex_);
+  mRings_.insert(mRings_.end(), mRegisteredRings_.begin(), mRegisteredRings_.end());
+  mRegisteredRings_.clear();
+  mRingsRegistered_.store(false, std::memory_order_relaxed);
+}
+
+size_t equinox::PerThreadLogQueue::drainRings(std::vector<std::string>& out, size_t max_batch_size) {
+  collectRegisteredRings();
+
+  size_t drained = 0U;
+  /* Start from a different ring every batch so a busy thread can not starve the others */
+  for (size_t visited = 0; visited < mRings_.size() && drained < max_batch_size; ++visited) {
+    const size_t ringIndex = (mNextRingIndex_ + visited) % mRings_.size();
+    drained += mRings_[ringIndex]->pop(out, max_batch_size - drained);
+  }
+  if (!mRings_.empty()) {
+    mNextRingIndex_ = (mNextRingIndex_ + 1U) % mRings_.size();
+  }
+
+  /* The exited flag is read before the emptiness check, so no message pushed before the exit is lost */
+  mRings_.erase(std::remove_if(mRings_.begin(), mRings_.end(), [](const std::shared_ptr<Ring>& ring) { return ring->producerExited() && ring->empty(); }),
+                mRings_.end());
+  return drained;
+}
+
+bool equinox::PerThreadLogQueue::hasPendingWork() {
+  if (mStopRequested_.load(std::memory_order_acquire) || mRingsRegistered_.load(std::memory_order_acquire)) {
+    return true;
+  }
+  return std::any_of(mRings_.begin(), mRings_.end(), [](const std::shared_ptr<Ring>& ring) { return !ring->empty(); });
+}
+
+bool equinox::PerThreadLogQueue::dequeue(std::vector<std::string>& out, size_t max_batch_size, uint32_t timeout_ms) {
+  if (drainRings(out, max_batch_size) > 0U) {
+    return true;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mWorkerMutex_);
+    mWorkerWaiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    mWorkerConditionVariable_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]() { return hasPendingWork(); });
+    mWorkerWaiting_.store(false, std::memory_order_relaxed);
+  }
+
+  return drainRings(out, max_batch_size) > 0U;
+}
+
+void equinox::PerThreadLogQueue::stop() {
+  std::unique_lock<std::mutex> lock(mWorkerMutex_);
+  mStopRequested_.store(true, std::memory_order_release);
+  lock.unlock();
+  mWorkerConditionVariable_.notify_all();
+}
+
+void equinox::PerThreadLogQueue::setOverflowPolicy(overflow::POLICY policy, uint32_t block_timeout_ms, const LogRecordVisitor& /*dropped_record_visitor*/) {
+  mBlockTimeoutMs_.store(block_timeout_ms, std::memory_order_relaxed);
+  mOverflowPolicy_.store(policy, std::memory_order_relaxed);
+}
+
+size_t equinox::PerThreadLogQueue::getRingsCount() {
+  collectRegisteredRings();
+  return mRings_.size();
+}
+
+uint64_t equinox::PerThreadLogQueue::getDroppedMessagesCount() const {
+  return mDroppedMessagesCount_.load(std::memory_order_relaxed);
+}
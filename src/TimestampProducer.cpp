@@ -39,24 +39,144 @@
 
 #include "TimestampProducer.h"
 
-#include <chrono>
-#include <ctime>
+#include <cstring>
 
-std::string equinox::TimestampProducer::getTimestamp() const {
-  std::chrono::system_clock::time_point sys_clock_time_point;
+namespace {
+static constexpr std::int64_t kNanosecondsPerSecond = 1000000000;
+static constexpr std::int64_t kSecondsPerMinute = 60;
 
-  sys_clock_time_point = std::chrono::system_clock::now();
-  std::time_t t = std::chrono::system_clock::to_time_t(sys_clock_time_point);
-  std::string timestamp_ = std::ctime(&t);
-  timestamp_.resize(timestamp_.size() - 1);
-  timestamp_ = std::string("[" + timestamp_ + "]");
+static constexpr char kDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
 
-  return timestamp_;
+inline char* writeTwoDigits(char* out, std::uint32_t value) {
+  std::memcpy(out, &kDigitPairs[value * 2U], 2U);
+  return out + 2;
 }
 
-std::string equinox::TimestampProducer::getTimestampInUs() {
-  uint64_t timestampInUs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-  mTimestamp_ = std::string("[" + std::to_string(timestampInUs) + "]");
+/* Fixed width, so the digits are written without a loop or a branch on the value */
+inline char* writeSixDigits(char* out, std::uint32_t value) {
+  out = writeTwoDigits(out, value / 10000U);
+  out = writeTwoDigits(out, (value / 100U) % 100U);
+  return writeTwoDigits(out, value % 100U);
+}
+
+inline char* writeNineDigits(char* out, std::uint32_t value) {
+  *out++ = static_cast<char>('0' + value / 100000000U);
+  value %= 100000000U;
+  out = writeTwoDigits(out, value / 1000000U);
+  out = writeTwoDigits(out, (value / 10000U) % 100U);
+  out = writeTwoDigits(out, (value / 100U) % 100U);
+  return writeTwoDigits(out, value % 100U);
+}
+
+inline std::int64_t floorDivide(std::int64_t value, std::int64_t divisor) {
+  const std::int64_t quotient = value / divisor;
+  return (value % divisor < 0) ? quotient - 1 : quotient;
+}
+}  // namespace
+
+equinox::TimestampProducer::TimestampProducer()
+    : mZone_(LoggerOptions{}.timestampZone),
+      mPrecision_(LoggerOptions{}.timestampPrecision),
+      mIsCacheValid_(false),
+      mCachedSecond_(0),
+      mCachedZone_(LoggerOptions{}.timestampZone),
+      mCachedOffsetMinute_(0),
+      mUtcOffsetSeconds_(0),
+      mCachedPrefix_{},
+      mCachedSuffix_{},
+      mCachedSuffixLength_(0U) {}
+
+std::size_t equinox::TimestampProducer::formatTimestamp(std::int64_t timestampNs, char* buffer) {
+  const std::int64_t seconds = floorDivide(timestampNs, kNanosecondsPerSecond);
+  const auto subSecondNs = static_cast<std::uint32_t>(timestampNs - seconds * kNanosecondsPerSecond);
+  const timestamp_format::ZONE zone = mZone_.load(std::memory_order_relaxed);
+  if (!mIsCacheValid_ || seconds != mCachedSecond_ || zone != mCachedZone_) {
+    updateCachedSecond(seconds, zone);
+  }
+
+  char* out = buffer;
+  std::memcpy(out, mCachedPrefix_, kCachedPrefixLength);
+  out += kCachedPrefixLength;
+  if (mPrecision_.load(std::memory_order_relaxed) == timestamp_format::PRECISION::nanoseconds) {
+    out = writeNineDigits(out, subSecondNs);
+  } else {
+    out = writeSixDigits(out, subSecondNs / 1000U);
+  }
+  std::memcpy(out, mCachedSuffix_, mCachedSuffixLength_);
+  out += mCachedSuffixLength_;
+  return static_cast<std::size_t>(out - buffer);
+}
+
+void equinox::TimestampProducer::setFormat(timestamp_format::ZONE zone, timestamp_format::PRECISION precision) {
+  mZone_.store(zone, std::memory_order_relaxed);
+  mPrecision_.store(precision, std::memory_order_relaxed);
+}
+
+long equinox::TimestampProducer::getLocalUtcOffsetSeconds(std::time_t seconds) const {
+  std::tm localTime{};
+  if (localtime_r(&seconds, &localTime) == nullptr) {
+    return 0;
+  }
+  return localTime.tm_gmtoff;
+}
+
+void equinox::TimestampProducer::updateCachedSecond(std::int64_t seconds, timestamp_format::ZONE zone) {
+  long utcOffsetSeconds = 0;
+  if (zone == timestamp_format::ZONE::local) {
+    /* Time zone transitions happen on whole minutes, the offset does not have to be looked up every second */
+    const std::int64_t minute = floorDivide(seconds, kSecondsPerMinute);
+    if (!mIsCacheValid_ || mCachedZone_ != zone || minute != mCachedOffsetMinute_) {
+      mUtcOffsetSeconds_ = getLocalUtcOffsetSeconds(static_cast<std::time_t>(seconds));
+      mCachedOffsetMinute_ = minute;
+    }
+    utcOffsetSeconds = mUtcOffsetSeconds_;
+  }
+
+  const std::time_t shiftedSeconds = static_cast<std::time_t>(seconds + utcOffsetSeconds);
+  std::tm dateTime{};
+  gmtime_r(&shiftedSeconds, &dateTime);
+  const auto year = static_cast<std::uint32_t>(dateTime.tm_year + 1900) % 10000U;
+
+  char* out = mCachedPrefix_;
+  *out++ = '[';
+  out = writeTwoDigits(out, year / 100U);
+  out = writeTwoDigits(out, year % 100U);
+  *out++ = '-';
+  out = writeTwoDigits(out, static_cast<std::uint32_t>(dateTime.tm_mon + 1));
+  *out++ = '-';
+  out = writeTwoDigits(out, static_cast<std::uint32_t>(dateTime.tm_mday));
+  *out++ = 'T';
+  out = writeTwoDigits(out, static_cast<std::uint32_t>(dateTime.tm_hour));
+  *out++ = ':';
+  out = writeTwoDigits(out, static_cast<std::uint32_t>(dateTime.tm_min));
+  *out++ = ':';
+  out = writeTwoDigits(out, static_cast<std::uint32_t>(dateTime.tm_sec));
+  *out++ = '.';
+
+  out = mCachedSuffix_;
+  if (zone == timestamp_format::ZONE::utc) {
+    *out++ = 'Z';
+  } else {
+    const long absoluteOffsetMinutes = ((utcOffsetSeconds < 0) ? -utcOffsetSeconds : utcOffsetSeconds) / kSecondsPerMinute;
+    *out++ = (utcOffsetSeconds < 0) ? '-' : '+';
+    out = writeTwoDigits(out, static_cast<std::uint32_t>(absoluteOffsetMinutes / 60) % 100U);
+    *out++ = ':';
+    out = writeTwoDigits(out, static_cast<std::uint32_t>(absoluteOffsetMinutes % 60));
+  }
+  *out++ = ']';
+  mCachedSuffixLength_ = static_cast<std::size_t>(out - mCachedSuffix_);
 
-  return mTimestamp_;
+  mCachedSecond_ = seconds;
+  mCachedZone_ = zone;
+  mIsCacheValid_ = true;
 }
@@ -0,0 +1,516 @@
+/*
+ * UringLogWriter.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define EQUINOX_HAS_IO_URING
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "UringLogWriter.h"
+
+namespace {
+/* Room for every buffer in flight plus the syncs queued behind them */
+static constexpr unsigned kRingEntries = 16U;
+static constexpr std::uint64_t kSyncUserData = ~std::uint64_t{0};
+/* Index of the log file in the registered files table */
+static constexpr int kRegisteredFileIndex = 0;
+
+std::int64_t steadyClockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef EQUINOX_HAS_IO_URING
+int ioUringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int ringFd, unsigned opcode, const void* arguments, unsigned argumentsCount) {
+    return static_cast<int>(syscall(__NR_io_uring_register, ringFd, opcode, arguments, argumentsCount));
+}
+#endif
+}  // namespace
+
+equinox::UringLogWriter::UringLogWriter(FileWriteLatency& fileWriteLatency)
+    : mFileWriteLatency_{fileWriteLatency},
+      mRingFd_{-1},
+      mRingUnavailable_{false},
+      mSqRing_{nullptr},
+      mSqRingSize_{0U},
+      mCqRing_{nullptr},
+      mCqRingSize_{0U},
+      mSqes_{nullptr},
+      mSqesSize_{0U},
+      mSqHead_{nullptr},
+      mSqTail_{nullptr},
+      mSqMask_{0U},
+      mSqArray_{nullptr},
+      mCqHead_{nullptr},
+      mCqTail_{nullptr},
+      mCqMask_{0U},
+      mCqes_{nullptr},
+      mBuffers_{},
+      mBufferStates_{},
+      mSyncSubmitNs_{},
+      mOperationsInFlight_{0U},
+      mSyncsSubmitted_{0U},
+      mSyncsCompleted_{0U},
+      mLastSyncFailed_{false},
+      mFd_{-1},
+      mOffset_{0U},
+      mLostBytes_{0U} {}
+
+equinox::UringLogWriter::~UringLogWriter() {
+    close();
+    teardownRing();
+}
+
+bool equinox::UringLogWriter::isAvailable() {
+    return (mRingFd_ >= 0) or setupRing();
+}
+
+bool equinox::UringLogWriter::open(const std::string& fileName, bool truncate) {
+    if (!isAvailable()) {
+        return false;
+    }
+
+#ifdef EQUINOX_HAS_IO_URING
+    /* The open file keeps taking the writes when this one fails */
+    const int fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+    if (fd < 0) {
+        std::cerr << "[EquinoxLogger] Failed to open log file: " << fileName << " - " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    /* The writes in flight complete into the open file, the new one then takes its registered slot.
+     * The slot is updated in place so the open file keeps taking the writes when this fails */
+    waitForOperations();
+    if (!registerFile(fd)) {
+        std::cerr << "[EquinoxLogger] Failed to register log file with io_uring: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+        ::close(fd);  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+    if (isOpen()) {
+        releaseFile();
+    }
+    mFd_ = fd;
+
+    /* Writes carry explicit offsets so several can be in flight, the first one goes after the existing lines */
+    const off_t fileEnd = ::lseek(mFd_, 0, SEEK_END);
+    mOffset_ = (fileEnd > 0) ? static_cast<std::uint64_t>(fileEnd) : 0U;
+    return true;
+#else
+    (void)fileName;
+    (void)truncate;
+    return false;
+#endif
+}
+
+bool equinox::UringLogWriter::isOpen() const {
+    return mFd_ >= 0;
+}
+
+bool equinox::UringLogWriter::setupRing() {
+#ifdef EQUINOX_HAS_IO_URING
+    if (mRingUnavailable_) {
+        return false;
+    }
+
+    io_uring_params params{};
+    mRingFd_ = ioUringSetup(kRingEntries, &params);
+    if (mRingFd_ < 0) {
+        mRingUnavailable_ = true;
+        return false;
+    }
+
+    mSqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    mCqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0U;
+    if (singleMapping) {
+        mSqRingSize_ = mCqRingSize_ = std::max(mSqRingSize_, mCqRingSize_);
+    }
+
+    mSqRing_ = ::mmap(nullptr, mSqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd_, IORING_OFF_SQ_RING);
+    mCqRing_ = singleMapping ? mSqRing_ : ::mmap(nullptr, mCqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd_, IORING_OFF_CQ_RING);
+    mSqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    mSqes_ = ::mmap(nullptr, mSqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd_, IORING_OFF_SQES);
+    if (mSqRing_ == MAP_FAILED or mCqRing_ == MAP_FAILED or mSqes_ == MAP_FAILED) {
+        teardownRing();  // LCOV_EXCL_LINE
+        mRingUnavailable_ = true;  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+
+    char* sqRing = static_cast<char*>(mSqRing_);
+    char* cqRing = static_cast<char*>(mCqRing_);
+    mSqHead_ = reinterpret_cast<unsigned*>(sqRing + params.sq_off.head);
+    mSqTail_ = reinterpret_cast<unsigned*>(sqRing + params.sq_off.tail);
+    mSqMask_ = *reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_mask);
+    mSqArray_ = reinterpret_cast<unsigned*>(sqRing + params.sq_off.array);
+    mCqHead_ = reinterpret_cast<unsigned*>(cqRing + params.cq_off.head);
+    mCqTail_ = reinterpret_cast<unsigned*>(cqRing + params.cq_off.tail);
+    mCqMask_ = *reinterpret_cast<unsigned*>(cqRing + params.cq_off.ring_mask);
+    mCqes_ = cqRing + params.cq_off.cqes;
+
+    /* Registered once, the kernel does not map the pages for every write */
+    mBuffers_ = std::make_unique<char[]>(kBufferCount * kBufferBytes);
+    iovec bufferVectors[kBufferCount];
+    for (std::size_t bufferIndex = 0; bufferIndex < kBufferCount; ++bufferIndex) {
+        bufferVectors[bufferIndex].iov_base = mBuffers_.get() + bufferIndex * kBufferBytes;
+        bufferVectors[bufferIndex].iov_len = kBufferBytes;
+        mBufferStates_[bufferIndex] = BufferState{false, 0U, 0U, 0};
+    }
+    if (ioUringRegister(mRingFd_, IORING_REGISTER_BUFFERS, bufferVectors, kBufferCount) != 0) {
+        std::cerr << "[EquinoxLogger] Failed to register io_uring buffers: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+        teardownRing();  // LCOV_EXCL_LINE
+        mRingUnavailable_ = true;  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+    return true;
+#else
+    mRingUnavailable_ = true;
+    return false;
+#endif
+}
+
+void equinox::UringLogWriter::teardownRing() {
+    if (mSqes_ != nullptr and mSqes_ != MAP_FAILED) {
+        ::munmap(mSqes_, mSqesSize_);
+    }
+    if (mCqRing_ != nullptr and mCqRing_ != MAP_FAILED and mCqRing_ != mSqRing_) {
+        ::munmap(mCqRing_, mCqRingSize_);
+    }
+    if (mSqRing_ != nullptr and mSqRing_ != MAP_FAILED) {
+        ::munmap(mSqRing_, mSqRingSize_);
+    }
+    mSqes_ = mCqRing_ = mSqRing_ = nullptr;
+    if (mRingFd_ >= 0) {
+        ::close(mRingFd_);
+        mRingFd_ = -1;
+    }
+    mBuffers_.reset();
+}
+
+void* equinox::UringLogWriter::prepareSqe() {
+#ifdef EQUINOX_HAS_IO_URING
+    /* Only this thread produces, the kernel consumes every entry on io_uring_enter() */
+    const unsigned tail = *mSqTail_;
+    const unsigned index = tail & mSqMask_;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(mSqes_) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    mSqArray_[index] = index;
+    __atomic_store_n(mSqTail_, tail + 1U, __ATOMIC_RELEASE);
+    return sqe;
+#else
+    return nullptr;
+#endif
+}
+
+bool equinox::UringLogWriter::submit(unsigned sqeCount) {
+#ifdef EQUINOX_HAS_IO_URING
+    unsigned submitted = 0U;
+    while (submitted < sqeCount) {
+        const int result = ioUringEnter(mRingFd_, sqeCount - submitted, 0U, 0U);
+        if (result < 0) {
+            if (errno == EINTR or errno == EAGAIN) {  // LCOV_EXCL_LINE
+                continue;  // LCOV_EXCL_LINE
+            }
+            std::cerr << "[EquinoxLogger] Failed to submit io_uring writes: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+            return false;  // LCOV_EXCL_LINE
+        }
+        submitted += static_cast<unsigned>(result);
+    }
+    mOperationsInFlight_ += sqeCount;
+    return true;
+#else
+    (void)sqeCount;
+    return false;
+#endif
+}
+
+bool equinox::UringLogWriter::waitForCompletion() {
+#ifdef EQUINOX_HAS_IO_URING
+    while (ioUringEnter(mRingFd_, 0U, 1U, IORING_ENTER_GETEVENTS) < 0) {
+        if (errno != EINTR) {
+            std::cerr << "[EquinoxLogger] Failed to wait for io_uring completions: " << std::strerror(errno) << std::endl;  // LCOV_EXCL_LINE
+            return false;  // LCOV_EXCL_LINE
+        }
+    }
+    reapCompletions();
+    return true;
+#else
+    return false;
+#endif
+}
+
+void equinox::UringLogWriter::reapCompletions() {
+#ifdef EQUINOX_HAS_IO_URING
+    if (mRingFd_ < 0) {
+        return;
+    }
+    unsigned head = *mCqHead_;
+    const unsigned tail = __atomic_load_n(mCqTail_, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        const io_uring_cqe& cqe = static_cast<io_uring_cqe*>(mCqes_)[head & mCqMask_];
+        handleCompletion(cqe.user_data, cqe.res);
+        ++head;
+    }
+    __atomic_store_n(mCqHead_, head, __ATOMIC_RELEASE);
+#endif
+}
+
+void equinox::UringLogWriter::handleCompletion(std::uint64_t userData, std::int32_t result) {
+    --mOperationsInFlight_;
+    const std::int64_t completedNs = steadyClockNs();
+
+    if (userData == kSyncUserData) {
+        ++mSyncsCompleted_;
+        mLastSyncFailed_ = (result < 0);
+        if (mLastSyncFailed_) {
+            std::cerr << "[EquinoxLogger] Failed to sync log file: " << std::strerror(-result) << std::endl;
+            mFileWriteLatency_.recordFailedSync();
+        }
+        if (!mSyncSubmitNs_.empty()) {
+            mFileWriteLatency_.recordSync(static_cast<std::uint64_t>(completedNs - mSyncSubmitNs_.front()));
+            mSyncSubmitNs_.pop_front();
+        }
+        return;
+    }
+
+    BufferState& bufferState = mBufferStates_[static_cast<std::size_t>(userData)];
+    /* A failed write is retried in place, a short one completed, so the file has no gap */
+    const std::size_t written = (result < 0) ? 0U : static_cast<std::size_t>(result);
+    if (written < bufferState.size) {
+        completeWrite(userData, written);
+    }
+    mFileWriteLatency_.recordWrite(static_cast<std::uint64_t>(completedNs - bufferState.submitNs));
+    bufferState.inFlight = false;
+}
+
+void equinox::UringLogWriter::completeWrite(std::uint64_t bufferIndex, std::size_t written) {
+    const BufferState& bufferState = mBufferStates_[static_cast<std::size_t>(bufferIndex)];
+    const char* buffer = mBuffers_.get() + bufferIndex * kBufferBytes;
+    while (written < bufferState.size) {
+        const ssize_t rest = ::pwrite(mFd_, buffer + written, bufferState.size - written, static_cast<off_t>(bufferState.offset + written));
+        if (rest < 0 and errno == EINTR) {
+            continue;  // LCOV_EXCL_LINE
+        }
+        if (rest <= 0) {
+            /* The lines are lost, the later writes already went past them */
+            std::cerr << "[EquinoxLogger] Failed to write to log file: " << std::strerror((rest < 0) ? errno : EIO) << std::endl;
+            mLostBytes_ += bufferState.size - written;
+            mFileWriteLatency_.recordFailedWrite();
+            return;
+        }
+        written += static_cast<std::size_t>(rest);
+    }
+}
+
+int equinox::UringLogWriter::findFreeBuffer() const {
+    for (std::size_t bufferIndex = 0; bufferIndex < kBufferCount; ++bufferIndex) {
+        if (!mBufferStates_[bufferIndex].inFlight) {
+            return static_cast<int>(bufferIndex);
+        }
+    }
+    return -1;
+}
+
+bool equinox::UringLogWriter::write(const char* data, std::size_t size) {
+#ifdef EQUINOX_HAS_IO_URING
+    if (!isOpen()) {
+        return false;
+    }
+
+    reapCompletions();
+    unsigned preparedSqes = 0U;
+    while (size > 0U) {
+        int bufferIndex = findFreeBuffer();
+        if (bufferIndex < 0) {
+            /* Every buffer is in flight, the ones prepared so far have to go first */
+            if (preparedSqes > 0U and !submit(preparedSqes)) {
+                return false;  // LCOV_EXCL_LINE
+            }
+            preparedSqes = 0U;
+            if (!waitForCompletion()) {
+                return false;  // LCOV_EXCL_LINE
+            }
+            continue;
+        }
+
+        const std::size_t chunkSize = std::min(size, kBufferBytes);
+        char* buffer = mBuffers_.get() + static_cast<std::size_t>(bufferIndex) * kBufferBytes;
+        std::memcpy(buffer, data, chunkSize);
+
+        io_uring_sqe* sqe = static_cast<io_uring_sqe*>(prepareSqe());
+        sqe->opcode = IORING_OP_WRITE_FIXED;
+        sqe->flags = IOSQE_FIXED_FILE;
+        sqe->fd = kRegisteredFileIndex;
+        sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+        sqe->len = static_cast<std::uint32_t>(chunkSize);
+        sqe->off = mOffset_;
+        sqe->buf_index = static_cast<std::uint16_t>(bufferIndex);
+        sqe->user_data = static_cast<std::uint64_t>(bufferIndex);
+        mBufferStates_[static_cast<std::size_t>(bufferIndex)] = BufferState{true, mOffset_, chunkSize, steadyClockNs()};
+        ++preparedSqes;
+
+        mOffset_ += chunkSize;
+        data += chunkSize;
+        size -= chunkSize;
+    }
+    return (preparedSqes == 0U) or submit(preparedSqes);
+#else
+    (void)data;
+    (void)size;
+    return false;
+#endif
+}
+
+bool equinox::UringLogWriter::sync() {
+#ifdef EQUINOX_HAS_IO_URING
+    if (!isOpen()) {
+        return false;
+    }
+    while (mOperationsInFlight_ >= kRingEntries) {
+        if (!waitForCompletion()) {
+            return false;  // LCOV_EXCL_LINE
+        }
+    }
+
+    /* IO_DRAIN instead of a link: a link orders it after one write, the drain after every write in flight */
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(prepareSqe());
+    sqe->opcode = IORING_OP_FSYNC;
+    sqe->flags = IOSQE_FIXED_FILE | IOSQE_IO_DRAIN;
+    sqe->fd = kRegisteredFileIndex;
+    sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+    sqe->user_data = kSyncUserData;
+    mSyncSubmitNs_.push_back(steadyClockNs());
+    if (!submit(1U)) {
+        return false;  // LCOV_EXCL_LINE
+    }
+    ++mSyncsSubmitted_;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool equinox::UringLogWriter::syncAndWait() {
+    if (!sync()) {
+        return false;
+    }
+    /* The drain orders the syncs too, the last one completed is this one */
+    const std::uint64_t syncSequence = mSyncsSubmitted_;
+    while (mSyncsCompleted_ < syncSequence) {
+        if (!waitForCompletion()) {
+            return false;  // LCOV_EXCL_LINE
+        }
+    }
+    return !mLastSyncFailed_;
+}
+
+void equinox::UringLogWriter::close() {
+#ifdef EQUINOX_HAS_IO_URING
+    if (!isOpen()) {
+        return;
+    }
+    waitForOperations();
+    ioUringRegister(mRingFd_, IORING_UNREGISTER_FILES, nullptr, 0U);
+    releaseFile();
+#endif
+}
+
+void equinox::UringLogWriter::waitForOperations() {
+#ifdef EQUINOX_HAS_IO_URING
+    while (mOperationsInFlight_ > 0U and waitForCompletion()) {
+    }
+#endif
+}
+
+bool equinox::UringLogWriter::registerFile(int fd) {
+#ifdef EQUINOX_HAS_IO_URING
+    if (!isOpen()) {
+        return ioUringRegister(mRingFd_, IORING_REGISTER_FILES, &fd, 1U) == 0;
+    }
+    io_uring_files_update filesUpdate{};
+    filesUpdate.offset = 0U;
+    filesUpdate.fds = reinterpret_cast<std::uint64_t>(&fd);
+    return ioUringRegister(mRingFd_, IORING_REGISTER_FILES_UPDATE, &filesUpdate, 1U) == 1;
+#else
+    (void)fd;
+    return false;
+#endif
+}
+
+void equinox::UringLogWriter::releaseFile() {
+    ::close(mFd_);
+    mFd_ = -1;
+    mOffset_ = 0U;
+    mLostBytes_ = 0U;
+    mSyncSubmitNs_.clear();
+    mSyncsSubmitted_ = mSyncsCompleted_ = 0U;
+    mLastSyncFailed_ = false;
+}
+
+std::size_t equinox::UringLogWriter::getSize() const {
+    return static_cast<std::size_t>(mOffset_ - mLostBytes_);
+}
+
+int equinox::UringLogWriter::getFd() const {
+    return mFd_;
+}
+
+std::size_t equinox::UringLogWriter::getWritesInFlight() const {
+    return static_cast<std::size_t>(std::count_if(mBufferStates_.begin(), mBufferStates_.end(), [](const BufferState& bufferState) {
+        return bufferState.inFlight;
+    }));
+}
@@ -0,0 +1,96 @@
+/*
+ * WorkerParking.cpp
+ *
+ *  Created on: 2026
+ *      Author: Janusz Wolak
+ */
+
+/*-
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, Janusz Wolak
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+#include "WorkerParking.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) && std::atomic<std::uint32_t>::is_always_lock_free,
+              "The futex word has to be a plain 32-bit integer");
+
+void futexWait(std::atomic<std::uint32_t>& futexWord, std::uint32_t expectedValue) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&futexWord), FUTEX_WAIT_PRIVATE, expectedValue, nullptr, nullptr, 0);
+}
+
+void futexWakeOne(std::atomic<std::uint32_t>& futexWord) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&futexWord), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+}  // namespace
+
+equinox::WorkerParking::WorkerParking() : mWakeUpSequence_(0U), mParked_(false) {}
+
+std::uint32_t equinox::WorkerParking::prepareToPark() {
+    const std::uint32_t ticket = mWakeUpSequence_.load(std::memory_order_acquire);
+    mParked_.store(true, std::memory_order_relaxed);
+    /* Pairs with the fence in notifyIfParked(): either the producer sees the worker parked or the worker sees the message */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return ticket;
+}
+
+void equinox::WorkerParking::park(std::uint32_t ticket) {
+    /* The kernel compares the word before sleeping, a wake-up between the check and the call is not lost */
+    while (mWakeUpSequence_.load(std::memory_order_acquire) == ticket) {
+        futexWait(mWakeUpSequence_, ticket);
+    }
+    mParked_.store(false, std::memory_order_relaxed);
+}
+
+void equinox::WorkerParking::cancelPark() {
+    mParked_.store(false, std::memory_order_relaxed);
+}
+
+void equinox::WorkerParking::notifyIfParked() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    /* Only the first producer after the worker parked makes the system call */
+    if (mParked_.load(std::memory_order_relaxed) && mParked_.exchange(false, std::memory_order_relaxed)) {
+        wakeUp();
+    }
+}
+
+void equinox::WorkerParking::wakeUp() {
+    mWakeUpSequence_.fetch_add(1U, std::memory_order_release);
+    futexWakeOne(mWakeUpSequence_);
+}
+
+std::uint32_t equinox::WorkerParking::getWakeUpsCount() const {
+    return mWakeUpSequence_.load(std::memory_order_acquire);
+}
@@ -39,10 +39,16 @@
 namespace mocks {
     class AsyncLogQueueEngineMock : public equinox::IAsyncLogQueueEngine {
        public:
-        MOCK_METHOD(void, processLogMessage, (const std::string& messageToProcess), (override));
+        MOCK_METHOD(bool, processLogMessage,
+                    (equinox::level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, std::string_view messageToProcess, bool nonBlocking), (override));
+        MOCK_METHOD(bool, processDeferredLogMessage,
+                    (equinox::level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, const std::string& encodedMessage, bool nonBlocking), (override));
+        MOCK_METHOD(std::uint64_t, getDroppedMessagesCount, (equinox::level::LOG_LEVEL msgLevel), (override));
         MOCK_METHOD(void, stopWorker, (), (override));
         MOCK_METHOD(void, startWorkerIfNeeded, (), (override));
         MOCK_METHOD(void, setLogsOutputSink, (equinox::logs_output::SINK logsOutputSink), (override));
+        MOCK_METHOD(void, setLogPrefix, (const std::string& logPrefix), (override));
+        MOCK_METHOD(void, configureQueue, (const equinox::LoggerOptions& options), (override));
         MOCK_METHOD(void, flush, (), (override));
     };
 }  // namespace mocks
\ No newline at end of file
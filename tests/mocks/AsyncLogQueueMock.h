@@ -39,7 +39,10 @@
 namespace mocks {
 class AsyncLogQueueMock : public equinox::IAsyncLogQueue {
  public:
-  MOCK_METHOD(void, enqueue, (const std::string& log_message), (override));
+  MOCK_METHOD(bool, enqueue, (const std::string& log_message), (override));
+  MOCK_METHOD(bool, tryEnqueue, (const std::string& log_message), (override));
+  MOCK_METHOD(void, setOverflowPolicy, (equinox::overflow::POLICY policy, uint32_t block_timeout_ms, const equinox::LogRecordVisitor& dropped_record_visitor),
+              (override));
   MOCK_METHOD(bool, dequeue, (std::vector<std::string> & out, size_t max_batch_size, uint32_t timeout_ms), (override));
   MOCK_METHOD(void, stop, (), (override));
 };
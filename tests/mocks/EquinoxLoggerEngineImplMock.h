@@ -39,12 +39,17 @@
 namespace mocks {
     class EquinoxLoggerEngineImplMock : public equinox::IEquinoxLoggerEngineImpl {
        public:
-        MOCK_METHOD(void, logMessage, (equinox::level::LOG_LEVEL msgLevel, const std::string& formatedOutputMessage), (override));
+        MOCK_METHOD(bool, logMessage, (equinox::level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, std::string_view formatedOutputMessage, bool nonBlocking),
+                    (override));
+        MOCK_METHOD(bool, logDeferredMessage, (equinox::level::LOG_LEVEL msgLevel, std::uint32_t callSiteId, const std::string& encodedMessage, bool nonBlocking),
+                    (override));
+        MOCK_METHOD(std::uint64_t, getDroppedMessagesCount, (equinox::level::LOG_LEVEL msgLevel), (override));
+        MOCK_METHOD(equinox::FileWriteStats, getFileWriteStats, (), (override));
         MOCK_METHOD(bool, setup,
-                    (equinox::level::LOG_LEVEL logLevel, const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink,
-                     const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles),
+                    (const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink, const std::string& logFileName, std::size_t maxLogFileSizeBytes,
+                     std::size_t maxLogFiles),
                     (override));
-        MOCK_METHOD(void, changeLevel, (equinox::level::LOG_LEVEL logLevel), (override));
+        MOCK_METHOD(bool, setup, (const std::string& logPrefix, equinox::logs_output::SINK logsOutputSink, const equinox::LoggerOptions& options), (override));
         MOCK_METHOD(bool, changeLogsOutputSink, (equinox::logs_output::SINK logsOutputSink), (override));
         MOCK_METHOD(void, flush, (), (override));
     };
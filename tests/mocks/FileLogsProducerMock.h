@@ -39,8 +39,16 @@
 namespace mocks {
     class FileLogsProducerMock : public equinox::IFileLogsProducer {
        public:
-        MOCK_METHOD(void, setupFile, (const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles), (override));
-        MOCK_METHOD(void, logMessage, (const std::string& messageToLog), (override));
+        MOCK_METHOD(int, setupFile, (const std::string& logFileName, std::size_t maxLogFileSizeBytes, std::size_t maxLogFiles), (override));
+        MOCK_METHOD(void, setLogPrefix, (const std::string& logPrefix), (override));
+        MOCK_METHOD(void, setDurability, (equinox::file_durability::MODE durabilityMode, std::uint32_t syncIntervalMs, std::size_t syncBytes), (override));
+        MOCK_METHOD(void, setIoBackend, (equinox::file_io::BACKEND ioBackend), (override));
+        MOCK_METHOD(void, setPageCacheMode, (equinox::file_page_cache::MODE pageCacheMode), (override));
+        MOCK_METHOD(void, setCompression, (equinox::file_compression::MODE compressionMode), (override));
+        MOCK_METHOD(void, setRotationPeriod, (equinox::file_rotation::PERIOD rotationPeriod, equinox::timestamp_format::ZONE rotationZone), (override));
+        MOCK_METHOD(void, logMessage, (const std::string& messageToLog, const equinox::LogRecordMetadata& metadata), (override));
         MOCK_METHOD(void, flush, (), (override));
+        MOCK_METHOD(std::optional<std::uint32_t>, getSyncDelayMs, (), (const, override));
+        MOCK_METHOD(equinox::FileWriteStats, getWriteStats, (), (const, override));
     };
 }  // namespace mocks
\ No newline at end of file
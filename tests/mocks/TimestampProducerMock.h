@@ -34,12 +34,21 @@
 
 #include <gmock/gmock.h>
 
+#include <cstring>
+#include <string_view>
+
 #include "ITimestampProducer.h"
 
 namespace mocks {
     class TimestampProducerMock : public equinox::ITimestampProducer {
        public:
-        MOCK_CONST_METHOD0(getTimestamp, std::string());
-        MOCK_METHOD0(getTimestampInUs, std::string());
+        MOCK_METHOD(std::size_t, formatTimestamp, (std::int64_t timestampNs, char* buffer), (override));
+        MOCK_METHOD(void, setFormat, (equinox::timestamp_format::ZONE zone, equinox::timestamp_format::PRECISION precision), (override));
     };
+
+    /* Action for formatTimestamp(): writes the given text as the timestamp */
+    ACTION_P(WriteTimestamp, timestamp) {
+        std::memcpy(arg1, std::string_view(timestamp).data(), std::string_view(timestamp).size());
+        return std::string_view(timestamp).size();
+    }
 }  // namespace mocks
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "AdaptiveBatchSize.h"
+
+namespace adaptive_batch_size_test {
+    namespace {
+        constexpr std::size_t kTestMinBatchSize = 4;
+        constexpr std::size_t kTestMaxBatchSize = 32;
+    }  // namespace
+
+    TEST(AdaptiveBatchSizeTest, Fixed_Mode_Always_Uses_Max_Batch_Size) {
+        equinox::AdaptiveBatchSize batchSize{kTestMinBatchSize, kTestMaxBatchSize, false};
+
+        batchSize.update(0U);
+        EXPECT_EQ(batchSize.get(), kTestMaxBatchSize);
+        batchSize.update(kTestMaxBatchSize);
+        EXPECT_EQ(batchSize.get(), kTestMaxBatchSize);
+    }
+
+    TEST(AdaptiveBatchSizeTest, Adaptive_Mode_Grows_On_Full_Batches_Up_To_Max) {
+        equinox::AdaptiveBatchSize batchSize{kTestMinBatchSize, kTestMaxBatchSize, true};
+        ASSERT_EQ(batchSize.get(), kTestMinBatchSize);
+
+        for (int i = 0; i < 10; ++i) {
+            batchSize.update(batchSize.get());
+        }
+        EXPECT_EQ(batchSize.get(), kTestMaxBatchSize);
+    }
+
+    TEST(AdaptiveBatchSizeTest, Adaptive_Mode_Shrinks_When_Idle_Down_To_Min_And_Keeps_Size_In_Between) {
+        equinox::AdaptiveBatchSize batchSize{kTestMinBatchSize, kTestMaxBatchSize, true};
+        batchSize.update(4U);
+        batchSize.update(8U);
+        ASSERT_EQ(batchSize.get(), 16U);
+
+        batchSize.update(10U);
+        EXPECT_EQ(batchSize.get(), 16U);
+
+        for (int i = 0; i < 10; ++i) {
+            batchSize.update(0U);
+        }
+        EXPECT_EQ(batchSize.get(), kTestMinBatchSize);
+    }
+
+    TEST(AdaptiveBatchSizeTest, Configure_Switches_Mode_And_Max_Below_Min_Wins) {
+        equinox::AdaptiveBatchSize batchSize{kTestMinBatchSize, kTestMaxBatchSize, false};
+
+        batchSize.configure(2U, true);
+        EXPECT_EQ(batchSize.get(), 2U);
+        batchSize.update(2U);
+        EXPECT_EQ(batchSize.get(), 2U);
+
+        batchSize.configure(0U, false);
+        EXPECT_EQ(batchSize.get(), 1U);
+    }
+
+}  // namespace adaptive_batch_size_test
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "EquinoxLogger.h"
+#include "EquinoxLoggerEngine.h"
+#include "PerThreadLogQueue.h"
+
+namespace {
+    std::atomic<bool> gCountAllocations{false};
+    std::atomic<std::size_t> gAllocationsCounter{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+    if (gCountAllocations.load(std::memory_order_relaxed)) {
+        gAllocationsCounter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace allocation_free_log_test {
+    using namespace equinox;
+
+    namespace {
+        constexpr int kNumberOfCalls = 1000;
+        constexpr char const* kLongFormat = "Format string well above the small string optimization limit: %d %s %f";
+
+        class LogCallsCounterEngineImpl : public IEquinoxLoggerEngineImpl {
+           public:
+            bool logMessage(level::LOG_LEVEL, std::uint32_t, std::string_view, bool) override {
+                ++logMessageCalls;
+                return true;
+            }
+            bool logDeferredMessage(level::LOG_LEVEL, std::uint32_t, const std::string&, bool) override {
+                ++logDeferredMessageCalls;
+                return true;
+            }
+            std::uint64_t getDroppedMessagesCount(level::LOG_LEVEL) override { return 0U; }
+            FileWriteStats getFileWriteStats() override { return FileWriteStats{}; }
+            bool setup(const std::string&, logs_output::SINK, const std::string&, std::size_t, std::size_t) override { return true; }
+            bool setup(const std::string&, logs_output::SINK, const LoggerOptions&) override { return true; }
+            bool changeLogsOutputSink(logs_output::SINK) override { return true; }
+            void flush() override {}
+
+            int logMessageCalls = 0;
+            int logDeferredMessageCalls = 0;
+        };
+
+        class AllocationsCounter {
+           public:
+            AllocationsCounter() {
+                gAllocationsCounter.store(0, std::memory_order_relaxed);
+                gCountAllocations.store(true, std::memory_order_relaxed);
+            }
+            ~AllocationsCounter() { gCountAllocations.store(false, std::memory_order_relaxed); }
+
+            std::size_t count() const { return gAllocationsCounter.load(std::memory_order_relaxed); }
+        };
+    }  // namespace
+
+    class EquinoxLoggerEngineTestable : public EquinoxLoggerEngine {
+       public:
+        EquinoxLoggerEngineTestable(std::unique_ptr<IEquinoxLoggerEngineImpl> mEquinoxLoggerEngineImpl)
+            : EquinoxLoggerEngine(std::move(mEquinoxLoggerEngineImpl)) {}
+    };
+
+    class AllocationFreeLogTest : public ::testing::Test {
+       public:
+        AllocationFreeLogTest()
+            : log_calls_counter_engine_impl{new LogCallsCounterEngineImpl()},
+              equinox_logger_engine{std::unique_ptr<IEquinoxLoggerEngineImpl>(log_calls_counter_engine_impl)} {}
+
+        LogCallsCounterEngineImpl* log_calls_counter_engine_impl;
+        EquinoxLoggerEngineTestable equinox_logger_engine;
+    };
+
+    TEST_F(AllocationFreeLogTest, Log_With_String_Literal_Format_Does_Not_Allocate) {
+        std::size_t allocations = 0;
+        {
+            AllocationsCounter allocationsCounter;
+            for (int i = 0; i < kNumberOfCalls; ++i) {
+                equinox_logger_engine.log(level::LOG_LEVEL::info, "Format string well above the small string optimization limit: %d %s", i, "text");
+            }
+            allocations = allocationsCounter.count();
+        }
+
+        EXPECT_EQ(allocations, 0U);
+        EXPECT_EQ(log_calls_counter_engine_impl->logMessageCalls, kNumberOfCalls);
+    }
+
+    TEST_F(AllocationFreeLogTest, Log_With_Not_Null_Terminated_String_View_Format_Does_Not_Allocate_After_First_Call) {
+        const std::string_view format = std::string_view(kLongFormat).substr(0, std::string_view(kLongFormat).find(" %s"));
+        equinox_logger_engine.log(level::LOG_LEVEL::info, format, 0);
+
+        std::size_t allocations = 0;
+        {
+            AllocationsCounter allocationsCounter;
+            for (int i = 0; i < kNumberOfCalls; ++i) {
+                equinox_logger_engine.log(level::LOG_LEVEL::info, format, i);
+            }
+            allocations = allocationsCounter.count();
+        }
+
+        EXPECT_EQ(allocations, 0U);
+        EXPECT_EQ(log_calls_counter_engine_impl->logMessageCalls, kNumberOfCalls + 1);
+    }
+
+    TEST_F(AllocationFreeLogTest, Log_In_Deferred_Mode_Does_Not_Allocate_After_First_Call) {
+        equinox_logger_engine.changeFormattingMode(formatting::MODE::deferred);
+        equinox_logger_engine.log(level::LOG_LEVEL::info, kLongFormat, 0, "text", 1.5);
+
+        std::size_t allocations = 0;
+        {
+            AllocationsCounter allocationsCounter;
+            for (int i = 0; i < kNumberOfCalls; ++i) {
+                equinox_logger_engine.log(level::LOG_LEVEL::info, kLongFormat, i, "text", 1.5);
+            }
+            allocations = allocationsCounter.count();
+        }
+
+        EXPECT_EQ(allocations, 0U);
+        EXPECT_EQ(log_calls_counter_engine_impl->logDeferredMessageCalls, kNumberOfCalls + 1);
+    }
+
+    TEST(AllocationFreeLogApiTest, Suppressed_Call_Through_Public_Api_Does_Not_Allocate) {
+        equinox::changeLevel(level::LOG_LEVEL::error);
+
+        std::size_t allocations = 0;
+        {
+            AllocationsCounter allocationsCounter;
+            for (int i = 0; i < kNumberOfCalls; ++i) {
+                equinox::info("Format string well above the small string optimization limit: %d", i);
+                equinox::debug(std::string_view(kLongFormat), i, "text", 1.5);
+            }
+            allocations = allocationsCounter.count();
+        }
+
+        EXPECT_EQ(allocations, 0U);
+    }
+
+    TEST(AllocationFreeLogQueueTest, Enqueue_To_Per_Thread_Queue_Does_Not_Allocate_After_First_Lap) {
+        constexpr std::size_t kRingCapacity = 64U;
+        PerThreadLogQueue perThreadLogQueue{kRingCapacity};
+        const std::string message{kLongFormat};
+        std::vector<std::string> dequeued;
+        dequeued.reserve(kRingCapacity);
+        for (std::size_t i = 0; i < kRingCapacity; ++i) {
+            perThreadLogQueue.enqueue(message);
+        }
+        perThreadLogQueue.dequeue(dequeued, kRingCapacity, 0U);
+
+        std::size_t allocations = 0;
+        {
+            AllocationsCounter allocationsCounter;
+            for (std::size_t i = 0; i < kRingCapacity; ++i) {
+                perThreadLogQueue.enqueue(message);
+            }
+            allocations = allocationsCounter.count();
+        }
+
+        EXPECT_EQ(allocations, 0U);
+        EXPECT_EQ(dequeued.size(), kRingCapacity);
+        EXPECT_EQ(dequeued.front(), message);
+    }
+
+}  // namespace allocation_free_log_test
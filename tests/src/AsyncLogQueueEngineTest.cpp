@@ -31,8 +31,20 @@
  */
 
 #include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "AsyncLogQueueEngine.h"
+#include "FileLogsProducerMock.h"
 
 namespace async_log_queue_engine_test {
 
@@ -44,10 +56,317 @@ class AsyncLogQueueEngineTastable : public equinox::AsyncLogQueueEngine {
       : AsyncLogQueueEngine(timestamp_procducer, std::move(consoleLogsProducer), std::move(fileLogsProducer), logsOutputSink, std::move(logMessageQueue)) {}
 };
 
+/* Keeps every message written by the worker and its metadata */
+class ConsoleLogsProducerStub : public equinox::IConsoleLogsProducer {
+ public:
+  explicit ConsoleLogsProducerStub(std::vector<std::string>& writtenMessages, std::vector<equinox::LogRecordMetadata>& writtenMetadata,
+                                   std::size_t& flushedMessagesCount, std::mutex& writtenMessagesMutex)
+      : mWrittenMessages_(writtenMessages),
+        mWrittenMetadata_(writtenMetadata),
+        mFlushedMessagesCount_(flushedMessagesCount),
+        mWrittenMessagesMutex_(writtenMessagesMutex) {}
+
+  void setLogPrefix(const std::string& /*logPrefix*/) override {}
+  void setFlushIntervalMs(std::uint32_t /*flushIntervalMs*/) override {}
+  void logMessage(const std::string& message, const equinox::LogRecordMetadata& metadata) override {
+    std::lock_guard<std::mutex> lock(mWrittenMessagesMutex_);
+    mWrittenMessages_.push_back(message);
+    mWrittenMetadata_.push_back(metadata);
+  }
+  void flush() override {
+    std::lock_guard<std::mutex> lock(mWrittenMessagesMutex_);
+    mFlushedMessagesCount_ = mWrittenMessages_.size();
+  }
+
+ private:
+  std::vector<std::string>& mWrittenMessages_;
+  std::vector<equinox::LogRecordMetadata>& mWrittenMetadata_;
+  std::size_t& mFlushedMessagesCount_;
+  std::mutex& mWrittenMessagesMutex_;
+};
+
+namespace {
+constexpr size_t kTestQueueMaxSize = 2;
+constexpr std::uint32_t kTestCallSiteId = 7U;
+}  // namespace
+
 class AsyncLogQueueEngineTest : public ::testing::Test {
  public:
-  AsyncLogQueueEngineTest() {}
+  AsyncLogQueueEngineTest()
+      : async_log_queue_engine{nullptr, std::make_unique<ConsoleLogsProducerStub>(writtenMessages, writtenMetadata, flushedMessagesCount, writtenMessagesMutex),
+                               std::make_unique<::testing::NiceMock<mocks::FileLogsProducerMock>>(), equinox::logs_output::SINK::console,
+                               std::make_unique<equinox::AsyncLogQueue>(kTestQueueMaxSize)} {}
+
+  std::vector<std::string> waitForWrittenMessages(size_t count) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+      {
+        std::lock_guard<std::mutex> lock(writtenMessagesMutex);
+        if (writtenMessages.size() >= count) {
+          return writtenMessages;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::lock_guard<std::mutex> lock(writtenMessagesMutex);
+    return writtenMessages;
+  }
 
-  // AsyncLogQueueEngineTastable async_log_queue_engine;
+  std::vector<std::string> writtenMessages;
+  std::vector<equinox::LogRecordMetadata> writtenMetadata;
+  std::size_t flushedMessagesCount = 0U;
+  std::mutex writtenMessagesMutex;
+  AsyncLogQueueEngineTastable async_log_queue_engine;
 };
-}  // namespace async_log_queue_engine_test
\ No newline at end of file
+
+TEST_F(AsyncLogQueueEngineTest, Drop_Newest_Policy_Counts_Dropped_Messages_Per_Level_And_Worker_Writes_Gap_Marker) {
+  equinox::LoggerOptions options;
+  options.overflowPolicy = equinox::overflow::POLICY::drop_newest;
+  async_log_queue_engine.configureQueue(options);
+
+  EXPECT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, "First", false));
+  EXPECT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, "Second", false));
+  EXPECT_FALSE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, "Third", false));
+  EXPECT_FALSE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::error, kTestCallSiteId, "Fourth", true));
+
+  EXPECT_EQ(async_log_queue_engine.getDroppedMessagesCount(equinox::level::LOG_LEVEL::info), 1U);
+  EXPECT_EQ(async_log_queue_engine.getDroppedMessagesCount(equinox::level::LOG_LEVEL::error), 1U);
+
+  async_log_queue_engine.startWorkerIfNeeded();
+  const std::vector<std::string> messages = waitForWrittenMessages(3);
+  async_log_queue_engine.stopWorker();
+
+  ASSERT_EQ(messages.size(), 3U);
+  EXPECT_EQ(messages[0], "[EquinoxLogger] 2 log messages dropped, the queue was full");
+  EXPECT_EQ(writtenMetadata[0].level, equinox::level::LOG_LEVEL::warning);
+  EXPECT_EQ(messages[1], "First");
+  EXPECT_EQ(messages[2], "Second");
+}
+
+TEST_F(AsyncLogQueueEngineTest, Sinks_Get_Level_Thread_And_Call_Site_From_Record_Header) {
+  const std::string messageWithOtherLevelTag = "[ERROR] is only text here";
+  EXPECT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::debug, kTestCallSiteId, messageWithOtherLevelTag, false));
+  EXPECT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::critical, kTestCallSiteId + 1U, "Second", false));
+
+  async_log_queue_engine.startWorkerIfNeeded();
+  const std::vector<std::string> messages = waitForWrittenMessages(2);
+  async_log_queue_engine.stopWorker();
+
+  ASSERT_EQ(messages.size(), 2U);
+  std::lock_guard<std::mutex> lock(writtenMessagesMutex);
+  EXPECT_EQ(messages[0], messageWithOtherLevelTag);
+  EXPECT_EQ(writtenMetadata[0].level, equinox::level::LOG_LEVEL::debug);
+  EXPECT_EQ(writtenMetadata[0].callSiteId, kTestCallSiteId);
+  EXPECT_EQ(writtenMetadata[0].threadId, static_cast<std::uint32_t>(gettid()));
+  EXPECT_EQ(writtenMetadata[1].level, equinox::level::LOG_LEVEL::critical);
+  EXPECT_EQ(writtenMetadata[1].callSiteId, kTestCallSiteId + 1U);
+}
+
+TEST_F(AsyncLogQueueEngineTest, Worker_Flushes_Console_Lines_When_Queue_Is_Drained_Without_Waiting_For_Timeout) {
+  equinox::LoggerOptions options;
+  options.overflowPolicy = equinox::overflow::POLICY::block;
+  options.dequeueTimeoutMs = 60000U;
+  async_log_queue_engine.configureQueue(options);
+  async_log_queue_engine.startWorkerIfNeeded();
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, "First", false));
+  EXPECT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, "Second", false));
+  bool flushed = false;
+  while (!flushed && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::lock_guard<std::mutex> lock(writtenMessagesMutex);
+    flushed = (flushedMessagesCount == 2U);
+  }
+  async_log_queue_engine.stopWorker();
+
+  EXPECT_TRUE(flushed);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST_F(AsyncLogQueueEngineTest, Parked_Worker_Flushes_File_Again_Once_Periodic_Sync_Is_Due) {
+  auto fileLogsProducer = std::make_unique<::testing::NiceMock<mocks::FileLogsProducerMock>>();
+  mocks::FileLogsProducerMock& fileLogsProducerMock = *fileLogsProducer;
+  std::atomic<std::size_t> flushesCount{0U};
+  ON_CALL(fileLogsProducerMock, flush()).WillByDefault([&flushesCount]() { ++flushesCount; });
+  EXPECT_CALL(fileLogsProducerMock, getSyncDelayMs())
+      .WillOnce(::testing::Return(std::optional<std::uint32_t>(1U)))
+      .WillRepeatedly(::testing::Return(std::nullopt));
+  AsyncLogQueueEngineTastable file_log_queue_engine{
+      nullptr, std::make_unique<ConsoleLogsProducerStub>(writtenMessages, writtenMetadata, flushedMessagesCount, writtenMessagesMutex),
+      std::move(fileLogsProducer), equinox::logs_output::SINK::file, std::make_unique<equinox::AsyncLogQueue>(kTestQueueMaxSize)};
+  equinox::LoggerOptions options;
+  options.workerWaitStrategy = equinox::worker_wait::STRATEGY::blocking;
+  file_log_queue_engine.configureQueue(options);
+  file_log_queue_engine.startWorkerIfNeeded();
+
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(file_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, "Written", false));
+  while (flushesCount < 2U && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  file_log_queue_engine.stopWorker();
+
+  EXPECT_GE(flushesCount, 2U);
+}
+
+TEST_F(AsyncLogQueueEngineTest, Drop_Oldest_Policy_Counts_Removed_Messages_By_Their_Own_Level) {
+  EXPECT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::debug, kTestCallSiteId, "First", false));
+  EXPECT_TRUE(async_log_queue_engine.processDeferredLogMessage(equinox::level::LOG_LEVEL::warning, kTestCallSiteId, "", false));
+  EXPECT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::critical, kTestCallSiteId, "Third", false));
+
+  EXPECT_EQ(async_log_queue_engine.getDroppedMessagesCount(equinox::level::LOG_LEVEL::debug), 1U);
+  EXPECT_EQ(async_log_queue_engine.getDroppedMessagesCount(equinox::level::LOG_LEVEL::critical), 0U);
+}
+TEST_F(AsyncLogQueueEngineTest, Queue_Capacity_From_Options_Replaces_The_Queue_And_Limits_Queued_Messages) {
+  equinox::LoggerOptions options;
+  options.overflowPolicy = equinox::overflow::POLICY::drop_newest;
+  options.queueCapacity = 3U;
+  async_log_queue_engine.configureQueue(options);
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, "Message " + std::to_string(i), false));
+  }
+  EXPECT_FALSE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, "Message 3", false));
+}
+
+TEST_F(AsyncLogQueueEngineTest, Adaptive_Batching_Writes_Every_Message_In_Order) {
+  equinox::LoggerOptions options;
+  options.overflowPolicy = equinox::overflow::POLICY::block;
+  options.queueCapacity = 16U;
+  options.batchSize = 8U;
+  options.dequeueTimeoutMs = 1U;
+  options.adaptiveBatching = true;
+  async_log_queue_engine.configureQueue(options);
+  async_log_queue_engine.startWorkerIfNeeded();
+
+  constexpr int kMessagesCount = 200;
+  for (int i = 0; i < kMessagesCount; ++i) {
+    ASSERT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, std::to_string(i), false));
+  }
+  const std::vector<std::string> messages = waitForWrittenMessages(kMessagesCount);
+  async_log_queue_engine.stopWorker();
+
+  ASSERT_EQ(messages.size(), static_cast<size_t>(kMessagesCount));
+  for (int i = 0; i < kMessagesCount; ++i) {
+    EXPECT_EQ(messages[i], std::to_string(i));
+  }
+}
+TEST_F(AsyncLogQueueEngineTest, Queue_Replaced_While_Threads_Are_Logging_And_No_Message_Lost) {
+  equinox::LoggerOptions options;
+  options.overflowPolicy = equinox::overflow::POLICY::block;
+  options.overflowBlockTimeoutMs = 60000U;
+  options.dequeueTimeoutMs = 1U;
+  async_log_queue_engine.configureQueue(options);
+  async_log_queue_engine.startWorkerIfNeeded();
+
+  constexpr int kThreadsCount = 4;
+  constexpr int kMessagesPerThread = 2000;
+  std::vector<std::thread> producers;
+  for (int thread = 0; thread < kThreadsCount; ++thread) {
+    producers.emplace_back([this, thread]() {
+      for (int i = 0; i < kMessagesPerThread; ++i) {
+        EXPECT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId,
+                                                             std::to_string(thread) + ":" + std::to_string(i), false));
+      }
+    });
+  }
+  const equinox::queue::TYPE queueTypes[] = {equinox::queue::TYPE::per_thread, equinox::queue::TYPE::byte_ring, equinox::queue::TYPE::per_cpu,
+                                             equinox::queue::TYPE::shared};
+  for (int reconfiguration = 0; reconfiguration < 12; ++reconfiguration) {
+    options.queueType = queueTypes[reconfiguration % 4];
+    async_log_queue_engine.configureQueue(options);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  const std::vector<std::string> messages = waitForWrittenMessages(kThreadsCount * kMessagesPerThread);
+  async_log_queue_engine.stopWorker();
+
+  ASSERT_EQ(messages.size(), static_cast<size_t>(kThreadsCount * kMessagesPerThread));
+  std::vector<std::vector<bool>> written(kThreadsCount, std::vector<bool>(kMessagesPerThread, false));
+  for (const auto& message : messages) {
+    const size_t separator = message.find(':');
+    written[std::stoi(message.substr(0U, separator))][std::stoi(message.substr(separator + 1U))] = true;
+  }
+  for (const auto& threadMessages : written) {
+    EXPECT_EQ(std::count(threadMessages.begin(), threadMessages.end(), true), kMessagesPerThread);
+  }
+}
+
+class AsyncLogQueueEngineWaitStrategyTest : public AsyncLogQueueEngineTest, public ::testing::WithParamInterface<equinox::worker_wait::STRATEGY> {};
+
+TEST_P(AsyncLogQueueEngineWaitStrategyTest, Worker_Writes_Messages_Logged_While_Idle_And_Stops_Without_Waiting_For_Timeout) {
+  equinox::LoggerOptions options;
+  options.overflowPolicy = equinox::overflow::POLICY::block;
+  options.workerWaitStrategy = GetParam();
+  options.dequeueTimeoutMs = 60000U;
+  async_log_queue_engine.configureQueue(options);
+  async_log_queue_engine.startWorkerIfNeeded();
+
+  for (int i = 0; i < 5; ++i) {
+    /* Lets the worker go idle, and park, between the messages */
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, std::to_string(i), false));
+  }
+  const std::vector<std::string> messages = waitForWrittenMessages(5);
+
+  const auto stopStart = std::chrono::steady_clock::now();
+  async_log_queue_engine.stopWorker();
+  EXPECT_LT(std::chrono::steady_clock::now() - stopStart, std::chrono::seconds(5));
+
+  ASSERT_EQ(messages.size(), 5U);
+  EXPECT_EQ(messages[4], "4");
+}
+
+INSTANTIATE_TEST_SUITE_P(AllWaitStrategies, AsyncLogQueueEngineWaitStrategyTest,
+                         ::testing::Values(equinox::worker_wait::STRATEGY::blocking, equinox::worker_wait::STRATEGY::adaptive,
+                                           equinox::worker_wait::STRATEGY::busy_poll));
+
+TEST_F(AsyncLogQueueEngineTest, Switching_Parked_Worker_To_Timed_Strategy_Still_Delivers_Messages) {
+  equinox::LoggerOptions options;
+  options.workerWaitStrategy = equinox::worker_wait::STRATEGY::blocking;
+  async_log_queue_engine.configureQueue(options);
+  async_log_queue_engine.startWorkerIfNeeded();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  options.workerWaitStrategy = equinox::worker_wait::STRATEGY::timed;
+  options.dequeueTimeoutMs = 60000U;
+  async_log_queue_engine.configureQueue(options);
+  ASSERT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, "After switch", false));
+
+  const std::vector<std::string> messages = waitForWrittenMessages(1);
+  async_log_queue_engine.stopWorker();
+  ASSERT_EQ(messages.size(), 1U);
+  EXPECT_EQ(messages[0], "After switch");
+}
+
+class AsyncLogQueueEngineTimestampClockTest : public AsyncLogQueueEngineTest, public ::testing::WithParamInterface<equinox::timestamp_clock::SOURCE> {};
+
+TEST_P(AsyncLogQueueEngineTimestampClockTest, Timestamp_Is_Taken_When_Message_Is_Queued_Not_When_Worker_Writes_It) {
+  const auto nowNs = []() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count(); };
+  /* CLOCK_REALTIME_COARSE lags behind by up to one kernel tick */
+  constexpr std::int64_t kToleranceNs = 20000000;
+  equinox::LoggerOptions options;
+  options.timestampClock = GetParam();
+  async_log_queue_engine.configureQueue(options);
+
+  const std::int64_t beforeLogNs = nowNs();
+  ASSERT_TRUE(async_log_queue_engine.processLogMessage(equinox::level::LOG_LEVEL::info, kTestCallSiteId, "Queued", false));
+  const std::int64_t afterLogNs = nowNs();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  async_log_queue_engine.startWorkerIfNeeded();
+  const std::vector<std::string> messages = waitForWrittenMessages(1);
+  async_log_queue_engine.stopWorker();
+
+  ASSERT_EQ(messages.size(), 1U);
+  std::lock_guard<std::mutex> lock(writtenMessagesMutex);
+  EXPECT_GE(writtenMetadata[0].timestampNs, beforeLogNs - kToleranceNs);
+  EXPECT_LE(writtenMetadata[0].timestampNs, afterLogNs + kToleranceNs);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllTimestampClocks, AsyncLogQueueEngineTimestampClockTest,
+                         ::testing::Values(equinox::timestamp_clock::SOURCE::monotonic, equinox::timestamp_clock::SOURCE::realtime_coarse,
+                                           equinox::timestamp_clock::SOURCE::tsc));
+}  // namespace async_log_queue_engine_test
@@ -32,7 +32,10 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include "AsyncLogQueue.h"
 
@@ -205,6 +208,61 @@ TEST_F(AsyncLogQueueTest, Stop_Queue_And_Check_If_Dequeue_Returns_False) {
   ASSERT_TRUE(asyncLogQueue.getStopRequested());
 }
 
+TEST_F(AsyncLogQueueTest, Drop_Oldest_Policy_Passes_Removed_Message_To_Visitor) {
+  std::vector<std::string> droppedMessages;
+  asyncLogQueue.setOverflowPolicy(equinox::overflow::POLICY::drop_oldest, 0U,
+                                  [&droppedMessages](std::string_view logRecord) { droppedMessages.emplace_back(logRecord); });
+  for (size_t i = 0; i < kTestQueueMaxSize; ++i) {
+    asyncLogQueue.enqueue("Log message " + std::to_string(i));
+  }
+
+  EXPECT_TRUE(asyncLogQueue.enqueue(testMessage));
+  ASSERT_EQ(droppedMessages.size(), 1U);
+  EXPECT_EQ(droppedMessages[0], "Log message 0");
+  EXPECT_EQ(asyncLogQueue.getInternalQueue().back(), testMessage);
+}
+
+TEST_F(AsyncLogQueueTest, Drop_Newest_Policy_Rejects_Message_And_Keeps_Queued_Ones) {
+  asyncLogQueue.setOverflowPolicy(equinox::overflow::POLICY::drop_newest, 0U, nullptr);
+  for (size_t i = 0; i < kTestQueueMaxSize; ++i) {
+    asyncLogQueue.enqueue("Log message " + std::to_string(i));
+  }
+
+  EXPECT_FALSE(asyncLogQueue.enqueue(testMessage));
+  ASSERT_EQ(asyncLogQueue.getInternalQueue().size(), kTestQueueMaxSize);
+  EXPECT_EQ(asyncLogQueue.getInternalQueue().front(), "Log message 0");
+}
+
+TEST_F(AsyncLogQueueTest, Block_Policy_Waits_Until_Dequeue_Makes_Space) {
+  asyncLogQueue.setOverflowPolicy(equinox::overflow::POLICY::block, 5000U, nullptr);
+  for (size_t i = 0; i < kTestQueueMaxSize; ++i) {
+    asyncLogQueue.enqueue("Log message " + std::to_string(i));
+  }
+
+  std::thread consumer([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::vector<std::string> out;
+    asyncLogQueue.dequeue(out, 1, 100);
+  });
+  EXPECT_TRUE(asyncLogQueue.enqueue(testMessage));
+  consumer.join();
+
+  EXPECT_EQ(asyncLogQueue.getInternalQueue().back(), testMessage);
+}
+
+TEST_F(AsyncLogQueueTest, Block_Policy_Drops_Message_After_Timeout_And_TryEnqueue_Does_Not_Wait) {
+  asyncLogQueue.setOverflowPolicy(equinox::overflow::POLICY::block, 10U, nullptr);
+  for (size_t i = 0; i < kTestQueueMaxSize; ++i) {
+    asyncLogQueue.enqueue("Log message " + std::to_string(i));
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(asyncLogQueue.enqueue(testMessage));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+  EXPECT_FALSE(asyncLogQueue.tryEnqueue(testMessage));
+  EXPECT_EQ(asyncLogQueue.getInternalQueue().size(), kTestQueueMaxSize);
+}
+
 TEST_F(AsyncLogQueueTest, Check_If_Stop_Request_Set_To_False_By_Default) {
   ASSERT_FALSE(asyncLogQueue.getStopRequested());
 }
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ByteRingLogQueue.h"
+
+namespace byte_ring_log_queue_test {
+namespace {
+constexpr size_t kTestCapacityBytes = 4096;
+constexpr size_t kTestMaxBatchSize = 64;
+constexpr uint32_t kTestTimeoutMs = 10;
+constexpr const char* testMessage = "Test log message";
+}  // namespace
+
+class ByteRingLogQueueForTests : public ::equinox::ByteRingLogQueue {
+ public:
+  ByteRingLogQueueForTests(size_t capacity_bytes, bool use_huge_pages) : ByteRingLogQueue(capacity_bytes, use_huge_pages) {}
+
+  size_t getCapacityForTests() const { return getCapacity(); }
+  uint64_t getDroppedMessagesCountForTests() const { return getDroppedMessagesCount(); }
+};
+
+class ByteRingLogQueueTest : public ::testing::Test {
+ public:
+  ByteRingLogQueueTest() : byteRingLogQueue{kTestCapacityBytes, false} {}
+
+  std::vector<std::string> consumeAll(size_t max_batch_size = kTestMaxBatchSize) {
+    std::vector<std::string> consumed;
+    while (byteRingLogQueue.consume([&consumed](std::string_view logRecord) { consumed.emplace_back(logRecord); }, max_batch_size, kTestTimeoutMs)) {
+    }
+    return consumed;
+  }
+
+  ByteRingLogQueueForTests byteRingLogQueue;
+};
+
+TEST_F(ByteRingLogQueueTest, Capacity_Is_Rounded_Up_To_Power_Of_Two) {
+  ByteRingLogQueueForTests queue{5000, false};
+  EXPECT_EQ(queue.getCapacityForTests(), 8192U);
+}
+
+TEST_F(ByteRingLogQueueTest, Try_Consume_From_Empty_Queue_And_Return_False) {
+  bool visited = false;
+  EXPECT_FALSE(byteRingLogQueue.consume([&visited](std::string_view) { visited = true; }, kTestMaxBatchSize, kTestTimeoutMs));
+  EXPECT_FALSE(visited);
+}
+
+TEST_F(ByteRingLogQueueTest, Enqueue_And_Consume_Messages_And_Order_And_Content_Are_Preserved) {
+  byteRingLogQueue.enqueue(testMessage);
+  byteRingLogQueue.enqueue("");
+  byteRingLogQueue.enqueue(std::string("with\0zero", 9));
+
+  const std::vector<std::string> consumed = consumeAll();
+  ASSERT_EQ(consumed.size(), 3U);
+  EXPECT_EQ(consumed[0], testMessage);
+  EXPECT_EQ(consumed[1], "");
+  EXPECT_EQ(consumed[2], std::string("with\0zero", 9));
+}
+
+TEST_F(ByteRingLogQueueTest, Consume_Returns_At_Most_Max_Batch_Size_Records) {
+  for (int i = 0; i < 5; ++i) {
+    byteRingLogQueue.enqueue(testMessage);
+  }
+
+  size_t visited = 0;
+  ASSERT_TRUE(byteRingLogQueue.consume([&visited](std::string_view) { ++visited; }, 3, kTestTimeoutMs));
+  EXPECT_EQ(visited, 3U);
+}
+
+TEST_F(ByteRingLogQueueTest, Dequeue_Copies_Records_Into_Strings) {
+  byteRingLogQueue.enqueue(testMessage);
+
+  std::vector<std::string> out;
+  ASSERT_TRUE(byteRingLogQueue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs));
+  ASSERT_EQ(out.size(), 1U);
+  EXPECT_EQ(out[0], testMessage);
+}
+
+TEST_F(ByteRingLogQueueTest, Ring_Is_Full_And_Newest_Message_Is_Dropped_And_Counted) {
+  const std::string message(500, 'x');
+  int enqueued = 0;
+  while (byteRingLogQueue.getDroppedMessagesCountForTests() == 0U) {
+    byteRingLogQueue.enqueue(message + std::to_string(enqueued));
+    ++enqueued;
+  }
+
+  const std::vector<std::string> consumed = consumeAll();
+  ASSERT_EQ(consumed.size(), static_cast<size_t>(enqueued - 1));
+  EXPECT_EQ(consumed.back(), message + std::to_string(enqueued - 2));
+}
+
+TEST_F(ByteRingLogQueueTest, Block_Policy_Gives_Up_After_Timeout_But_Never_Waits_For_Message_That_Can_Not_Fit) {
+  byteRingLogQueue.setOverflowPolicy(equinox::overflow::POLICY::block, 10U, nullptr);
+  const std::string message(500, 'x');
+  while (byteRingLogQueue.tryEnqueue(message)) {
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(byteRingLogQueue.enqueue(message));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+
+  consumeAll();
+  EXPECT_FALSE(byteRingLogQueue.enqueue(std::string(kTestCapacityBytes, 'x')));
+  EXPECT_TRUE(byteRingLogQueue.enqueue(message));
+}
+
+TEST_F(ByteRingLogQueueTest, Message_Larger_Than_Half_Of_Ring_Is_Dropped) {
+  byteRingLogQueue.enqueue(std::string(kTestCapacityBytes, 'x'));
+
+  EXPECT_EQ(byteRingLogQueue.getDroppedMessagesCountForTests(), 1U);
+  EXPECT_TRUE(consumeAll().empty());
+}
+
+TEST_F(ByteRingLogQueueTest, Records_Wrapping_Around_The_End_Of_Ring_Are_Consumed_Intact) {
+  for (int round = 0; round < 50; ++round) {
+    const std::string message = std::string(300 + round * 7, static_cast<char>('a' + round % 26));
+    byteRingLogQueue.enqueue(message);
+    byteRingLogQueue.enqueue(message);
+
+    const std::vector<std::string> consumed = consumeAll();
+    ASSERT_EQ(consumed.size(), 2U);
+    EXPECT_EQ(consumed[0], message);
+    EXPECT_EQ(consumed[1], message);
+  }
+  EXPECT_EQ(byteRingLogQueue.getDroppedMessagesCountForTests(), 0U);
+}
+
+TEST_F(ByteRingLogQueueTest, Enqueue_From_Many_Threads_While_Consuming_And_All_Messages_Arrive_In_Per_Thread_Order) {
+  constexpr int kThreadCount = 4;
+  constexpr int kMessagesPerThread = 5000;
+  ByteRingLogQueueForTests queue{64 * 1024, false};
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < kThreadCount; ++t) {
+    producers.emplace_back([&queue, t]() {
+      for (int i = 0; i < kMessagesPerThread; ++i) {
+        queue.enqueue(std::to_string(t) + ":" + std::to_string(i));
+      }
+    });
+  }
+
+  std::vector<int> nextExpectedIndex(kThreadCount, 0);
+  int received = 0;
+  const auto visitor = [&](std::string_view logRecord) {
+    const size_t separator = logRecord.find(':');
+    const int thread = std::stoi(std::string(logRecord.substr(0, separator)));
+    const int index = std::stoi(std::string(logRecord.substr(separator + 1)));
+    EXPECT_GE(index, nextExpectedIndex[thread]);
+    nextExpectedIndex[thread] = index + 1;
+    ++received;
+  };
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  while (queue.consume(visitor, kTestMaxBatchSize, kTestTimeoutMs)) {
+  }
+
+  EXPECT_EQ(static_cast<uint64_t>(received) + queue.getDroppedMessagesCountForTests(), static_cast<uint64_t>(kThreadCount * kMessagesPerThread));
+}
+
+TEST_F(ByteRingLogQueueTest, Consume_Waits_For_Message_Enqueued_By_Other_Thread) {
+  std::thread producer([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    byteRingLogQueue.enqueue(testMessage);
+  });
+
+  std::string consumed;
+  const bool result = byteRingLogQueue.consume([&consumed](std::string_view logRecord) { consumed = logRecord; }, kTestMaxBatchSize, 5000);
+  producer.join();
+
+  ASSERT_TRUE(result);
+  EXPECT_EQ(consumed, testMessage);
+}
+
+TEST_F(ByteRingLogQueueTest, Huge_Pages_Requested_And_Queue_Works_With_Or_Without_Them) {
+  ByteRingLogQueueForTests queue{kTestCapacityBytes, true};
+  queue.enqueue(testMessage);
+
+  std::string consumed;
+  ASSERT_TRUE(queue.consume([&consumed](std::string_view logRecord) { consumed = logRecord; }, kTestMaxBatchSize, kTestTimeoutMs));
+  EXPECT_EQ(consumed, testMessage);
+}
+
+TEST_F(ByteRingLogQueueTest, Stop_Queue_And_Consume_Returns_Remaining_Messages_Then_False) {
+  byteRingLogQueue.enqueue(testMessage);
+  byteRingLogQueue.stop();
+
+  EXPECT_TRUE(byteRingLogQueue.consume([](std::string_view) {}, kTestMaxBatchSize, kTestTimeoutMs));
+  EXPECT_FALSE(byteRingLogQueue.consume([](std::string_view) {}, kTestMaxBatchSize, kTestTimeoutMs));
+}
+
+}  // namespace byte_ring_log_queue_test
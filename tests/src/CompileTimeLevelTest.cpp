@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+/* This translation unit is built as if configured with -DEQUINOX_LOGGER_ACTIVE_LEVEL=WARNING.
+   It must only use the EQUINOX_* macros of stripped levels, never the equinox::trace()..info() templates. */
+#undef EQUINOX_ACTIVE_LEVEL
+#define EQUINOX_ACTIVE_LEVEL EQUINOX_LEVEL_WARNING
+
+#include "EquinoxLogger.h"
+
+namespace compile_time_level_test {
+
+    namespace {
+
+        int constexpr kNumberOfAttempts = 40;
+        std::chrono::milliseconds constexpr kDelayBetweenAttempts{10};
+        constexpr char const* kLogPrefix = "CompileTimeLevelTest";
+        constexpr char const* kLogFilePath = "/tmp/equinox_logger_compile_time_level.log";
+
+        int gEvaluationsCounter = 0;
+
+        int countEvaluation() {
+            return ++gEvaluationsCounter;
+        }
+
+        std::string WaitForFileToContain(const std::string& filePath, const std::string& expectedToken) {
+            std::string content;
+            for (int attempt = 0; attempt < kNumberOfAttempts; ++attempt) {
+                std::ifstream file(filePath);
+                if (file.is_open()) {
+                    content.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                    if (content.find(expectedToken) != std::string::npos) {
+                        break;
+                    }
+                }
+
+                std::this_thread::sleep_for(kDelayBetweenAttempts);
+            }
+
+            return content;
+        }
+
+    }  // namespace
+
+    static_assert(EQUINOX_ACTIVE_LEVEL == EQUINOX_LEVEL_WARNING);
+
+    TEST(CompileTimeLevelTest, Stripped_Macros_Do_Not_Evaluate_Arguments) {
+        gEvaluationsCounter = 0;
+
+        EQUINOX_TRACE("trace %d", countEvaluation());
+        EQUINOX_DEBUG("debug %d", countEvaluation());
+        EQUINOX_INFO("info %d", countEvaluation());
+
+        EXPECT_EQ(gEvaluationsCounter, 0);
+    }
+
+    TEST(CompileTimeLevelTest, Macros_At_Or_Above_Active_Level_Evaluate_Arguments) {
+        gEvaluationsCounter = 0;
+        ASSERT_TRUE(equinox::setup(equinox::level::LOG_LEVEL::off, kLogPrefix, equinox::logs_output::SINK::console));
+
+        EQUINOX_WARNING("warning %d", countEvaluation());
+        EQUINOX_ERROR("error %d", countEvaluation());
+        EQUINOX_CRITICAL("critical %d", countEvaluation());
+
+        EXPECT_EQ(gEvaluationsCounter, 3);
+    }
+
+    TEST(CompileTimeLevelTest, Only_Messages_At_Or_Above_Active_Level_Reach_The_Sink) {
+        std::filesystem::remove(kLogFilePath);
+        ASSERT_TRUE(equinox::setup(equinox::level::LOG_LEVEL::trace, kLogPrefix, equinox::logs_output::SINK::file, kLogFilePath));
+
+        EQUINOX_TRACE("stripped_trace_message");
+        EQUINOX_DEBUG("stripped_debug_message");
+        EQUINOX_INFO("stripped_info_message");
+        EQUINOX_WARNING("kept_warning_message");
+        equinox::flush();
+
+        const std::string content = WaitForFileToContain(kLogFilePath, "kept_warning_message");
+        EXPECT_NE(content.find("kept_warning_message"), std::string::npos);
+        EXPECT_EQ(content.find("stripped_trace_message"), std::string::npos);
+        EXPECT_EQ(content.find("stripped_debug_message"), std::string::npos);
+        EXPECT_EQ(content.find("stripped_info_message"), std::string::npos);
+    }
+
+}  // namespace compile_time_level_test
@@ -1,7 +1,9 @@
+#include <fcntl.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
-#include <iostream>
-#include <sstream>
+#include <csignal>
+#include <string>
 
 #include "ColorFormatterMock.h"
 #include "ConsoleLogsProducer.h"
@@ -12,20 +14,38 @@ namespace console_logs_producer_test {
     namespace {
         struct LogMessageTestCase {
             equinox::level::LOG_LEVEL level;
-            std::string_view color;
             std::string formattedMessage;
         };
 
         constexpr const char* kMessageToLog = "Test log message";
-        const std::string kTimestamp = "2023-10-01 12:00:00";
-        const std::string kTimestampInUs = ".123456";
-
-        const LogMessageTestCase kErrorCase{equinox::level::LOG_LEVEL::error, "\033[31m", "\033[31mTest log message\033[0m"};
-        const LogMessageTestCase kTraceCase{equinox::level::LOG_LEVEL::trace, "\033[36m", "\033[36mTest log message\033[0m"};
-        const LogMessageTestCase kDebugCase{equinox::level::LOG_LEVEL::debug, "\033[32m", "\033[32mTest log message\033[0m"};
-        const LogMessageTestCase kInfoCase{equinox::level::LOG_LEVEL::info, "", "Test log message"};
-        const LogMessageTestCase kWarningCase{equinox::level::LOG_LEVEL::warning, "\033[33m", "\033[33mTest log message\033[0m"};
-        const LogMessageTestCase kCriticalCase{equinox::level::LOG_LEVEL::critical, "\033[35m", "\033[35mTest log message\033[0m"};
+        constexpr const char* kLogPrefix = "[TestPrefix]";
+        constexpr const char* kTimestamp = "[2023-10-01T12:00:00.123456Z]";
+        constexpr std::int64_t kTimestampNs = 1696161600123456000;
+        constexpr std::string_view kColorReset = "\033[0m";
+
+        const LogMessageTestCase kErrorCase{equinox::level::LOG_LEVEL::error, "\033[31m[TestPrefix][ERROR] Test log message\033[0m"};
+        const LogMessageTestCase kTraceCase{equinox::level::LOG_LEVEL::trace, "\033[36m[TestPrefix][TRACE] Test log message\033[0m"};
+        const LogMessageTestCase kDebugCase{equinox::level::LOG_LEVEL::debug, "\033[32m[TestPrefix][DEBUG] Test log message\033[0m"};
+        const LogMessageTestCase kInfoCase{equinox::level::LOG_LEVEL::info, "[TestPrefix][INFO] Test log message"};
+        const LogMessageTestCase kWarningCase{equinox::level::LOG_LEVEL::warning, "\033[33m[TestPrefix][WARNING] Test log message\033[0m"};
+        const LogMessageTestCase kCriticalCase{equinox::level::LOG_LEVEL::critical, "\033[35m[TestPrefix][CRITICAL] Test log message\033[0m"};
+
+        std::string_view getTestColor(equinox::level::LOG_LEVEL level) {
+            switch (level) {
+                case equinox::level::LOG_LEVEL::trace:
+                    return "\033[36m";
+                case equinox::level::LOG_LEVEL::debug:
+                    return "\033[32m";
+                case equinox::level::LOG_LEVEL::warning:
+                    return "\033[33m";
+                case equinox::level::LOG_LEVEL::error:
+                    return "\033[31m";
+                case equinox::level::LOG_LEVEL::critical:
+                    return "\033[35m";
+                default:
+                    return "";
+            }
+        }
     }  // namespace
 
     using namespace equinox;
@@ -34,73 +54,141 @@ namespace console_logs_producer_test {
 
     class ConsoleLogsProducerTestable : public ConsoleLogsProducer {
        public:
-        ConsoleLogsProducerTestable(std::shared_ptr<ITimestampProducer> timestampProducer, std::shared_ptr<IColorFormatter> colorFormatter)
-            : ConsoleLogsProducer(timestampProducer, colorFormatter) {}
-    };
+        ConsoleLogsProducerTestable(std::shared_ptr<ITimestampProducer> timestampProducer, std::shared_ptr<IColorFormatter> colorFormatter, int outputFd)
+            : ConsoleLogsProducer(timestampProducer, colorFormatter, outputFd) {}
 
-    class TrackingStringBuf : public std::stringbuf {
-       public:
-        int syncCalls = 0;
+        std::int64_t monotonicNs = 0;
 
        protected:
-        int sync() override {
-            ++syncCalls;
-            return std::stringbuf::sync();
+        std::int64_t readMonotonicNs() const override {
+            return monotonicNs;
         }
     };
 
-    class CoutBufferGuard {
+    class ConsoleLogsProducerTest : public ::testing::Test {
        public:
-        explicit CoutBufferGuard(std::streambuf* newBuffer) : oldBuffer_(std::cout.rdbuf(newBuffer)) {}
-
-        ~CoutBufferGuard() {
-            std::cout.rdbuf(oldBuffer_);
+        ConsoleLogsProducerTest() : timestamp_producer_mock{new StrictMock<TimestampProducerMock>}, color_formatter_mock{new StrictMock<ColorFormatterMock>} {
+            /* The line templates ask for the colors of every level whenever they are rendered */
+            EXPECT_CALL(*color_formatter_mock, getColorForLevel(_)).WillRepeatedly(Invoke(getTestColor));
+            EXPECT_CALL(*color_formatter_mock, getColorReset()).WillRepeatedly(Return(kColorReset));
+            EXPECT_EQ(pipe2(output_pipe, O_NONBLOCK), 0);
+            console_logs_producer = std::make_unique<ConsoleLogsProducerTestable>(std::shared_ptr<ITimestampProducer>(timestamp_producer_mock),
+                                                                                  std::shared_ptr<IColorFormatter>(color_formatter_mock), output_pipe[1]);
         }
 
-       private:
-        std::streambuf* oldBuffer_;
-    };
+        ~ConsoleLogsProducerTest() override {
+            console_logs_producer.reset();
+            close(output_pipe[0]);
+            close(output_pipe[1]);
+        }
 
-    class ConsoleLogsProducerTest : public ::testing::Test {
-       public:
-        ConsoleLogsProducerTest()
-            : timestamp_producer_mock{new StrictMock<TimestampProducerMock>},
-              color_formatter_mock{new StrictMock<ColorFormatterMock>},
-              console_logs_producer{std::shared_ptr<ITimestampProducer>(timestamp_producer_mock), std::shared_ptr<IColorFormatter>(color_formatter_mock)} {}
+        std::string readOutput() {
+            std::string output;
+            char buffer[4096];
+            ssize_t readBytes = 0;
+            while ((readBytes = read(output_pipe[0], buffer, sizeof(buffer))) > 0) {
+                output.append(buffer, static_cast<std::size_t>(readBytes));
+            }
+            return output;
+        }
 
         StrictMock<TimestampProducerMock>* timestamp_producer_mock;
         StrictMock<ColorFormatterMock>* color_formatter_mock;
-        ConsoleLogsProducerTestable console_logs_producer;
+        int output_pipe[2];
+        std::unique_ptr<ConsoleLogsProducerTestable> console_logs_producer;
     };
 
     class ConsoleLogsProducerParamTest : public ConsoleLogsProducerTest, public ::testing::WithParamInterface<LogMessageTestCase> {};
 
     TEST_P(ConsoleLogsProducerParamTest, Log_Message_And_It_Is_Properly_Formatted) {
         const LogMessageTestCase& testCase = GetParam();
-        std::string expectedOutput = kTimestamp + kTimestampInUs + testCase.formattedMessage;
+        std::string expectedOutput = kTimestamp + testCase.formattedMessage;
 
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).WillOnce(Return(kTimestamp));
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).WillOnce(Return(kTimestampInUs));
-        EXPECT_CALL(*color_formatter_mock, extractLevelFromMessage(kMessageToLog)).WillOnce(Return(testCase.level));
-        EXPECT_CALL(*color_formatter_mock, getColorForLevel(testCase.level)).WillOnce(Return(testCase.color));
-        EXPECT_CALL(*color_formatter_mock, applyConsoleColors(kMessageToLog, testCase.color)).WillOnce(Return(testCase.formattedMessage));
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTimestampNs, _)).WillOnce(WriteTimestamp(kTimestamp));
 
-        testing::internal::CaptureStdout();
-        console_logs_producer.logMessage(kMessageToLog);
-        std::string output = testing::internal::GetCapturedStdout();
+        console_logs_producer->setLogPrefix(kLogPrefix);
+        console_logs_producer->logMessage(kMessageToLog, LogRecordMetadata{testCase.level, kTimestampNs, 0U, 0U});
+        console_logs_producer->flush();
 
-        EXPECT_EQ(output, expectedOutput + "\n");
+        EXPECT_EQ(readOutput(), expectedOutput + "\n");
     }
 
     INSTANTIATE_TEST_SUITE_P(AllLogLevels, ConsoleLogsProducerParamTest, Values(kErrorCase, kTraceCase, kDebugCase, kInfoCase, kWarningCase, kCriticalCase));
 
-    TEST_F(ConsoleLogsProducerTest, Flush_Cout_And_It_Synchronizes_Stream_Buffer) {
-        TrackingStringBuf trackingBuffer;
-        CoutBufferGuard coutGuard(&trackingBuffer);
+    TEST_F(ConsoleLogsProducerTest, Log_Message_Before_Prefix_Is_Set_And_Only_Color_And_Level_Tag_Are_Written) {
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTimestampNs, _)).WillOnce(WriteTimestamp(kTimestamp));
+
+        console_logs_producer->logMessage(kMessageToLog, LogRecordMetadata{level::LOG_LEVEL::warning, kTimestampNs, 0U, 0U});
+        console_logs_producer->flush();
+
+        EXPECT_EQ(readOutput(), std::string(kTimestamp) + "\033[33m[WARNING] Test log message\033[0m\n");
+    }
+
+    TEST_F(ConsoleLogsProducerTest, Log_Messages_Within_Flush_Interval_And_They_Are_Written_Together_On_Flush) {
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTimestampNs, _)).Times(2).WillRepeatedly(WriteTimestamp(kTimestamp));
+        const std::string expectedLine = std::string(kTimestamp) + "[INFO] Test log message\n";
+
+        console_logs_producer->logMessage(kMessageToLog, LogRecordMetadata{level::LOG_LEVEL::info, kTimestampNs, 0U, 0U});
+        console_logs_producer->logMessage(kMessageToLog, LogRecordMetadata{level::LOG_LEVEL::info, kTimestampNs, 0U, 0U});
+        EXPECT_EQ(readOutput(), "");
+
+        console_logs_producer->flush();
+
+        EXPECT_EQ(readOutput(), expectedLine + expectedLine);
+    }
+
+    TEST_F(ConsoleLogsProducerTest, Log_Message_After_Flush_Interval_Elapsed_And_Buffered_Lines_Are_Written) {
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTimestampNs, _)).Times(2).WillRepeatedly(WriteTimestamp(kTimestamp));
+        const std::string expectedLine = std::string(kTimestamp) + "[INFO] Test log message\n";
+        console_logs_producer->setFlushIntervalMs(5U);
+
+        console_logs_producer->logMessage(kMessageToLog, LogRecordMetadata{level::LOG_LEVEL::info, kTimestampNs, 0U, 0U});
+        console_logs_producer->monotonicNs += 5000000;
+        console_logs_producer->logMessage(kMessageToLog, LogRecordMetadata{level::LOG_LEVEL::info, kTimestampNs, 0U, 0U});
+
+        EXPECT_EQ(readOutput(), expectedLine + expectedLine);
+    }
+
+    TEST_F(ConsoleLogsProducerTest, Set_Zero_Flush_Interval_And_Every_Line_Is_Written_At_Once) {
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTimestampNs, _)).WillOnce(WriteTimestamp(kTimestamp));
+        console_logs_producer->setFlushIntervalMs(0U);
+
+        console_logs_producer->logMessage(kMessageToLog, LogRecordMetadata{level::LOG_LEVEL::info, kTimestampNs, 0U, 0U});
+
+        EXPECT_EQ(readOutput(), std::string(kTimestamp) + "[INFO] Test log message\n");
+    }
+
+    TEST_F(ConsoleLogsProducerTest, Log_Messages_Filling_The_Buffer_And_They_Are_Written_Without_Flush) {
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTimestampNs, _)).WillRepeatedly(Return(0U));
+        const std::string longMessage(1024U, 'x');
+
+        for (int i = 0; i < 64; ++i) {
+            console_logs_producer->logMessage(longMessage, LogRecordMetadata{level::LOG_LEVEL::info, kTimestampNs, 0U, 0U});
+        }
+
+        EXPECT_FALSE(readOutput().empty());
+    }
+
+    TEST_F(ConsoleLogsProducerTest, Destroy_Producer_With_Buffered_Lines_And_They_Are_Written) {
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTimestampNs, _)).WillOnce(WriteTimestamp(kTimestamp));
+
+        console_logs_producer->logMessage(kMessageToLog, LogRecordMetadata{level::LOG_LEVEL::info, kTimestampNs, 0U, 0U});
+        console_logs_producer.reset();
+
+        EXPECT_EQ(readOutput(), std::string(kTimestamp) + "[INFO] Test log message\n");
+    }
+
+    TEST_F(ConsoleLogsProducerTest, Try_Flush_Into_Closed_Pipe_And_Buffered_Lines_Are_Dropped) {
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTimestampNs, _)).WillOnce(WriteTimestamp(kTimestamp));
+        const auto previousSigpipeHandler = signal(SIGPIPE, SIG_IGN);
+        close(output_pipe[0]);
+        output_pipe[0] = -1;
 
-        console_logs_producer.flush();
+        console_logs_producer->logMessage(kMessageToLog, LogRecordMetadata{level::LOG_LEVEL::info, kTimestampNs, 0U, 0U});
 
-        EXPECT_GT(trackingBuffer.syncCalls, 0);
+        EXPECT_NO_THROW(console_logs_producer->flush());
+        EXPECT_NO_THROW(console_logs_producer->flush());
+        signal(SIGPIPE, previousSigpipeHandler);
     }
 
 }  // namespace console_logs_producer_test
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <string>
+
+#include "DeferredMessageFormatter.h"
+#include "EquinoxLoggerDeferred.h"
+
+namespace deferred_message_formatter_test {
+
+    using namespace equinox;
+    using namespace testing;
+
+    class DeferredMessageFormatterTest : public Test {
+       public:
+        DeferredMessageFormatterTest() : deferred_message_formatter{} {}
+
+        template <typename... Args>
+        std::string formatDeferred(const std::string& format, const Args&... args) {
+            std::string encodedMessage;
+            std::string output;
+            deferred::encodeMessage(encodedMessage, format.data(), format.size(), args...);
+            EXPECT_TRUE(deferred_message_formatter.format(encodedMessage, output));
+            return output;
+        }
+
+        template <typename... Args>
+        std::string formatImmediate(const char* format, const Args&... args) {
+            char buffer[4096];
+            int written = std::snprintf(buffer, sizeof(buffer), format, args...);
+            return std::string(buffer, static_cast<std::size_t>(written));
+        }
+
+        DeferredMessageFormatter deferred_message_formatter;
+    };
+
+    TEST_F(DeferredMessageFormatterTest, Format_Message_Without_Arguments_And_Message_Is_Copied) {
+        EXPECT_EQ(formatDeferred("Message without arguments"), "Message without arguments");
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Escaped_Percent_And_Single_Percent_Returned) {
+        EXPECT_EQ(formatDeferred("100%% done"), "100% done");
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Signed_And_Unsigned_Integers_And_Result_Equals_Snprintf) {
+        const short shortValue = -12;
+        const long longValue = -1234567890L;
+        const unsigned long long unsignedValue = 18446744073709551615ULL;
+
+        EXPECT_EQ(formatDeferred("%d %hd %ld %llu", -42, shortValue, longValue, unsignedValue),
+                  formatImmediate("%d %hd %ld %llu", -42, shortValue, longValue, unsignedValue));
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Negative_Values_As_Unsigned_And_Result_Equals_Snprintf) {
+        const long longValue = -2L;
+
+        EXPECT_EQ(formatDeferred("%x|%u|%o|%X|%lx|%lu", -1, -1, -8, -255, longValue, longValue),
+                  formatImmediate("%x|%u|%o|%X|%lx|%lu", -1, -1, -8, -255, longValue, longValue));
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Values_Out_Of_Range_Of_Length_Modifier_And_Result_Equals_Snprintf) {
+        const unsigned char unsignedCharValue = 200U;
+        const std::size_t sizeValue = 18446744073709551615ULL;
+        const std::ptrdiff_t ptrdiffValue = -3;
+
+        EXPECT_EQ(formatDeferred("%hd|%hhx|%hhu|%hu|%hhd|%zu|%zx|%td|%jd", 70000, 0x1FF, unsignedCharValue, -1, 200, sizeValue, sizeValue, ptrdiffValue,
+                                 static_cast<std::intmax_t>(-9)),
+                  formatImmediate("%hd|%hhx|%hhu|%hu|%hhd|%zu|%zx|%td|%jd", 70000, 0x1FF, unsignedCharValue, -1, 200, sizeValue, sizeValue, ptrdiffValue,
+                                  static_cast<std::intmax_t>(-9)));
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Hex_Octal_And_Flags_And_Result_Equals_Snprintf) {
+        EXPECT_EQ(formatDeferred("%#x %08X %o %+d %-5d|", 255U, 48879U, 8U, 7, 3), formatImmediate("%#x %08X %o %+d %-5d|", 255U, 48879U, 8U, 7, 3));
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Floating_Point_Values_And_Result_Equals_Snprintf) {
+        const float floatValue = 1.5F;
+        const long double longDoubleValue = 2.25L;
+
+        EXPECT_EQ(formatDeferred("%f %.3e %g %Lf", floatValue, 12345.678, 0.0001, longDoubleValue),
+                  formatImmediate("%f %.3e %g %Lf", static_cast<double>(floatValue), 12345.678, 0.0001, longDoubleValue));
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Star_Width_And_Precision_And_Result_Equals_Snprintf) {
+        EXPECT_EQ(formatDeferred("[%*d] [%.*f] [%*.*s]", 6, 42, 2, 3.14159, 8, 3, "abcdef"),
+                  formatImmediate("[%*d] [%.*f] [%*.*s]", 6, 42, 2, 3.14159, 8, 3, "abcdef"));
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Strings_And_Characters_And_Strings_Are_Copied) {
+        const std::string stdString = "std_string";
+        char mutableString[] = "mutable";
+
+        EXPECT_EQ(formatDeferred("%s %s %s %c", "literal", stdString, mutableString, 'x'), "literal std_string mutable x");
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_String_Which_Does_Not_Outlive_The_Call_And_Captured_Copy_Is_Used) {
+        std::string encodedMessage;
+        std::string output;
+        const std::string format = "value: %s";
+        {
+            std::string temporary = "temporary_value";
+            deferred::encodeMessage(encodedMessage, format.data(), format.size(), temporary.c_str());
+            temporary.assign(temporary.size(), 'X');
+        }
+
+        ASSERT_TRUE(deferred_message_formatter.format(encodedMessage, output));
+        EXPECT_EQ(output, "value: temporary_value");
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Null_String_And_Null_Marker_Returned) {
+        const char* nullString = nullptr;
+
+        EXPECT_EQ(formatDeferred("[%s]", nullString), "[(null)]");
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Pointer_And_Result_Equals_Snprintf) {
+        int value = 0;
+        void* pointer = &value;
+
+        EXPECT_EQ(formatDeferred("%p", pointer), formatImmediate("%p", pointer));
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_With_Missing_Arguments_And_Conversion_Is_Kept_Verbatim) {
+        EXPECT_EQ(formatDeferred("%d and %s", 5), "5 and %s");
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Message_Longer_Than_Max_Size_And_Message_Is_Truncated) {
+        const std::string veryLongMessage(5000, 'A');
+
+        EXPECT_EQ(formatDeferred("%s", veryLongMessage).size(), 4095U);
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Format_Appends_To_Existing_Output) {
+        std::string encodedMessage;
+        std::string output = "[Prefix][INFO] ";
+        const std::string format = "answer %d";
+        deferred::encodeMessage(encodedMessage, format.data(), format.size(), 42);
+
+        ASSERT_TRUE(deferred_message_formatter.format(encodedMessage, output));
+        EXPECT_EQ(output, "[Prefix][INFO] answer 42");
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Try_Format_Truncated_Encoded_Message_And_False_Returned) {
+        std::string encodedMessage;
+        std::string output;
+        const std::string format = "%s";
+        deferred::encodeMessage(encodedMessage, format.data(), format.size(), "truncated");
+        encodedMessage.resize(encodedMessage.size() - 3U);
+
+        EXPECT_FALSE(deferred_message_formatter.format(encodedMessage, output));
+    }
+
+    TEST_F(DeferredMessageFormatterTest, Try_Format_Encoded_Message_Without_Format_Size_And_False_Returned) {
+        std::string output;
+
+        EXPECT_FALSE(deferred_message_formatter.format(std::string_view("ab", 2U), output));
+    }
+
+}  // namespace deferred_message_formatter_test
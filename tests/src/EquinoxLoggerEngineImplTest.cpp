@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <cerrno>
 #include <string>
 
 #include "AsyncLogQueueEngineMock.h"
@@ -15,6 +16,7 @@ namespace equinox_logger_engine_impl_test {
 
     namespace {
         constexpr const char* kFormattedOutputMessage = "Test log";
+        constexpr std::uint32_t kCallSiteId = 42U;
         constexpr const char* kLogPrefix = "TestPrefix";
         constexpr const char* kExpectedLogPrefix = "[TestPrefix]";
         constexpr const char* kLogFileName = "test.log";
@@ -23,42 +25,23 @@ namespace equinox_logger_engine_impl_test {
 
         struct LogLevelTestCase {
             level::LOG_LEVEL level;
-            const char* expectedMessage;
             bool shouldProcess;
             const char* testName;
         };
 
-        struct SetupLogLevelTestCase {
-            level::LOG_LEVEL level;
-            const char* testName;
-        };
-
         struct SetupSinkTestCase {
             logs_output::SINK sink;
             bool shouldSetupFile;
             const char* testName;
         };
 
-        struct ChangeLevelTestCase {
-            level::LOG_LEVEL level;
-            const char* testName;
-        };
-
         std::string GetLogLevelTestCaseName(const TestParamInfo<LogLevelTestCase>& info) {
             return info.param.testName;
         }
 
-        std::string GetSetupLogLevelTestCaseName(const TestParamInfo<SetupLogLevelTestCase>& info) {
-            return info.param.testName;
-        }
-
         std::string GetSetupSinkTestCaseName(const TestParamInfo<SetupSinkTestCase>& info) {
             return info.param.testName;
         }
-
-        std::string GetChangeLevelTestCaseName(const TestParamInfo<ChangeLevelTestCase>& info) {
-            return info.param.testName;
-        }
     }  // namespace
 
     class EquinoxLoggerEngineImplTestable : public EquinoxLoggerEngineImpl {
@@ -71,10 +54,6 @@ namespace equinox_logger_engine_impl_test {
             return getLogPrefix();
         }
 
-        level::LOG_LEVEL getLogLevelForTests() const {
-            return getLogLevel();
-        }
-
         const std::string& getLogFileNameForTests() const {
             return getLogFileName();
         }
@@ -105,9 +84,7 @@ namespace equinox_logger_engine_impl_test {
     };
 
     class EquinoxLoggerEngineImplParameterizedTest : public EquinoxLoggerEngineImplTest, public WithParamInterface<LogLevelTestCase> {};
-    class EquinoxLoggerEngineImplSetupLogLevelParameterizedTest : public EquinoxLoggerEngineImplTest, public WithParamInterface<SetupLogLevelTestCase> {};
     class EquinoxLoggerEngineImplSetupSinkParameterizedTest : public EquinoxLoggerEngineImplTest, public WithParamInterface<SetupSinkTestCase> {};
-    class EquinoxLoggerEngineImplChangeLevelParameterizedTest : public EquinoxLoggerEngineImplTest, public WithParamInterface<ChangeLevelTestCase> {};
     class EquinoxLoggerEngineImplChangeSinkParameterizedTest : public EquinoxLoggerEngineImplTest, public WithParamInterface<SetupSinkTestCase> {};
 
     TEST_P(EquinoxLoggerEngineImplParameterizedTest, Log_Message_For_All_Log_Levels_Is_Processed_According_To_Level) {
@@ -115,53 +92,44 @@ namespace equinox_logger_engine_impl_test {
 
         if (testCase.shouldProcess) {
             EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(1);
-            EXPECT_CALL(*async_log_queue_engine_mock, processLogMessage(testCase.expectedMessage)).Times(1);
+            EXPECT_CALL(*async_log_queue_engine_mock, processLogMessage(testCase.level, kCallSiteId, kFormattedOutputMessage, false)).Times(1);
         } else {
             EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(0);
-            EXPECT_CALL(*async_log_queue_engine_mock, processLogMessage(_)).Times(0);
+            EXPECT_CALL(*async_log_queue_engine_mock, processLogMessage(_, _, _, _)).Times(0);
         }
 
-        equinox_Logger_engine_impl.logMessage(testCase.level, kFormattedOutputMessage);
+        equinox_Logger_engine_impl.logMessage(testCase.level, kCallSiteId, kFormattedOutputMessage, false);
     }
 
     INSTANTIATE_TEST_SUITE_P(AllLogLevels, EquinoxLoggerEngineImplParameterizedTest,
-                             Values(LogLevelTestCase{level::LOG_LEVEL::trace, "[TRACE] Test log", true, "Trace"},
-                                    LogLevelTestCase{level::LOG_LEVEL::debug, "[DEBUG] Test log", true, "Debug"},
-                                    LogLevelTestCase{level::LOG_LEVEL::info, "[INFO] Test log", true, "Info"},
-                                    LogLevelTestCase{level::LOG_LEVEL::warning, "[WARNING] Test log", true, "Warning"},
-                                    LogLevelTestCase{level::LOG_LEVEL::error, "[ERROR] Test log", true, "Error"},
-                                    LogLevelTestCase{level::LOG_LEVEL::critical, "[CRITICAL] Test log", true, "Critical"},
-                                    LogLevelTestCase{level::LOG_LEVEL::off, "", false, "Off"}),
+                             Values(LogLevelTestCase{level::LOG_LEVEL::trace, true, "Trace"},
+                                    LogLevelTestCase{level::LOG_LEVEL::debug, true, "Debug"},
+                                    LogLevelTestCase{level::LOG_LEVEL::info, true, "Info"},
+                                    LogLevelTestCase{level::LOG_LEVEL::warning, true, "Warning"},
+                                    LogLevelTestCase{level::LOG_LEVEL::error, true, "Error"},
+                                    LogLevelTestCase{level::LOG_LEVEL::critical, true, "Critical"},
+                                    LogLevelTestCase{level::LOG_LEVEL::off, false, "Off"}),
                              GetLogLevelTestCaseName);
 
-    TEST_P(EquinoxLoggerEngineImplSetupLogLevelParameterizedTest, Setup_Logger_For_All_Log_Levels) {
-        const SetupLogLevelTestCase testCase = GetParam();
-
-        EXPECT_CALL(*async_log_queue_engine_mock, setLogsOutputSink(logs_output::SINK::console)).Times(1);
-        EXPECT_CALL(*file_logs_producer_mock, setupFile(_, _, _)).Times(0);
-        EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(1);
+    TEST_P(EquinoxLoggerEngineImplParameterizedTest, Log_Deferred_Message_For_All_Log_Levels_Is_Processed_According_To_Level) {
+        const LogLevelTestCase testCase = GetParam();
+        const std::string kEncodedMessage = "encoded";
 
-        const bool setupResult =
-            equinox_Logger_engine_impl.setup(testCase.level, kLogPrefix, logs_output::SINK::console, kLogFileName, kMaxLogFileSizeBytes, kMaxLogFiles);
+        if (testCase.shouldProcess) {
+            EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(1);
+            EXPECT_CALL(*async_log_queue_engine_mock, processDeferredLogMessage(testCase.level, kCallSiteId, kEncodedMessage, false)).Times(1);
+        } else {
+            EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(0);
+            EXPECT_CALL(*async_log_queue_engine_mock, processDeferredLogMessage(_, _, _, _)).Times(0);
+        }
 
-        EXPECT_TRUE(setupResult);
-        EXPECT_EQ(equinox_Logger_engine_impl.getLogLevelForTests(), testCase.level);
-        EXPECT_EQ(equinox_Logger_engine_impl.getLogPrefixForTests(), kExpectedLogPrefix);
-        EXPECT_EQ(equinox_Logger_engine_impl.getLogFileNameForTests(), kLogFileName);
-        EXPECT_EQ(equinox_Logger_engine_impl.getMaxLogFileSizeBytesForTests(), kMaxLogFileSizeBytes);
-        EXPECT_EQ(equinox_Logger_engine_impl.getMaxLogFilesForTests(), kMaxLogFiles);
+        equinox_Logger_engine_impl.logDeferredMessage(testCase.level, kCallSiteId, kEncodedMessage, false);
     }
 
-    INSTANTIATE_TEST_SUITE_P(AllSetupLogLevels, EquinoxLoggerEngineImplSetupLogLevelParameterizedTest,
-                             Values(SetupLogLevelTestCase{level::LOG_LEVEL::trace, "Trace"}, SetupLogLevelTestCase{level::LOG_LEVEL::debug, "Debug"},
-                                    SetupLogLevelTestCase{level::LOG_LEVEL::info, "Info"}, SetupLogLevelTestCase{level::LOG_LEVEL::warning, "Warning"},
-                                    SetupLogLevelTestCase{level::LOG_LEVEL::error, "Error"}, SetupLogLevelTestCase{level::LOG_LEVEL::critical, "Critical"},
-                                    SetupLogLevelTestCase{level::LOG_LEVEL::off, "Off"}),
-                             GetSetupLogLevelTestCaseName);
-
     TEST_P(EquinoxLoggerEngineImplSetupSinkParameterizedTest, Setup_Logger_For_All_Output_Sinks) {
         const SetupSinkTestCase testCase = GetParam();
 
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogPrefix(kExpectedLogPrefix)).Times(1);
         EXPECT_CALL(*async_log_queue_engine_mock, setLogsOutputSink(testCase.sink)).Times(1);
         EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(1);
 
@@ -172,10 +140,9 @@ namespace equinox_logger_engine_impl_test {
         }
 
         const bool setupResult =
-            equinox_Logger_engine_impl.setup(level::LOG_LEVEL::info, kLogPrefix, testCase.sink, kLogFileName, kMaxLogFileSizeBytes, kMaxLogFiles);
+            equinox_Logger_engine_impl.setup(kLogPrefix, testCase.sink, kLogFileName, kMaxLogFileSizeBytes, kMaxLogFiles);
 
         EXPECT_TRUE(setupResult);
-        EXPECT_EQ(equinox_Logger_engine_impl.getLogLevelForTests(), level::LOG_LEVEL::info);
         EXPECT_EQ(equinox_Logger_engine_impl.getLogPrefixForTests(), kExpectedLogPrefix);
         EXPECT_EQ(equinox_Logger_engine_impl.getLogFileNameForTests(), kLogFileName);
         EXPECT_EQ(equinox_Logger_engine_impl.getMaxLogFileSizeBytesForTests(), kMaxLogFileSizeBytes);
@@ -187,30 +154,16 @@ namespace equinox_logger_engine_impl_test {
                                     SetupSinkTestCase{logs_output::SINK::console_and_file, true, "ConsoleAndFile"}),
                              GetSetupSinkTestCaseName);
 
-    TEST_P(EquinoxLoggerEngineImplChangeLevelParameterizedTest, Change_Log_Level_For_All_Levels) {
-        const ChangeLevelTestCase testCase = GetParam();
-
-        equinox_Logger_engine_impl.changeLevel(testCase.level);
-
-        EXPECT_EQ(equinox_Logger_engine_impl.getLogLevelForTests(), testCase.level);
-    }
-
-    INSTANTIATE_TEST_SUITE_P(AllChangeLevels, EquinoxLoggerEngineImplChangeLevelParameterizedTest,
-                             Values(ChangeLevelTestCase{level::LOG_LEVEL::trace, "Trace"}, ChangeLevelTestCase{level::LOG_LEVEL::debug, "Debug"},
-                                    ChangeLevelTestCase{level::LOG_LEVEL::info, "Info"}, ChangeLevelTestCase{level::LOG_LEVEL::warning, "Warning"},
-                                    ChangeLevelTestCase{level::LOG_LEVEL::error, "Error"}, ChangeLevelTestCase{level::LOG_LEVEL::critical, "Critical"},
-                                    ChangeLevelTestCase{level::LOG_LEVEL::off, "Off"}),
-                             GetChangeLevelTestCaseName);
-
     TEST_P(EquinoxLoggerEngineImplChangeSinkParameterizedTest, Change_Logs_Output_Sink_For_All_Sinks) {
         const SetupSinkTestCase testCase = GetParam();
 
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogPrefix(kExpectedLogPrefix)).Times(1);
         EXPECT_CALL(*async_log_queue_engine_mock, setLogsOutputSink(logs_output::SINK::console)).Times(1);
         EXPECT_CALL(*file_logs_producer_mock, setupFile(_, _, _)).Times(0);
         EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(1);
 
         ASSERT_TRUE(
-            equinox_Logger_engine_impl.setup(level::LOG_LEVEL::info, kLogPrefix, logs_output::SINK::console, kLogFileName, kMaxLogFileSizeBytes, kMaxLogFiles));
+            equinox_Logger_engine_impl.setup(kLogPrefix, logs_output::SINK::console, kLogFileName, kMaxLogFileSizeBytes, kMaxLogFiles));
 
         Mock::VerifyAndClearExpectations(async_log_queue_engine_mock);
         Mock::VerifyAndClearExpectations(file_logs_producer_mock);
@@ -233,6 +186,76 @@ namespace equinox_logger_engine_impl_test {
                                     SetupSinkTestCase{logs_output::SINK::console_and_file, true, "ConsoleAndFile"}),
                              GetSetupSinkTestCaseName);
 
+    TEST_F(EquinoxLoggerEngineImplTest, Try_Setup_File_Output_But_Log_File_Not_Opened_And_Setup_Failed) {
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogPrefix(kExpectedLogPrefix)).Times(1);
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogsOutputSink(logs_output::SINK::file)).Times(1);
+        EXPECT_CALL(*file_logs_producer_mock, setupFile(kLogFileName, kMaxLogFileSizeBytes, kMaxLogFiles)).WillOnce(Return(ENOENT));
+        EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(0);
+
+        EXPECT_FALSE(
+            equinox_Logger_engine_impl.setup(kLogPrefix, logs_output::SINK::file, kLogFileName, kMaxLogFileSizeBytes, kMaxLogFiles));
+    }
+
+    TEST_F(EquinoxLoggerEngineImplTest, Try_Change_Logs_Output_Sink_To_File_But_Log_File_Not_Opened_And_Change_Failed) {
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogsOutputSink(logs_output::SINK::console_and_file)).Times(1);
+        EXPECT_CALL(*file_logs_producer_mock, setupFile(_, _, _)).WillOnce(Return(EACCES));
+
+        EXPECT_FALSE(equinox_Logger_engine_impl.changeLogsOutputSink(logs_output::SINK::console_and_file));
+    }
+
+    TEST_F(EquinoxLoggerEngineImplTest, Setup_Again_With_New_Prefix_And_It_Is_Passed_To_Sinks_While_Messages_Are_Queued_Without_It) {
+        InSequence sequence;
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogPrefix("[First]")).Times(1);
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogsOutputSink(logs_output::SINK::console)).Times(1);
+        EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(1);
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogPrefix("[Second]")).Times(1);
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogsOutputSink(logs_output::SINK::console)).Times(1);
+        EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(2);
+        EXPECT_CALL(*async_log_queue_engine_mock, processLogMessage(level::LOG_LEVEL::info, kCallSiteId, kFormattedOutputMessage, false)).Times(1);
+
+        ASSERT_TRUE(equinox_Logger_engine_impl.setup("First", logs_output::SINK::console, kLogFileName, kDefaultMaxLogFileSizeBytes, kDefaultMaxLogFiles));
+        ASSERT_TRUE(equinox_Logger_engine_impl.setup("Second", logs_output::SINK::console, kLogFileName, kDefaultMaxLogFileSizeBytes, kDefaultMaxLogFiles));
+        equinox_Logger_engine_impl.logMessage(level::LOG_LEVEL::info, kCallSiteId, kFormattedOutputMessage, false);
+
+        EXPECT_EQ(equinox_Logger_engine_impl.getLogPrefixForTests(), "[Second]");
+    }
+
+    TEST_F(EquinoxLoggerEngineImplTest, Setup_With_Options_Sets_Queue_Type_And_File_Settings) {
+        LoggerOptions options;
+        options.logFileName = "options.log";
+        options.maxLogFileSizeBytes = 2048U;
+        options.maxLogFiles = 3U;
+        options.queueType = queue::TYPE::per_thread;
+
+        EXPECT_CALL(*async_log_queue_engine_mock, configureQueue(Field(&LoggerOptions::queueType, queue::TYPE::per_thread))).Times(1);
+        EXPECT_CALL(*file_logs_producer_mock, setIoBackend(options.fileIoBackend)).Times(1);
+        EXPECT_CALL(*file_logs_producer_mock, setDurability(options.fileDurability, options.fileSyncIntervalMs, options.fileSyncBytes)).Times(1);
+        EXPECT_CALL(*file_logs_producer_mock, setPageCacheMode(options.filePageCache)).Times(1);
+        EXPECT_CALL(*file_logs_producer_mock, setCompression(options.fileCompression)).Times(1);
+        EXPECT_CALL(*file_logs_producer_mock, setRotationPeriod(options.fileRotationPeriod, options.timestampZone)).Times(1);
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogPrefix(kExpectedLogPrefix)).Times(1);
+        EXPECT_CALL(*async_log_queue_engine_mock, setLogsOutputSink(logs_output::SINK::file)).Times(1);
+        EXPECT_CALL(*file_logs_producer_mock, setupFile("options.log", 2048U, 3U)).Times(1);
+        EXPECT_CALL(*async_log_queue_engine_mock, startWorkerIfNeeded()).Times(1);
+
+        EXPECT_TRUE(equinox_Logger_engine_impl.setup("TestPrefix", logs_output::SINK::file, options));
+        EXPECT_EQ(equinox_Logger_engine_impl.getLogFileNameForTests(), "options.log");
+        EXPECT_EQ(equinox_Logger_engine_impl.getMaxLogFileSizeBytesForTests(), 2048U);
+        EXPECT_EQ(equinox_Logger_engine_impl.getMaxLogFilesForTests(), 3U);
+    }
+
+    TEST_F(EquinoxLoggerEngineImplTest, Get_File_Write_Stats_And_Stats_Of_File_Logs_Producer_Returned) {
+        FileWriteStats stats;
+        stats.writeCount = 3U;
+        stats.syncMaxNs = 2000U;
+        EXPECT_CALL(*file_logs_producer_mock, getWriteStats()).WillOnce(Return(stats));
+
+        const FileWriteStats result = equinox_Logger_engine_impl.getFileWriteStats();
+
+        EXPECT_EQ(result.writeCount, 3U);
+        EXPECT_EQ(result.syncMaxNs, 2000U);
+    }
+
     TEST_F(EquinoxLoggerEngineImplTest, Flush_Method_Calls_Flush_From_AsyncLogQueueEngine) {
         EXPECT_CALL(*async_log_queue_engine_mock, flush()).Times(1);
 
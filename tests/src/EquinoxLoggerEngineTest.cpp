@@ -7,6 +7,7 @@
 #include <thread>
 #include <vector>
 
+#include "DeferredMessageFormatter.h"
 #include "EquinoxLoggerEngine.h"
 #include "EquinoxLoggerEngineImplMock.h"
 
@@ -66,13 +67,30 @@ namespace equinox_logger_engine_impl_test {
     }
 
     TEST_F(EquinoxLoggerEngineTest, Call_Log_With_Format_Arguments_And_Verify_LogMessage_Called_With_Formatted_Text) {
-        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(level::LOG_LEVEL::info, "Test value: 42")).Times(1);
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(level::LOG_LEVEL::info, _, "Test value: 42", false)).Times(1);
 
         equinox_logger_engine.log(level::LOG_LEVEL::info, "Test %s: %d", "value", 42);
     }
 
+    TEST_F(EquinoxLoggerEngineTest, Call_Log_From_Same_Call_Site_Twice_And_Verify_Call_Site_Id_Is_Stable) {
+        std::vector<std::uint32_t> callSiteIds;
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(level::LOG_LEVEL::info, _, _, false))
+            .Times(3)
+            .WillRepeatedly(DoAll(Invoke([&callSiteIds](level::LOG_LEVEL, std::uint32_t callSiteId, std::string_view, bool) { callSiteIds.push_back(callSiteId); }),
+                                  Return(true)));
+
+        for (int i = 0; i < 2; ++i) {
+            equinox_logger_engine.log(level::LOG_LEVEL::info, "Iteration %d", i);
+        }
+        equinox_logger_engine.log(level::LOG_LEVEL::info, "Other call site %d", 2);
+
+        ASSERT_EQ(callSiteIds.size(), 3U);
+        EXPECT_EQ(callSiteIds[0], callSiteIds[1]);
+        EXPECT_NE(callSiteIds[0], callSiteIds[2]);
+    }
+
     TEST_F(EquinoxLoggerEngineTest, Call_Log_With_Invalid_Format_And_Verify_LogMessage_Is_Not_Called) {
-        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(_, _)).Times(0);
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(_, _, _, _)).Times(0);
 
         equinox_logger_engine.log(level::LOG_LEVEL::error, "%");
     }
@@ -80,30 +98,95 @@ namespace equinox_logger_engine_impl_test {
     TEST_F(EquinoxLoggerEngineTest, Call_Log_With_Message_Exceeding_Buffer_Size_And_Verify_Message_Is_Truncated_And_LogMessage_Is_Called) {
         const std::string veryLongMessage(5000, 'A');
 
-        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(level::LOG_LEVEL::warning, Truly([](const std::string& msg) {
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(level::LOG_LEVEL::warning, _, Truly([](std::string_view msg) {
                                                                      return msg.size() == 4095 &&
                                                                          std::all_of(msg.begin(), msg.end(), [](char c) { return c == 'A'; });
-                                                                 })))
+                                                                 }),
+                                                                 false))
             .Times(1);
 
         equinox_logger_engine.log(level::LOG_LEVEL::warning, "%s", veryLongMessage.c_str());
     }
 
-    TEST_F(EquinoxLoggerEngineTest, Call_Log_From_Many_Threads_And_Verify_Mutex_Serializes_LogMessage_Calls) {
+    TEST_F(EquinoxLoggerEngineTest, Change_Level_And_Verify_Messages_Below_Level_Are_Dropped_Before_Reaching_Engine_Impl) {
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(level::LOG_LEVEL::info, _, _, false)).Times(0);
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(level::LOG_LEVEL::error, _, "Error 7", false)).Times(1);
+
+        equinox_logger_engine.changeLevel(level::LOG_LEVEL::warning);
+        equinox_logger_engine.log(level::LOG_LEVEL::info, "Info %d", 5);
+        equinox_logger_engine.log(level::LOG_LEVEL::error, "Error %d", 7);
+    }
+
+    TEST_F(EquinoxLoggerEngineTest, Setup_Level_And_Verify_Messages_Below_Level_Are_Dropped_Before_Reaching_Engine_Impl) {
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, setup(_, _, _, _, _)).Times(1).WillOnce(Return(true));
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(_, _, _, _)).Times(0);
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logDeferredMessage(_, _, _, _)).Times(0);
+
+        ASSERT_TRUE(equinox_logger_engine.setup(level::LOG_LEVEL::error, kTestLogPrefix, logs_output::SINK::console));
+        equinox_logger_engine.log(level::LOG_LEVEL::warning, "Warning %d", 1);
+        equinox_logger_engine.changeFormattingMode(formatting::MODE::deferred);
+        equinox_logger_engine.log(level::LOG_LEVEL::trace, "Trace %d", 2);
+    }
+
+    TEST_F(EquinoxLoggerEngineTest, Call_Log_With_Off_Level_And_Verify_LogMessage_Is_Not_Called) {
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(_, _, _, _)).Times(0);
+
+        equinox_logger_engine.log(level::LOG_LEVEL::off, "Off %d", 1);
+    }
+
+    TEST_F(EquinoxLoggerEngineTest, Check_Level_Enabled_For_Levels_Below_And_Above_Current_Level) {
+        equinox_logger_engine.changeLevel(level::LOG_LEVEL::info);
+
+        EXPECT_FALSE(equinox_logger_engine.isLevelEnabled(level::LOG_LEVEL::trace));
+        EXPECT_FALSE(equinox_logger_engine.isLevelEnabled(level::LOG_LEVEL::debug));
+        EXPECT_TRUE(equinox_logger_engine.isLevelEnabled(level::LOG_LEVEL::info));
+        EXPECT_TRUE(equinox_logger_engine.isLevelEnabled(level::LOG_LEVEL::critical));
+        EXPECT_FALSE(equinox_logger_engine.isLevelEnabled(level::LOG_LEVEL::off));
+    }
+
+    TEST_F(EquinoxLoggerEngineTest, Change_Formatting_Mode_To_Deferred_And_Verify_LogDeferredMessage_Called_With_Encoded_Arguments) {
+        std::string encodedMessage;
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(_, _, _, _)).Times(0);
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logDeferredMessage(level::LOG_LEVEL::info, _, _, false)).Times(1).WillOnce(DoAll(SaveArg<2>(&encodedMessage), Return(true)));
+
+        equinox_logger_engine.changeFormattingMode(formatting::MODE::deferred);
+        equinox_logger_engine.log(level::LOG_LEVEL::info, "Test %s: %d", "value", 42);
+
+        std::string formattedMessage;
+        DeferredMessageFormatter deferredMessageFormatter;
+        ASSERT_TRUE(deferredMessageFormatter.format(encodedMessage, formattedMessage));
+        EXPECT_EQ(formattedMessage, "Test value: 42");
+    }
+
+    TEST_F(EquinoxLoggerEngineTest, Change_Formatting_Mode_Back_To_Immediate_And_Verify_LogMessage_Called_With_Formatted_Text) {
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logDeferredMessage(_, _, _, _)).Times(0);
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(level::LOG_LEVEL::info, _, "Test value: 42", false)).Times(1);
+
+        equinox_logger_engine.changeFormattingMode(formatting::MODE::deferred);
+        equinox_logger_engine.changeFormattingMode(formatting::MODE::immediate);
+        equinox_logger_engine.log(level::LOG_LEVEL::info, "Test %s: %d", "value", 42);
+    }
+
+    TEST_F(EquinoxLoggerEngineTest, Call_Log_From_Many_Threads_And_Verify_LogMessage_Calls_Run_Concurrently) {
         constexpr int kThreadCount = 8;
         std::atomic<int> activeCalls{0};
         std::atomic<int> maxActiveCalls{0};
 
-        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(level::LOG_LEVEL::info, _))
+        EXPECT_CALL(*equinox_logger_engine_impl_mock, logMessage(level::LOG_LEVEL::info, _, _, false))
             .Times(kThreadCount)
-            .WillRepeatedly(Invoke([&](level::LOG_LEVEL, const std::string&) {
+            .WillRepeatedly(Invoke([&](level::LOG_LEVEL, std::uint32_t, std::string_view, bool) {
                 const int nowActive = ++activeCalls;
                 int observedMax = maxActiveCalls.load();
                 while (nowActive > observedMax && !maxActiveCalls.compare_exchange_weak(observedMax, nowActive)) {
                 }
 
-                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                /* Every call waits for all the others, which can only finish if no lock serializes them */
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                while (maxActiveCalls.load() < kThreadCount && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
                 --activeCalls;
+                return true;
             }));
 
         std::vector<std::thread> workers;
@@ -116,18 +199,19 @@ namespace equinox_logger_engine_impl_test {
             worker.join();
         }
 
-        EXPECT_EQ(maxActiveCalls.load(), 1);
+        EXPECT_EQ(maxActiveCalls.load(), kThreadCount);
     }
 
     TEST_P(EquinoxLoggerEngineSetupParamTest, Call_Setup_With_Various_Levels_Console_Sink_And_Verify_Parameters_And_Returns_True) {
         const auto logLevel = GetParam();
         EXPECT_CALL(*equinox_logger_engine_impl_mock,
-                    setup(logLevel, kTestLogPrefix, logs_output::SINK::console, kTestLogFileName, kTestMaxLogFileSizeBytes, kTestMaxLogFiles))
+                    setup(kTestLogPrefix, logs_output::SINK::console, kTestLogFileName, kTestMaxLogFileSizeBytes, kTestMaxLogFiles))
             .Times(1)
             .WillOnce(Return(true));
 
         EXPECT_TRUE(
             equinox_logger_engine.setup(logLevel, kTestLogPrefix, logs_output::SINK::console, kTestLogFileName, kTestMaxLogFileSizeBytes, kTestMaxLogFiles));
+        EXPECT_TRUE(equinox_logger_engine.isLevelEnabled(logLevel));
     }
 
     INSTANTIATE_TEST_SUITE_P(SetupWithAllLogLevels, EquinoxLoggerEngineSetupParamTest,
@@ -137,7 +221,7 @@ namespace equinox_logger_engine_impl_test {
     TEST_P(EquinoxLoggerEngineSetupParamTest, Try_Setup_But_EquinoxLoggerEngineImpl_Returns_False_And_False_Is_Returned) {
         const auto logLevel = GetParam();
         EXPECT_CALL(*equinox_logger_engine_impl_mock,
-                    setup(logLevel, kTestLogPrefix, logs_output::SINK::console, kTestLogFileName, kTestMaxLogFileSizeBytes, kTestMaxLogFiles))
+                    setup(kTestLogPrefix, logs_output::SINK::console, kTestLogFileName, kTestMaxLogFileSizeBytes, kTestMaxLogFiles))
             .Times(1)
             .WillOnce(Return(false));
 
@@ -145,11 +229,14 @@ namespace equinox_logger_engine_impl_test {
             equinox_logger_engine.setup(logLevel, kTestLogPrefix, logs_output::SINK::console, kTestLogFileName, kTestMaxLogFileSizeBytes, kTestMaxLogFiles));
     }
 
-    TEST_P(EquinoxLoggerEngineSetupParamTest, Change_Level_And_Verify_ChangeLevel_Called_With_Correct_Parameter) {
+    TEST_P(EquinoxLoggerEngineSetupParamTest, Change_Level_And_Verify_Only_Messages_From_That_Level_Up_Are_Enabled) {
         const auto logLevel = GetParam();
-        EXPECT_CALL(*equinox_logger_engine_impl_mock, changeLevel(logLevel)).Times(1);
 
         equinox_logger_engine.changeLevel(logLevel);
+
+        EXPECT_TRUE(equinox_logger_engine.isLevelEnabled(logLevel));
+        EXPECT_TRUE(equinox_logger_engine.isLevelEnabled(level::LOG_LEVEL::critical));
+        EXPECT_EQ(equinox_logger_engine.isLevelEnabled(level::LOG_LEVEL::trace), logLevel == level::LOG_LEVEL::trace);
     }
 
     TEST_P(EquinoxLoggerEngineSinkParamTest, Change_Logs_Output_Sink_And_Verify_ChangeLogsOutputSink_Called_With_Correct_Parameter_And_Returns_True) {
@@ -161,6 +248,18 @@ namespace equinox_logger_engine_impl_test {
     INSTANTIATE_TEST_SUITE_P(ChangeLogsOutputSinkWithAllSupportedSinks, EquinoxLoggerEngineSinkParamTest,
                              Values(logs_output::SINK::console, logs_output::SINK::file, logs_output::SINK::console_and_file));
 
+    TEST_F(EquinoxLoggerEngineTest, Call_Setup_With_Options_And_Verify_Options_Are_Forwarded_And_Level_Is_Applied) {
+        LoggerOptions options;
+        options.queueType = queue::TYPE::per_thread;
+        EXPECT_CALL(*equinox_logger_engine_impl_mock,
+                    setup(kTestLogPrefix, logs_output::SINK::console, Field(&LoggerOptions::queueType, queue::TYPE::per_thread)))
+            .Times(1)
+            .WillOnce(Return(true));
+
+        EXPECT_TRUE(equinox_logger_engine.setup(level::LOG_LEVEL::warning, kTestLogPrefix, logs_output::SINK::console, options));
+        EXPECT_FALSE(equinox_logger_engine.isLevelEnabled(level::LOG_LEVEL::info));
+    }
+
     TEST_F(EquinoxLoggerEngineTest, Call_Flush_And_Verify_Flush_Called) {
         EXPECT_CALL(*equinox_logger_engine_impl_mock, flush()).Times(1);
 
@@ -7,6 +7,7 @@
 #include <functional>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "EquinoxLogger.h"
 
@@ -127,6 +128,65 @@ namespace equinox_logger_test {
         VerifyLogEmission("[CRITICAL]", "critical_public_api_message", []() { equinox::critical("%s", "critical_public_api_message"); });
     }
 
+    TEST(EquinoxLoggerTest, Deferred_Formatting_Mode_Emits_Message_Formatted_By_Worker) {
+        equinox::changeFormattingMode(equinox::formatting::MODE::deferred);
+        VerifyLogEmission("[INFO]", "deferred_public_api_message_42", []() { equinox::info("%s_%d", "deferred_public_api_message", 42); });
+        equinox::changeFormattingMode(equinox::formatting::MODE::immediate);
+    }
+
+    TEST(EquinoxLoggerTest, Per_Thread_Queue_Emits_Messages_From_Many_Threads) {
+        const std::string logFilePath = "/tmp/equinox_logger_api_per_thread_queue.log";
+        std::filesystem::remove(logFilePath);
+
+        equinox::LoggerOptions options;
+        options.logFileName = logFilePath;
+        options.queueType = equinox::queue::TYPE::per_thread;
+        ASSERT_TRUE(equinox::setup(equinox::level::LOG_LEVEL::trace, kLogPrefix, equinox::logs_output::SINK::file, options));
+
+        std::vector<std::thread> producers;
+        for (int i = 0; i < 4; ++i) {
+            producers.emplace_back([i]() { equinox::info("per_thread_queue_message_%d", i); });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_TRUE(WaitForFileToContain(logFilePath, "per_thread_queue_message_" + std::to_string(i)));
+        }
+
+        options.queueType = equinox::queue::TYPE::shared;
+        ASSERT_TRUE(equinox::setup(equinox::level::LOG_LEVEL::trace, kLogPrefix, equinox::logs_output::SINK::file, options));
+        equinox::info("shared_queue_message");
+        EXPECT_TRUE(WaitForFileToContain(logFilePath, "shared_queue_message"));
+    }
+
+    TEST(EquinoxLoggerTest, Byte_Ring_And_Per_Cpu_Queues_Emit_Messages) {
+        const std::string logFilePath = "/tmp/equinox_logger_api_byte_ring_queue.log";
+        std::filesystem::remove(logFilePath);
+
+        equinox::LoggerOptions options;
+        options.logFileName = logFilePath;
+        options.queueType = equinox::queue::TYPE::byte_ring;
+        ASSERT_TRUE(equinox::setup(equinox::level::LOG_LEVEL::trace, kLogPrefix, equinox::logs_output::SINK::file, options));
+
+        equinox::info("byte_ring_text_message_%d", 1);
+        equinox::changeFormattingMode(equinox::formatting::MODE::deferred);
+        equinox::info("byte_ring_deferred_message_%d", 2);
+        equinox::changeFormattingMode(equinox::formatting::MODE::immediate);
+
+        EXPECT_TRUE(WaitForFileToContain(logFilePath, "byte_ring_text_message_1"));
+        EXPECT_TRUE(WaitForFileToContain(logFilePath, "byte_ring_deferred_message_2"));
+
+        options.queueType = equinox::queue::TYPE::per_cpu;
+        ASSERT_TRUE(equinox::setup(equinox::level::LOG_LEVEL::trace, kLogPrefix, equinox::logs_output::SINK::file, options));
+        equinox::info("per_cpu_text_message_%d", 3);
+        EXPECT_TRUE(WaitForFileToContain(logFilePath, "per_cpu_text_message_3"));
+
+        options.queueType = equinox::queue::TYPE::shared;
+        ASSERT_TRUE(equinox::setup(equinox::level::LOG_LEVEL::trace, kLogPrefix, equinox::logs_output::SINK::file, options));
+    }
+
     TEST(EquinoxLoggerTest, ChangeLogsOutputSink_To_Console_And_Returns_True) {
         ASSERT_TRUE(equinox::setup(equinox::level::LOG_LEVEL::trace, kLogPrefix, equinox::logs_output::SINK::file));
         EXPECT_TRUE(equinox::changeLogsOutputSink(equinox::logs_output::SINK::console));
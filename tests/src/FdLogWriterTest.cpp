@@ -0,0 +1,177 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "FdLogWriter.h"
+
+namespace fd_log_writer_test {
+    using namespace equinox;
+
+    namespace {
+        const std::string kTestLogFileName = "fd_writer_test.log";
+        const std::string kTestLine = "[time123][Test][INFO] fd line\n";
+
+        std::string readFile(const std::string& fileName) {
+            std::ifstream file(fileName);
+            std::stringstream content;
+            content << file.rdbuf();
+            return content.str();
+        }
+    }
+
+    /* Each write() is answered from the script first: a negative entry fails with that errno, a positive one is
+     * the most bytes that call writes */
+    class FdLogWriterTestable : public FdLogWriter {
+       public:
+        ssize_t writeOnce(const char* data, std::size_t size) override {
+            ++writeCalls;
+            if (script.empty()) {
+                return FdLogWriter::writeOnce(data, size);
+            }
+            const int step = script.front();
+            script.pop_front();
+            if (step < 0) {
+                errno = -step;
+                return -1;
+            }
+            return FdLogWriter::writeOnce(data, std::min(size, static_cast<std::size_t>(step)));
+        }
+
+        std::deque<int> script;
+        std::size_t writeCalls = 0U;
+    };
+
+    class FdLogWriterTest : public ::testing::Test {
+       public:
+        FdLogWriterTest() {
+            std::filesystem::remove(kTestLogFileName);
+        }
+
+        ~FdLogWriterTest() override {
+            fd_log_writer.close();
+            std::filesystem::remove(kTestLogFileName);
+        }
+
+        FdLogWriterTestable fd_log_writer;
+    };
+
+    TEST_F(FdLogWriterTest, Try_Open_But_Directory_Does_Not_Exist_And_Errno_Returned) {
+        EXPECT_EQ(fd_log_writer.open("missing_directory/fd_writer_test.log", false), ENOENT);
+
+        EXPECT_FALSE(fd_log_writer.isOpen());
+    }
+
+    TEST_F(FdLogWriterTest, Try_Open_Next_File_But_Open_Failed_And_Lines_Still_Written_To_Current_File) {
+        ASSERT_EQ(fd_log_writer.open(kTestLogFileName, false), 0);
+
+        EXPECT_EQ(fd_log_writer.open("missing_directory/fd_writer_test.log", true), ENOENT);
+
+        ASSERT_TRUE(fd_log_writer.isOpen());
+        ASSERT_EQ(fd_log_writer.write(kTestLine.data(), kTestLine.size()), 0);
+        EXPECT_EQ(readFile(kTestLogFileName), kTestLine);
+    }
+
+    TEST_F(FdLogWriterTest, Try_Write_But_File_Is_Not_Open) {
+        EXPECT_EQ(fd_log_writer.write(kTestLine.data(), kTestLine.size()), EBADF);
+    }
+
+    TEST_F(FdLogWriterTest, Open_And_Descriptor_Is_Append_Only_And_Closed_On_Exec) {
+        ASSERT_EQ(fd_log_writer.open(kTestLogFileName, false), 0);
+
+        EXPECT_NE(fcntl(fd_log_writer.getFd(), F_GETFL) & O_APPEND, 0);
+        EXPECT_NE(fcntl(fd_log_writer.getFd(), F_GETFD) & FD_CLOEXEC, 0);
+    }
+
+    TEST_F(FdLogWriterTest, Open_Existing_File_And_Lines_Appended_After_Its_Content) {
+        {
+            std::ofstream existingFile(kTestLogFileName);
+            existingFile << kTestLine;
+        }
+
+        ASSERT_EQ(fd_log_writer.open(kTestLogFileName, false), 0);
+        EXPECT_EQ(fd_log_writer.getSize(), kTestLine.size());
+        ASSERT_EQ(fd_log_writer.write(kTestLine.data(), kTestLine.size()), 0);
+
+        EXPECT_EQ(fd_log_writer.getSize(), 2U * kTestLine.size());
+        EXPECT_EQ(readFile(kTestLogFileName), kTestLine + kTestLine);
+    }
+
+    TEST_F(FdLogWriterTest, Open_Truncated_And_Previous_Content_Removed) {
+        {
+            std::ofstream existingFile(kTestLogFileName);
+            existingFile << kTestLine;
+        }
+
+        ASSERT_EQ(fd_log_writer.open(kTestLogFileName, true), 0);
+
+        EXPECT_EQ(fd_log_writer.getSize(), 0U);
+        EXPECT_EQ(std::filesystem::file_size(kTestLogFileName), 0U);
+    }
+
+    TEST_F(FdLogWriterTest, Write_After_Another_Writer_Appended_And_Nothing_Overwritten) {
+        ASSERT_EQ(fd_log_writer.open(kTestLogFileName, false), 0);
+        const int otherFd = ::open(kTestLogFileName.c_str(), O_WRONLY | O_APPEND);
+        ASSERT_GE(otherFd, 0);
+        ASSERT_EQ(::write(otherFd, "other\n", 6U), 6);
+        ::close(otherFd);
+
+        ASSERT_EQ(fd_log_writer.write(kTestLine.data(), kTestLine.size()), 0);
+
+        EXPECT_EQ(readFile(kTestLogFileName), "other\n" + kTestLine);
+    }
+
+    TEST_F(FdLogWriterTest, Write_Interrupted_And_Short_Writes_And_Whole_Batch_Written) {
+        ASSERT_EQ(fd_log_writer.open(kTestLogFileName, false), 0);
+        fd_log_writer.script = {-EINTR, 5, -EINTR, 7};
+
+        ASSERT_EQ(fd_log_writer.write(kTestLine.data(), kTestLine.size()), 0);
+
+        EXPECT_EQ(fd_log_writer.writeCalls, 5U);
+        EXPECT_EQ(fd_log_writer.getSize(), kTestLine.size());
+        EXPECT_EQ(readFile(kTestLogFileName), kTestLine);
+    }
+
+    TEST_F(FdLogWriterTest, Try_Write_But_Write_Failed_After_Short_Write_And_Errno_Returned) {
+        ASSERT_EQ(fd_log_writer.open(kTestLogFileName, false), 0);
+        fd_log_writer.script = {5, -ENOSPC};
+
+        EXPECT_EQ(fd_log_writer.write(kTestLine.data(), kTestLine.size()), ENOSPC);
+
+        EXPECT_EQ(fd_log_writer.getSize(), 5U);
+        EXPECT_EQ(readFile(kTestLogFileName), kTestLine.substr(0U, 5U));
+    }
+
+    TEST_F(FdLogWriterTest, Try_Write_But_Nothing_Written_And_Io_Error_Returned_Instead_Of_Retrying) {
+        ASSERT_EQ(fd_log_writer.open(kTestLogFileName, false), 0);
+        fd_log_writer.script = {0};
+
+        EXPECT_EQ(fd_log_writer.write(kTestLine.data(), kTestLine.size()), EIO);
+        EXPECT_EQ(fd_log_writer.writeCalls, 1U);
+    }
+
+    TEST_F(FdLogWriterTest, Try_Write_To_Full_Device_And_No_Space_Returned) {
+        ASSERT_EQ(fd_log_writer.open("/dev/full", false), 0);
+
+        EXPECT_EQ(fd_log_writer.write(kTestLine.data(), kTestLine.size()), ENOSPC);
+    }
+
+    TEST_F(FdLogWriterTest, Sync_And_Close_Successfully) {
+        ASSERT_EQ(fd_log_writer.open(kTestLogFileName, false), 0);
+        ASSERT_EQ(fd_log_writer.write(kTestLine.data(), kTestLine.size()), 0);
+
+        EXPECT_EQ(fd_log_writer.sync(), 0);
+        EXPECT_EQ(fd_log_writer.close(), 0);
+        EXPECT_FALSE(fd_log_writer.isOpen());
+        EXPECT_EQ(fd_log_writer.sync(), EBADF);
+        EXPECT_EQ(fd_log_writer.close(), 0);
+    }
+}  // namespace fd_log_writer_test
@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "FileLogsProducer.h"
 #include "TimestampProducerMock.h"
@@ -12,29 +22,100 @@ namespace file_logs_producer_test {
 
     namespace {
         const std::string kTestLogFileName = "test_log.log";
+        const std::string kMissingDirectoryLogFileName = "missing_directory/test_log.log";
+        /* Every write to it fails with ENOSPC */
+        const std::string kFullDeviceFileName = "/dev/full";
         const std::size_t kTestMaxLogFileSizeBytes = 1024U;
         const std::size_t kTestMaxLogFiles = 5U;
+        const std::int64_t kTestTimestampNs = 1717243200000000000;
+        const LogRecordMetadata kTestMetadata{level::LOG_LEVEL::info, kTestTimestampNs, 0U, 0U};
+        /* kTestTimestampNs is 2024-06-01T12:00:00Z */
+        const std::int64_t kTestNextHourNs = kTestTimestampNs + 3600000000000;
+        const std::int64_t kTestNextMidnightNs = kTestTimestampNs + 12 * 3600000000000;
+
+        /* Sets the local time zone for one test */
+        class ScopedTimeZone {
+           public:
+            explicit ScopedTimeZone(const char* timeZone) {
+                if (const char* previousTimeZone = std::getenv("TZ")) {
+                    mPreviousTimeZone_ = previousTimeZone;
+                }
+                setenv("TZ", timeZone, 1);
+                tzset();
+            }
+
+            ~ScopedTimeZone() {
+                if (mPreviousTimeZone_) {
+                    setenv("TZ", mPreviousTimeZone_->c_str(), 1);
+                } else {
+                    unsetenv("TZ");
+                }
+                tzset();
+            }
+
+           private:
+            std::optional<std::string> mPreviousTimeZone_;
+        };
+
+        void writeFile(const std::string& fileName, const std::string& content) {
+            std::ofstream file(fileName, std::ofstream::out | std::ofstream::trunc);
+            file << content;
+        }
+
+        /* The log file, its segments and their archives */
+        void removeTestLogFiles() {
+            std::vector<std::filesystem::path> testLogFiles;
+            for (const auto& entry : std::filesystem::directory_iterator(".")) {
+                if (entry.path().filename().string().rfind("test_log", 0U) == 0U) {
+                    testLogFiles.push_back(entry.path());
+                }
+            }
+            for (const auto& testLogFile : testLogFiles) {
+                std::filesystem::remove(testLogFile);
+            }
+        }
     }
 
     class FileLogsProducerTestable : public FileLogsProducer {
        public:
        FileLogsProducerTestable(std::shared_ptr<ITimestampProducer> timestampProducer) : FileLogsProducer(timestampProducer) {}
 
+       std::int64_t getWallClockNs() const override {
+           return wallClockNs;
+       }
+
        using FileLogsProducer::openLogFileAppend;
        using FileLogsProducer::openLogFileTruncate;
        using FileLogsProducer::rotateIfNeeded;
-       using FileLogsProducer::buildRotatedFileName;
+       using FileLogsProducer::buildSegmentFileName;
        using FileLogsProducer::isRotationEnabled;
-       using FileLogsProducer::GetLogFileStream;
+       using FileLogsProducer::GetFdLogWriter;
        using FileLogsProducer::GetLogFileName;
        using FileLogsProducer::GetMaxLogFileSizeBytes;
        using FileLogsProducer::GetMaxLogFiles;
-       using FileLogsProducer::GetNextRotationIndex;
+       using FileLogsProducer::GetSegmentSequence;
+       using FileLogsProducer::GetRotatedSegments;
+       using FileLogsProducer::GetLogFileSizeBytes;
+       using FileLogsProducer::GetLogSegmentArchiver;
+       using FileLogsProducer::GetMappedLogSegment;
+       using FileLogsProducer::GetUringLogWriter;
+       using FileLogsProducer::GetIoBackend;
+       using FileLogsProducer::GetSegmentPeriod;
+       using FileLogsProducer::GetNextRotationBoundaryNs;
+
+       std::int64_t wallClockNs = kTestTimestampNs;
     };
 
     class FileLogsProducerTest : public Test {
     public:
-        FileLogsProducerTest() : timestamp_producer_mock(std::make_shared<StrictMock<TimestampProducerMock>>()), file_logs_producer(timestamp_producer_mock) {}
+        FileLogsProducerTest() : timestamp_producer_mock(std::make_shared<StrictMock<TimestampProducerMock>>()), file_logs_producer(timestamp_producer_mock) {
+            removeTestLogFiles();
+        }
+
+        ~FileLogsProducerTest() override {
+            file_logs_producer.GetLogSegmentArchiver().waitIdle();
+            removeTestLogFiles();
+        }
         
         std::shared_ptr<StrictMock<TimestampProducerMock>> timestamp_producer_mock;
         FileLogsProducerTestable file_logs_producer;
@@ -59,73 +140,67 @@ namespace file_logs_producer_test {
     }
 
     
-    TEST_F(FileLogsProducerTest, Try_Setup_File_But_File_Is_Already_Opened_And_Close_Failed) {
-        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
-        file_logs_producer.GetLogFileStream().exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+    TEST_F(FileLogsProducerTest, Setup_File_Again_When_File_Is_Already_Opened_And_File_Reopened) {
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 0U, 0U), 0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
-        EXPECT_NO_THROW(file_logs_producer.setupFile(kTestLogFileName, 0U, 0U));
+        EXPECT_EQ(file_logs_producer.setupFile(kTestLogFileName, 0U, 0U), 0);
+        EXPECT_TRUE(file_logs_producer.GetFdLogWriter().isOpen());
     }
 
-    TEST_F(FileLogsProducerTest, Try_Setup_File_But_Open_Log_File_Failed) {
-        file_logs_producer.GetLogFileStream().exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+    TEST_F(FileLogsProducerTest, Try_Setup_File_But_Open_Log_File_Failed_And_Errno_Returned) {
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
-        EXPECT_NO_THROW(file_logs_producer.setupFile(kTestLogFileName, 0U, 0U));
+        EXPECT_EQ(file_logs_producer.setupFile(kMissingDirectoryLogFileName, 0U, 0U), ENOENT);
+        EXPECT_FALSE(file_logs_producer.GetFdLogWriter().isOpen());
     }
 
     TEST_F(FileLogsProducerTest, Setup_File_And_Log_File_Open_Successfully) {
-        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        EXPECT_EQ(file_logs_producer.setupFile(kTestLogFileName, 0U, 0U), 0);
 
-        EXPECT_TRUE(file_logs_producer.GetLogFileStream().is_open());
+        EXPECT_TRUE(file_logs_producer.GetFdLogWriter().isOpen());
     }
 
     TEST_F(FileLogsProducerTest, Try_Open_Log_File_Append_But_File_Is_Already_Opened) {
         file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
         EXPECT_NO_THROW(file_logs_producer.openLogFileAppend());
     }
 
     TEST_F(FileLogsProducerTest, Try_Open_Log_File_Append_But_Open_Failed) {
-        file_logs_producer.GetLogFileStream().exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        file_logs_producer.GetLogFileName() = kMissingDirectoryLogFileName;
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
-        EXPECT_NO_THROW(file_logs_producer.openLogFileAppend());
+        EXPECT_EQ(file_logs_producer.openLogFileAppend(), ENOENT);
     }
 
     TEST_F(FileLogsProducerTest, Open_Log_File_Append_Successfully) {
         file_logs_producer.GetLogFileName() = kTestLogFileName;
         file_logs_producer.openLogFileAppend();
 
-        EXPECT_TRUE(file_logs_producer.GetLogFileStream().is_open());
+        EXPECT_TRUE(file_logs_producer.GetFdLogWriter().isOpen());
     }
 
     TEST_F(FileLogsProducerTest, Try_Open_Log_File_Truncate_But_File_Is_Already_Opened) {
         file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
         EXPECT_NO_THROW(file_logs_producer.openLogFileTruncate());
     }
 
     TEST_F(FileLogsProducerTest, Try_Open_Log_File_Truncate_But_Open_Failed) {
-        file_logs_producer.GetLogFileStream().exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        file_logs_producer.GetLogFileName() = kMissingDirectoryLogFileName;
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
-        EXPECT_NO_THROW(file_logs_producer.openLogFileTruncate());
+        EXPECT_EQ(file_logs_producer.openLogFileTruncate(), ENOENT);
     }
 
     TEST_F(FileLogsProducerTest, Open_Log_File_Truncate_Successfully) {
         file_logs_producer.GetLogFileName() = kTestLogFileName;
         file_logs_producer.openLogFileTruncate();
 
-        EXPECT_TRUE(file_logs_producer.GetLogFileStream().is_open());
+        EXPECT_TRUE(file_logs_producer.GetFdLogWriter().isOpen());
     }
 
     TEST_F(FileLogsProducerTest, Rotation_Is_Enabled_And_True_Returned) {
@@ -147,23 +222,22 @@ namespace file_logs_producer_test {
         EXPECT_FALSE(file_logs_producer.isRotationEnabled());
     }
 
-    TEST_F(FileLogsProducerTest, Build_Rotated_File_Name_Correctly) {
+    TEST_F(FileLogsProducerTest, Build_Segment_File_Name_Correctly) {
         file_logs_producer.GetLogFileName() = kTestLogFileName;
         const std::string expectedFileName = "test_log_1.log";
-        EXPECT_EQ(file_logs_producer.buildRotatedFileName(1U), expectedFileName);
+        EXPECT_EQ(file_logs_producer.buildSegmentFileName(1U, ""), expectedFileName);
     }
 
-    TEST_F(FileLogsProducerTest, Build_Rotated_File_Name_Correctly_For_Higher_Index) {
+    TEST_F(FileLogsProducerTest, Build_Segment_File_Name_Correctly_For_Higher_Sequence) {
         file_logs_producer.GetLogFileName() = kTestLogFileName;
-        const std::string expectedFileName = "test_log_3.log";
-        EXPECT_EQ(file_logs_producer.buildRotatedFileName(3U), expectedFileName);
+        const std::string expectedFileName = "test_log_123.log";
+        EXPECT_EQ(file_logs_producer.buildSegmentFileName(123U, ""), expectedFileName);
     }
 
     TEST_F(FileLogsProducerTest, Try_Rotate_If_Needed_But_Rotation_Is_Not_Enabled) {
         file_logs_producer.GetMaxLogFileSizeBytes() = 0U;
         file_logs_producer.GetMaxLogFiles() = 0U;
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
         EXPECT_NO_THROW(file_logs_producer.rotateIfNeeded());
     }
@@ -173,18 +247,16 @@ namespace file_logs_producer_test {
         file_logs_producer.GetMaxLogFileSizeBytes() = 1024U; 
         file_logs_producer.GetMaxLogFiles() = kTestMaxLogFiles;
         file_logs_producer.openLogFileAppend();
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
         EXPECT_NO_THROW(file_logs_producer.rotateIfNeeded());
-        EXPECT_TRUE(file_logs_producer.GetLogFileStream().is_open());
+        EXPECT_TRUE(file_logs_producer.GetFdLogWriter().isOpen());
     }
 
     TEST_F(FileLogsProducerTest, Try_Rotate_If_Needed_But_File_Is_Not_Open) {
         file_logs_producer.GetMaxLogFileSizeBytes() = kTestMaxLogFileSizeBytes;
         file_logs_producer.GetMaxLogFiles() = kTestMaxLogFiles;
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
         EXPECT_NO_THROW(file_logs_producer.rotateIfNeeded());
     }
@@ -194,65 +266,419 @@ namespace file_logs_producer_test {
         file_logs_producer.GetMaxLogFileSizeBytes() = 1U;
         file_logs_producer.GetMaxLogFiles() = 0U;
         file_logs_producer.openLogFileAppend();
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
         EXPECT_NO_THROW(file_logs_producer.rotateIfNeeded());
-        EXPECT_TRUE(file_logs_producer.GetLogFileStream().is_open());
+        EXPECT_TRUE(file_logs_producer.GetFdLogWriter().isOpen());
     }
 
-    TEST_F(FileLogsProducerTest, Try_Rotate_If_Needed_But_Close_File_Failed) {
+    TEST_F(FileLogsProducerTest, Try_Rotate_If_Needed_But_Next_Segment_Open_Failed_And_Lines_Kept_In_Full_Segment) {
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 1U, kTestMaxLogFiles), 0);
+        /* A directory in the way of the next segment */
+        std::filesystem::create_directory(file_logs_producer.buildSegmentFileName(2U, ""));
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(2).WillRepeatedly(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("first", kTestMetadata);
+        file_logs_producer.flush();
+        file_logs_producer.logMessage("second", kTestMetadata);
+        file_logs_producer.flush();
+
+        EXPECT_TRUE(file_logs_producer.GetFdLogWriter().isOpen());
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 1U);
+        EXPECT_TRUE(file_logs_producer.GetRotatedSegments().empty());
+        EXPECT_EQ(std::filesystem::file_size(file_logs_producer.buildSegmentFileName(1U, "")),
+                  std::string("time123[INFO] first\ntime123[INFO] second\n").size());
+    }
+
+    TEST_F(FileLogsProducerTest, Try_Rotate_Mmap_Segment_But_Next_Segment_Open_Failed_And_Lines_Kept_In_Full_Segment) {
+        file_logs_producer.setIoBackend(file_io::BACKEND::mmap);
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 1U, kTestMaxLogFiles), 0);
+        std::filesystem::create_directory(file_logs_producer.buildSegmentFileName(2U, ""));
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(2).WillRepeatedly(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("first", kTestMetadata);
+        file_logs_producer.flush();
+        file_logs_producer.logMessage("second", kTestMetadata);
+        file_logs_producer.flush();
+
+        EXPECT_TRUE(file_logs_producer.GetMappedLogSegment().isOpen());
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 1U);
+        EXPECT_EQ(file_logs_producer.GetLogFileSizeBytes(), std::string("time123[INFO] first\ntime123[INFO] second\n").size());
+    }
+
+    TEST_F(FileLogsProducerTest, Try_Rotate_Io_Uring_Segment_But_Next_Segment_Open_Failed_And_Lines_Kept_In_Full_Segment) {
+        if (!file_logs_producer.GetUringLogWriter().isAvailable()) {
+            GTEST_SKIP() << "io_uring is not available";
+        }
+        file_logs_producer.setIoBackend(file_io::BACKEND::io_uring);
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 1U, kTestMaxLogFiles), 0);
+        std::filesystem::create_directory(file_logs_producer.buildSegmentFileName(2U, ""));
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(2).WillRepeatedly(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("first", kTestMetadata);
+        file_logs_producer.flush();
+        file_logs_producer.logMessage("second", kTestMetadata);
+        file_logs_producer.flush();
+        EXPECT_TRUE(file_logs_producer.GetUringLogWriter().isOpen());
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 1U);
+        file_logs_producer.GetUringLogWriter().close();
+
+        EXPECT_EQ(std::filesystem::file_size(file_logs_producer.buildSegmentFileName(1U, "")),
+                  std::string("time123[INFO] first\ntime123[INFO] second\n").size());
+    }
+
+    TEST_F(FileLogsProducerTest, Rotate_If_Needed_And_Rotation_Performed) {
         file_logs_producer.GetLogFileName() = kTestLogFileName;
         file_logs_producer.GetMaxLogFileSizeBytes() = 1U;
         file_logs_producer.GetMaxLogFiles() = kTestMaxLogFiles;
         file_logs_producer.openLogFileAppend();
-        file_logs_producer.GetLogFileStream().exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("time123"));
+        file_logs_producer.logMessage("x", kTestMetadata);
+        file_logs_producer.flush();
 
         EXPECT_NO_THROW(file_logs_producer.rotateIfNeeded());
+        EXPECT_TRUE(file_logs_producer.GetFdLogWriter().isOpen());
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 2U);
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), std::deque<std::string>{"test_log_1.log"});
     }
 
-    TEST_F(FileLogsProducerTest, Rotate_If_Needed_And_Rotation_Performed) {
+    TEST_F(FileLogsProducerTest, Setup_File_With_Rotation_And_Newest_Segment_Of_Earlier_Run_Continued) {
+        writeFile("test_log_1.log", "oldest\n");
+        writeFile("test_log_2.log.gz", "archived");
+        writeFile("test_log_3.log", "newest\n");
+        writeFile("test_log_04.log", "not a segment");
+        writeFile("test_log_x.log", "not a segment");
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
+
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, kTestMaxLogFileSizeBytes, kTestMaxLogFiles), 0);
+
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 3U);
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), (std::deque<std::string>{"test_log_1.log", "test_log_2.log"}));
+        EXPECT_EQ(file_logs_producer.GetLogFileSizeBytes(), std::string("newest\n").size());
+        ASSERT_TRUE(std::filesystem::is_symlink(kTestLogFileName));
+        EXPECT_EQ(std::filesystem::read_symlink(kTestLogFileName), "test_log_3.log");
+    }
+
+    TEST_F(FileLogsProducerTest, Setup_File_With_Rotation_And_Newest_Segment_Already_Archived_And_Next_Sequence_Opened) {
+        writeFile("test_log_7.log.gz", "archived");
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
+
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, kTestMaxLogFileSizeBytes, kTestMaxLogFiles), 0);
+
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 8U);
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), std::deque<std::string>{"test_log_7.log"});
+        EXPECT_TRUE(std::filesystem::exists("test_log_8.log"));
+    }
+
+    TEST_F(FileLogsProducerTest, Setup_File_With_Rotation_And_Oldest_Segments_Beyond_Max_Log_Files_Removed) {
+        for (std::size_t sequence = 1U; sequence <= 4U; ++sequence) {
+            writeFile("test_log_" + std::to_string(sequence) + ".log", "line\n");
+        }
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
+
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, kTestMaxLogFileSizeBytes, 2U), 0);
+        file_logs_producer.GetLogSegmentArchiver().waitIdle();
+
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 4U);
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), (std::deque<std::string>{"test_log_2.log", "test_log_3.log"}));
+        EXPECT_FALSE(std::filesystem::exists("test_log_1.log"));
+        EXPECT_TRUE(std::filesystem::exists("test_log_2.log"));
+    }
+
+    TEST_F(FileLogsProducerTest, Rotate_Several_Times_And_Sequence_Grows_And_Oldest_Segments_Removed) {
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 1U, 2U), 0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(4).WillRepeatedly(WriteTimestamp("time123"));
+
+        for (int i = 0; i < 4; ++i) {
+            file_logs_producer.logMessage("line " + std::to_string(i), kTestMetadata);
+            file_logs_producer.flush();
+        }
+        file_logs_producer.GetLogSegmentArchiver().waitIdle();
+
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 5U);
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), (std::deque<std::string>{"test_log_3.log", "test_log_4.log"}));
+        EXPECT_FALSE(std::filesystem::exists("test_log_1.log"));
+        EXPECT_FALSE(std::filesystem::exists("test_log_2.log"));
+        EXPECT_EQ(std::filesystem::file_size("test_log_4.log"), std::string("time123[INFO] line 3\n").size());
+        EXPECT_EQ(std::filesystem::file_size("test_log_5.log"), 0U);
+        EXPECT_EQ(std::filesystem::read_symlink(kTestLogFileName), "test_log_5.log");
+    }
+
+    TEST_F(FileLogsProducerTest, Setup_File_With_Rotation_Over_Log_File_Of_Rename_Rotation_And_It_Is_Continued_As_Newest_Segment) {
+        writeFile(kTestLogFileName, "written before the upgrade\n");
+        writeFile("test_log_1.log", "rotated by renaming\n");
+        writeFile("test_log_2.log", "rotated by renaming\n");
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("time123"));
+
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, kTestMaxLogFileSizeBytes, kTestMaxLogFiles), 0);
+        file_logs_producer.logMessage("after", kTestMetadata);
+        file_logs_producer.flush();
+
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 3U);
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), (std::deque<std::string>{"test_log_1.log", "test_log_2.log"}));
+        ASSERT_TRUE(std::filesystem::is_symlink(kTestLogFileName));
+        EXPECT_EQ(std::filesystem::read_symlink(kTestLogFileName), "test_log_3.log");
+        std::ifstream logFile(kTestLogFileName);
+        std::string line;
+        std::getline(logFile, line);
+        EXPECT_EQ(line, "written before the upgrade");
+        std::getline(logFile, line);
+        EXPECT_EQ(line, "time123[INFO] after");
+    }
+
+    TEST_F(FileLogsProducerTest, Setup_File_With_Hourly_Rotation_Over_Log_File_Of_Rename_Rotation_And_It_Is_Kept_As_Rotated_Segment) {
+        file_logs_producer.setRotationPeriod(file_rotation::PERIOD::hourly, timestamp_format::ZONE::utc);
+        writeFile(kTestLogFileName, "written before the upgrade\n");
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
+
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 0U, kTestMaxLogFiles), 0);
+
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 2U);
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), std::deque<std::string>{"test_log_1.log"});
+        EXPECT_EQ(std::filesystem::file_size("test_log_1.log"), std::string("written before the upgrade\n").size());
+        EXPECT_EQ(std::filesystem::read_symlink(kTestLogFileName), "test_log_2024-06-01T12_2.log");
+    }
+
+    TEST_F(FileLogsProducerTest, Setup_File_With_Hourly_Rotation_And_Segment_Named_After_Hour_And_Next_Boundary_Computed) {
+        file_logs_producer.setRotationPeriod(file_rotation::PERIOD::hourly, timestamp_format::ZONE::utc);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
+
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 0U, kTestMaxLogFiles), 0);
+
+        EXPECT_TRUE(file_logs_producer.isRotationEnabled());
+        EXPECT_EQ(file_logs_producer.GetSegmentPeriod(), "2024-06-01T12");
+        EXPECT_EQ(file_logs_producer.GetNextRotationBoundaryNs(), kTestNextHourNs);
+        EXPECT_EQ(std::filesystem::read_symlink(kTestLogFileName), "test_log_2024-06-01T12_1.log");
+    }
+
+    TEST_F(FileLogsProducerTest, Setup_File_With_Daily_Rotation_And_Next_Boundary_At_Midnight) {
+        file_logs_producer.wallClockNs = kTestTimestampNs + 1;
+        file_logs_producer.setRotationPeriod(file_rotation::PERIOD::daily, timestamp_format::ZONE::utc);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
+
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 0U, kTestMaxLogFiles), 0);
+
+        EXPECT_EQ(file_logs_producer.GetSegmentPeriod(), "2024-06-01");
+        EXPECT_EQ(file_logs_producer.GetNextRotationBoundaryNs(), kTestNextMidnightNs);
+        EXPECT_TRUE(std::filesystem::exists("test_log_2024-06-01_1.log"));
+    }
+
+    TEST_F(FileLogsProducerTest, Setup_File_With_Hourly_Local_Rotation_After_Half_Hour_Dst_Change_And_Next_Boundary_At_Next_Local_Hour) {
+        /* 2024-10-05T15:40:00Z is 02:40 on Lord Howe Island, where the clocks went from 02:00 to 02:30 */
+        const ScopedTimeZone timeZone("Australia/Lord_Howe");
+        file_logs_producer.wallClockNs = 1728142800000000000;
+        file_logs_producer.setRotationPeriod(file_rotation::PERIOD::hourly, timestamp_format::ZONE::local);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
+
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 0U, kTestMaxLogFiles), 0);
+
+        EXPECT_EQ(file_logs_producer.GetSegmentPeriod(), "2024-10-06T02");
+        EXPECT_EQ(file_logs_producer.GetNextRotationBoundaryNs(), 1728144000000000000);
+    }
+
+    TEST_F(FileLogsProducerTest, Hourly_Rotation_And_Line_Past_Boundary_Starts_Segment_Of_Its_Hour) {
+        file_logs_producer.setRotationPeriod(file_rotation::PERIOD::hourly, timestamp_format::ZONE::utc);
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 0U, kTestMaxLogFiles), 0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(3).WillRepeatedly(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("noon", kTestMetadata);
+        file_logs_producer.logMessage("before one", LogRecordMetadata{level::LOG_LEVEL::info, kTestNextHourNs - 1, 0U, 0U});
+        file_logs_producer.logMessage("one", LogRecordMetadata{level::LOG_LEVEL::info, kTestNextHourNs, 0U, 0U});
+        file_logs_producer.flush();
+
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 2U);
+        EXPECT_EQ(file_logs_producer.GetSegmentPeriod(), "2024-06-01T13");
+        EXPECT_EQ(file_logs_producer.GetNextRotationBoundaryNs(), kTestNextHourNs + 3600000000000);
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), std::deque<std::string>{"test_log_2024-06-01T12_1.log"});
+        EXPECT_EQ(std::filesystem::file_size("test_log_2024-06-01T12_1.log"),
+                  std::string("time123[INFO] noon\ntime123[INFO] before one\n").size());
+        EXPECT_EQ(std::filesystem::file_size("test_log_2024-06-01T13_2.log"), std::string("time123[INFO] one\n").size());
+        EXPECT_EQ(std::filesystem::read_symlink(kTestLogFileName), "test_log_2024-06-01T13_2.log");
+    }
+
+    TEST_F(FileLogsProducerTest, Hourly_Rotation_With_Size_Limit_And_Segment_Full_Within_Hour_Keeps_Hour_In_Name) {
+        file_logs_producer.setRotationPeriod(file_rotation::PERIOD::hourly, timestamp_format::ZONE::utc);
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 1U, kTestMaxLogFiles), 0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("noon", kTestMetadata);
+        file_logs_producer.flush();
+
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), std::deque<std::string>{"test_log_2024-06-01T12_1.log"});
+        EXPECT_TRUE(std::filesystem::exists("test_log_2024-06-01T12_2.log"));
+    }
+
+    TEST_F(FileLogsProducerTest, Hourly_Rotation_With_Size_Limit_And_Segment_Full_At_Boundary_Rotated_Once_Into_Next_Hour) {
+        const std::string noonLine = "time123[INFO] noon\n";
+        file_logs_producer.setRotationPeriod(file_rotation::PERIOD::hourly, timestamp_format::ZONE::utc);
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, noonLine.size() + 1U, kTestMaxLogFiles), 0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(3).WillRepeatedly(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("noon", kTestMetadata);
+        file_logs_producer.logMessage("noon", kTestMetadata);
+        file_logs_producer.logMessage("one", LogRecordMetadata{level::LOG_LEVEL::info, kTestNextHourNs, 0U, 0U});
+        file_logs_producer.flush();
+
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 2U);
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), std::deque<std::string>{"test_log_2024-06-01T12_1.log"});
+        EXPECT_EQ(std::filesystem::file_size("test_log_2024-06-01T12_1.log"), 2U * noonLine.size());
+        EXPECT_FALSE(std::filesystem::exists("test_log_2024-06-01T12_2.log"));
+        EXPECT_EQ(std::filesystem::read_symlink(kTestLogFileName), "test_log_2024-06-01T13_2.log");
+    }
+
+    TEST_F(FileLogsProducerTest, Setup_File_With_Hourly_Rotation_And_Newest_Segment_Of_Earlier_Hour_Not_Continued) {
+        writeFile("test_log_2024-06-01T11_3.log", "earlier hour\n");
+        writeFile("test_log_2024-06-01Tx_4.log", "not a segment");
+        file_logs_producer.setRotationPeriod(file_rotation::PERIOD::hourly, timestamp_format::ZONE::utc);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
+
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 0U, kTestMaxLogFiles), 0);
+
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 4U);
+        EXPECT_EQ(file_logs_producer.GetRotatedSegments(), std::deque<std::string>{"test_log_2024-06-01T11_3.log"});
+        EXPECT_TRUE(std::filesystem::exists("test_log_2024-06-01T12_4.log"));
+    }
+
+    TEST_F(FileLogsProducerTest, Open_Log_File_Append_And_Tracked_Size_Seeded_From_Existing_File) {
+        {
+            std::ofstream existingFile(kTestLogFileName, std::ofstream::out | std::ofstream::trunc);
+            existingFile << "existing line\n";
+        }
         file_logs_producer.GetLogFileName() = kTestLogFileName;
-        file_logs_producer.GetMaxLogFileSizeBytes() = 1U;
-        file_logs_producer.GetMaxLogFiles() = kTestMaxLogFiles;
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
+
         file_logs_producer.openLogFileAppend();
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(1).WillOnce(Return("time"));
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(1).WillOnce(Return("123"));
-        file_logs_producer.logMessage("x");
 
-        EXPECT_NO_THROW(file_logs_producer.rotateIfNeeded());
-        EXPECT_TRUE(file_logs_producer.GetLogFileStream().is_open());
-        EXPECT_EQ(file_logs_producer.GetNextRotationIndex(), 2U);
+        EXPECT_EQ(file_logs_producer.GetLogFileSizeBytes(), std::string("existing line\n").size());
+    }
+
+    TEST_F(FileLogsProducerTest, Log_Messages_And_Tracked_Size_Follows_Written_Bytes_And_Resets_On_Rotation) {
+        std::filesystem::remove(kTestLogFileName);
+        file_logs_producer.setupFile(kTestLogFileName, kTestMaxLogFileSizeBytes, kTestMaxLogFiles);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(2).WillRepeatedly(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("first", kTestMetadata);
+        file_logs_producer.flush();
+        EXPECT_EQ(file_logs_producer.GetLogFileSizeBytes(), std::filesystem::file_size(file_logs_producer.buildSegmentFileName(1U, "")));
+
+        file_logs_producer.logMessage(std::string(kTestMaxLogFileSizeBytes, 'x'), kTestMetadata);
+        file_logs_producer.flush();
+        EXPECT_EQ(file_logs_producer.GetLogFileSizeBytes(), 0U);
+        EXPECT_EQ(file_logs_producer.GetSegmentSequence(), 2U);
+    }
+
+    TEST_F(FileLogsProducerTest, Mmap_Io_Backend_And_File_Preallocated_And_Lines_Copied_Into_Mapping) {
+        std::filesystem::remove(kTestLogFileName);
+        file_logs_producer.setIoBackend(file_io::BACKEND::mmap);
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("mapped", kTestMetadata);
+        file_logs_producer.flush();
+
+        EXPECT_TRUE(file_logs_producer.GetMappedLogSegment().isOpen());
+        EXPECT_FALSE(file_logs_producer.GetFdLogWriter().isOpen());
+        EXPECT_EQ(file_logs_producer.GetLogFileSizeBytes(), std::string("time123[INFO] mapped\n").size());
+        EXPECT_GT(std::filesystem::file_size(kTestLogFileName), file_logs_producer.GetLogFileSizeBytes());
+    }
+
+    TEST_F(FileLogsProducerTest, Mmap_Io_Backend_And_Rotated_File_Cut_To_Its_Lines) {
+        std::filesystem::remove(kTestLogFileName);
+        file_logs_producer.setIoBackend(file_io::BACKEND::mmap);
+        file_logs_producer.setupFile(kTestLogFileName, 1U, kTestMaxLogFiles);
+        const std::string rotatedFileName = file_logs_producer.buildSegmentFileName(1U, "");
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("mapped", kTestMetadata);
+        file_logs_producer.flush();
+
+        EXPECT_EQ(std::filesystem::file_size(rotatedFileName), std::string("time123[INFO] mapped\n").size());
+        EXPECT_TRUE(file_logs_producer.GetMappedLogSegment().isOpen());
+        EXPECT_EQ(file_logs_producer.GetLogFileSizeBytes(), 0U);
+        file_logs_producer.GetLogSegmentArchiver().waitIdle();
+        std::filesystem::remove(rotatedFileName);
+    }
+
+    TEST_F(FileLogsProducerTest, Io_Uring_Io_Backend_And_Lines_Written_Or_Stream_Used_When_Not_Available) {
+        std::filesystem::remove(kTestLogFileName);
+        const bool uringAvailable = file_logs_producer.GetUringLogWriter().isAvailable();
+        file_logs_producer.setIoBackend(file_io::BACKEND::io_uring);
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("uring", kTestMetadata);
+        file_logs_producer.flush();
+        EXPECT_EQ(file_logs_producer.GetUringLogWriter().isOpen(), uringAvailable);
+        EXPECT_EQ(file_logs_producer.GetIoBackend(), uringAvailable ? file_io::BACKEND::io_uring : file_io::BACKEND::write);
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+
+        std::ifstream logFile(kTestLogFileName);
+        std::string line;
+        std::getline(logFile, line);
+        EXPECT_EQ(line, "time123[INFO] uring");
+    }
+
+    TEST_F(FileLogsProducerTest, Drop_Behind_Page_Cache_Mode_And_Lines_Past_Several_Windows_Written_Completely) {
+        std::filesystem::remove(kTestLogFileName);
+        file_logs_producer.setPageCacheMode(file_page_cache::MODE::drop_behind);
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        const std::string message(PageCacheDropBehind::kDefaultWindowBytes / 2U, 'x');
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(5).WillRepeatedly(WriteTimestamp("time123"));
+
+        for (int i = 0; i < 5; ++i) {
+            file_logs_producer.logMessage(message, kTestMetadata);
+            file_logs_producer.flush();
+        }
+
+        EXPECT_EQ(std::filesystem::file_size(kTestLogFileName), 5U * std::string("time123[INFO] \n").size() + 5U * message.size());
     }
+
+#ifdef EQUINOX_HAS_ZLIB
+    TEST_F(FileLogsProducerTest, Gzip_Compression_And_Rotated_File_Compressed_In_Background) {
+        std::filesystem::remove(kTestLogFileName);
+        file_logs_producer.setCompression(file_compression::MODE::gzip);
+        file_logs_producer.setupFile(kTestLogFileName, 1U, kTestMaxLogFiles);
+        const std::string rotatedFileName = file_logs_producer.buildSegmentFileName(1U, "");
+        std::filesystem::remove(rotatedFileName + ".gz");
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("time123"));
+
+        file_logs_producer.logMessage("rotated", kTestMetadata);
+        file_logs_producer.flush();
+        file_logs_producer.GetLogSegmentArchiver().waitIdle();
+
+        EXPECT_FALSE(std::filesystem::exists(rotatedFileName));
+        EXPECT_TRUE(std::filesystem::exists(rotatedFileName + ".gz"));
+        EXPECT_EQ(std::filesystem::file_size(file_logs_producer.buildSegmentFileName(2U, "")), 0U);
+        std::filesystem::remove(rotatedFileName + ".gz");
+    }
+#endif
         
     TEST_F(FileLogsProducerTest, Try_Log_Message_But_File_Is_Not_Open) {
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
-        EXPECT_NO_THROW(file_logs_producer.logMessage("Test message"));
+        EXPECT_NO_THROW(file_logs_producer.logMessage("Test message", kTestMetadata));
     }
 
      TEST_F(FileLogsProducerTest, Try_Log_Message_But_Write_Failed) {
-        file_logs_producer.GetLogFileName() = kTestLogFileName;
-        file_logs_producer.openLogFileAppend();
-        file_logs_producer.GetLogFileStream().exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(1);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(1);
+        file_logs_producer.GetLogFileName() = kFullDeviceFileName;
+        ASSERT_EQ(file_logs_producer.openLogFileAppend(), 0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(Return(0U));
 
-        EXPECT_NO_THROW(file_logs_producer.logMessage("Test message"));
+        EXPECT_NO_THROW(file_logs_producer.logMessage("Test message", kTestMetadata));
+        EXPECT_NO_THROW(file_logs_producer.flush());
+        EXPECT_EQ(file_logs_producer.getWriteStats().writeCount, 0U);
+        EXPECT_EQ(file_logs_producer.GetLogFileSizeBytes(), 0U);
     }
 
     TEST_F(FileLogsProducerTest, Log_Message_Successfully) {
         const std::string testMessage = "Test message";
-        const std::string expectedLoggedMessage = "2024-06-01 12:00:00.000000" + testMessage;
+        const std::string expectedLoggedMessage = "[2024-06-01T12:00:00.000000Z][INFO] " + testMessage;
         file_logs_producer.GetLogFileName() = kTestLogFileName;
         file_logs_producer.openLogFileTruncate();
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(1).WillOnce(Return("2024-06-01 12:00:00."));
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(1).WillOnce(Return("000000"));
-        EXPECT_NO_THROW(file_logs_producer.logMessage(testMessage));
-        file_logs_producer.GetLogFileStream().close();
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("[2024-06-01T12:00:00.000000Z]"));
+        EXPECT_NO_THROW(file_logs_producer.logMessage(testMessage, kTestMetadata));
+        file_logs_producer.flush();
+        file_logs_producer.GetFdLogWriter().close();
         std::ifstream readFile(file_logs_producer.GetLogFileName());
         std::string loggedMessage;
         std::getline(readFile, loggedMessage);
@@ -261,28 +687,162 @@ namespace file_logs_producer_test {
         EXPECT_EQ(loggedMessage, expectedLoggedMessage);
     }
 
+    TEST_F(FileLogsProducerTest, Set_Log_Prefix_And_Logged_Message_Starts_With_Prefix_And_Level_Without_Colors) {
+        const LogRecordMetadata errorMetadata{level::LOG_LEVEL::error, kTestTimestampNs, 0U, 0U};
+        file_logs_producer.GetLogFileName() = kTestLogFileName;
+        file_logs_producer.openLogFileTruncate();
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("[2024-06-01T12:00:00.000000Z]"));
+
+        file_logs_producer.setLogPrefix("[TestPrefix]");
+        file_logs_producer.logMessage("Test message", errorMetadata);
+        file_logs_producer.flush();
+        file_logs_producer.GetFdLogWriter().close();
+        std::ifstream readFile(file_logs_producer.GetLogFileName());
+        std::string loggedMessage;
+        std::getline(readFile, loggedMessage);
+
+        EXPECT_EQ(loggedMessage, "[2024-06-01T12:00:00.000000Z][TestPrefix][ERROR] Test message");
+    }
+
+    TEST_F(FileLogsProducerTest, Log_Messages_And_They_Are_Written_With_One_Write_On_Flush) {
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        file_logs_producer.GetFdLogWriter().close();
+        file_logs_producer.openLogFileTruncate();
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(3).WillRepeatedly(WriteTimestamp("[ts]"));
+
+        for (int i = 0; i < 3; ++i) {
+            file_logs_producer.logMessage("Message " + std::to_string(i), kTestMetadata);
+        }
+        EXPECT_EQ(std::filesystem::file_size(kTestLogFileName), 0U);
+        file_logs_producer.flush();
+
+        EXPECT_EQ(file_logs_producer.getWriteStats().writeCount, 1U);
+        EXPECT_EQ(std::filesystem::file_size(kTestLogFileName), 3U * std::string("[ts][INFO] Message 0\n").size());
+        EXPECT_EQ(file_logs_producer.getWriteStats().syncCount, 0U);
+    }
+
+    TEST_F(FileLogsProducerTest, Batch_Sync_Durability_And_Every_Flushed_Batch_Is_Synced) {
+        file_logs_producer.setDurability(file_durability::MODE::batch_sync, 0U, 0U);
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(2).WillRepeatedly(WriteTimestamp("[ts]"));
+
+        file_logs_producer.logMessage("First", kTestMetadata);
+        file_logs_producer.flush();
+        file_logs_producer.flush();
+        file_logs_producer.logMessage("Second", kTestMetadata);
+        file_logs_producer.flush();
+
+        const FileWriteStats stats = file_logs_producer.getWriteStats();
+        EXPECT_EQ(stats.writeCount, 2U);
+        EXPECT_EQ(stats.syncCount, 2U);
+        EXPECT_GE(stats.syncTotalNs, stats.syncMaxNs);
+    }
+
+    TEST_F(FileLogsProducerTest, Batch_Sync_Durability_And_Lines_Written_Without_Flush_Are_Synced) {
+        file_logs_producer.setDurability(file_durability::MODE::batch_sync, 0U, 0U);
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("[ts]"));
+
+        file_logs_producer.logMessage(std::string(256U * 1024U, 'x'), kTestMetadata);
+
+        const FileWriteStats stats = file_logs_producer.getWriteStats();
+        EXPECT_EQ(stats.writeCount, 1U);
+        EXPECT_EQ(stats.syncCount, 1U);
+    }
+
+    TEST_F(FileLogsProducerTest, Periodic_Sync_Durability_And_Batch_Is_Synced_Once_Sync_Bytes_Were_Written) {
+        file_logs_producer.setDurability(file_durability::MODE::periodic_sync, 3600000U, 40U);
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(2).WillRepeatedly(WriteTimestamp("[ts]"));
+
+        file_logs_producer.logMessage("Short", kTestMetadata);
+        file_logs_producer.flush();
+        EXPECT_EQ(file_logs_producer.getWriteStats().syncCount, 0U);
+        file_logs_producer.logMessage("Message long enough to reach the sync threshold", kTestMetadata);
+        file_logs_producer.flush();
+
+        EXPECT_EQ(file_logs_producer.getWriteStats().syncCount, 1U);
+    }
+
+    TEST_F(FileLogsProducerTest, Periodic_Sync_Durability_And_Lines_Are_Synced_Once_Interval_Passed_After_Flush) {
+        file_logs_producer.setDurability(file_durability::MODE::periodic_sync, 200U, 1024U * 1024U);
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("[ts]"));
+        EXPECT_FALSE(file_logs_producer.getSyncDelayMs().has_value());
+
+        file_logs_producer.logMessage("Message", kTestMetadata);
+        file_logs_producer.flush();
+        ASSERT_EQ(file_logs_producer.getWriteStats().syncCount, 0U);
+        ASSERT_TRUE(file_logs_producer.getSyncDelayMs().has_value());
+        EXPECT_LE(*file_logs_producer.getSyncDelayMs(), 200U);
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        EXPECT_EQ(file_logs_producer.getSyncDelayMs(), std::optional<std::uint32_t>(0U));
+        file_logs_producer.flush();
+
+        EXPECT_EQ(file_logs_producer.getWriteStats().syncCount, 1U);
+        EXPECT_FALSE(file_logs_producer.getSyncDelayMs().has_value());
+    }
+
+    TEST_F(FileLogsProducerTest, Sync_On_Error_Durability_And_Error_Line_Is_Written_And_Synced_At_Once) {
+        const LogRecordMetadata errorMetadata{level::LOG_LEVEL::error, kTestTimestampNs, 0U, 0U};
+        file_logs_producer.setDurability(file_durability::MODE::sync_on_error, 0U, 0U);
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(2).WillRepeatedly(WriteTimestamp("[ts]"));
+
+        file_logs_producer.logMessage("Info", kTestMetadata);
+        EXPECT_EQ(file_logs_producer.getWriteStats().writeCount, 0U);
+        file_logs_producer.logMessage("Error", errorMetadata);
+
+        const FileWriteStats stats = file_logs_producer.getWriteStats();
+        EXPECT_EQ(stats.writeCount, 1U);
+        EXPECT_EQ(stats.syncCount, 1U);
+    }
+
+    TEST_F(FileLogsProducerTest, Sync_On_Error_Durability_With_Io_Uring_And_Sync_Completed_Before_Log_Message_Returns) {
+        if (!file_logs_producer.GetUringLogWriter().isAvailable()) {
+            GTEST_SKIP() << "io_uring is not available";
+        }
+        const LogRecordMetadata errorMetadata{level::LOG_LEVEL::error, kTestTimestampNs, 0U, 0U};
+        file_logs_producer.setIoBackend(file_io::BACKEND::io_uring);
+        file_logs_producer.setDurability(file_durability::MODE::sync_on_error, 0U, 0U);
+        file_logs_producer.setupFile(kTestLogFileName, 0U, 0U);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(1).WillOnce(WriteTimestamp("[ts]"));
+
+        file_logs_producer.logMessage("Error", errorMetadata);
+
+        const FileWriteStats stats = file_logs_producer.getWriteStats();
+        EXPECT_EQ(stats.writeCount, 1U);
+        EXPECT_EQ(stats.syncCount, 1U);
+        EXPECT_EQ(stats.failedSyncCount, 0U);
+    }
+
     TEST_F(FileLogsProducerTest, Try_Flush_But_File_Is_Not_Open) {
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
         EXPECT_NO_THROW(file_logs_producer.flush());
     }
 
-    TEST_F(FileLogsProducerTest, Try_Flush_But_Flush_Failed) {
-        file_logs_producer.GetLogFileName() = kTestLogFileName;
-        file_logs_producer.openLogFileAppend();
-        file_logs_producer.GetLogFileStream().exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+    TEST_F(FileLogsProducerTest, Try_Flush_But_Write_Failed_And_Next_Batch_Written_After_Reopen) {
+        file_logs_producer.GetLogFileName() = kFullDeviceFileName;
+        ASSERT_EQ(file_logs_producer.openLogFileAppend(), 0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(kTestTimestampNs, _)).Times(2).WillRepeatedly(WriteTimestamp("[ts]"));
 
+        file_logs_producer.logMessage("Lost", kTestMetadata);
         EXPECT_NO_THROW(file_logs_producer.flush());
+        EXPECT_EQ(file_logs_producer.getWriteStats().failedWriteCount, 1U);
+        ASSERT_EQ(file_logs_producer.setupFile(kTestLogFileName, 0U, 0U), 0);
+        file_logs_producer.GetFdLogWriter().close();
+        file_logs_producer.openLogFileTruncate();
+        file_logs_producer.logMessage("Kept", kTestMetadata);
+        file_logs_producer.flush();
+
+        EXPECT_EQ(std::filesystem::file_size(kTestLogFileName), std::string("[ts][INFO] Kept\n").size());
     }
 
     TEST_F(FileLogsProducerTest, Flush_Successfully) {
         file_logs_producer.GetLogFileName() = kTestLogFileName;
         file_logs_producer.openLogFileAppend();
-        EXPECT_CALL(*timestamp_producer_mock, getTimestamp()).Times(0);
-        EXPECT_CALL(*timestamp_producer_mock, getTimestampInUs()).Times(0);
+        EXPECT_CALL(*timestamp_producer_mock, formatTimestamp(_, _)).Times(0);
 
         EXPECT_NO_THROW(file_logs_producer.flush());
     }
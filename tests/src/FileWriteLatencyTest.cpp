@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include "FileWriteLatency.h"
+
+namespace file_write_latency_test {
+
+    class FileWriteLatencyTest : public ::testing::Test {
+       public:
+        equinox::FileWriteLatency fileWriteLatency;
+    };
+
+    TEST_F(FileWriteLatencyTest, Nothing_Recorded_And_All_Stats_Are_Zero) {
+        const equinox::FileWriteStats stats = fileWriteLatency.getStats();
+
+        EXPECT_EQ(stats.writeCount, 0U);
+        EXPECT_EQ(stats.writeMaxNs, 0U);
+        EXPECT_EQ(stats.syncCount, 0U);
+        EXPECT_EQ(stats.syncMaxNs, 0U);
+    }
+
+    TEST_F(FileWriteLatencyTest, Writes_And_Syncs_Are_Counted_Separately_With_Total_And_Max) {
+        fileWriteLatency.recordWrite(300U);
+        fileWriteLatency.recordWrite(100U);
+        fileWriteLatency.recordSync(5000U);
+
+        const equinox::FileWriteStats stats = fileWriteLatency.getStats();
+
+        EXPECT_EQ(stats.writeCount, 2U);
+        EXPECT_EQ(stats.writeTotalNs, 400U);
+        EXPECT_EQ(stats.writeMaxNs, 300U);
+        EXPECT_EQ(stats.syncCount, 1U);
+        EXPECT_EQ(stats.syncTotalNs, 5000U);
+        EXPECT_EQ(stats.syncMaxNs, 5000U);
+        EXPECT_EQ(stats.failedWriteCount, 0U);
+    }
+
+    TEST_F(FileWriteLatencyTest, Failed_Writes_And_Syncs_Counted_Apart_From_Latencies) {
+        fileWriteLatency.recordFailedWrite();
+        fileWriteLatency.recordFailedWrite();
+        fileWriteLatency.recordFailedSync();
+
+        const equinox::FileWriteStats stats = fileWriteLatency.getStats();
+
+        EXPECT_EQ(stats.failedWriteCount, 2U);
+        EXPECT_EQ(stats.failedSyncCount, 1U);
+        EXPECT_EQ(stats.writeCount, 0U);
+    }
+
+}  // namespace file_write_latency_test
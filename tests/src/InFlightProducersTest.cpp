@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "InFlightProducers.h"
+
+namespace in_flight_producers_test {
+
+    class InFlightProducersForTests : public equinox::InFlightProducers {
+       public:
+        std::uint32_t getProducersCountForTests() const { return getProducersCount(); }
+    };
+
+    class InFlightProducersTest : public ::testing::Test {
+       public:
+        InFlightProducersForTests inFlightProducers;
+    };
+
+    TEST_F(InFlightProducersTest, Wait_Without_Producers_Returns_Immediately) {
+        inFlightProducers.waitForProducers();
+
+        EXPECT_EQ(inFlightProducers.getProducersCountForTests(), 0U);
+    }
+
+    TEST_F(InFlightProducersTest, Entered_Producer_Is_Counted_Until_It_Leaves) {
+        const std::uint32_t token = inFlightProducers.enter();
+        EXPECT_EQ(inFlightProducers.getProducersCountForTests(), 1U);
+
+        inFlightProducers.leave(token);
+        EXPECT_EQ(inFlightProducers.getProducersCountForTests(), 0U);
+    }
+
+    TEST_F(InFlightProducersTest, Wait_Returns_Only_After_Producer_Entered_Before_It_Left) {
+        const std::uint32_t token = inFlightProducers.enter();
+        std::atomic<bool> waited{false};
+        std::thread waiter([this, &waited]() {
+            inFlightProducers.waitForProducers();
+            waited = true;
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_FALSE(waited.load());
+        inFlightProducers.leave(token);
+        waiter.join();
+
+        EXPECT_TRUE(waited.load());
+    }
+
+    TEST_F(InFlightProducersTest, Producer_Entering_After_Wait_Started_Does_Not_Keep_It_Waiting) {
+        const std::uint32_t earlierToken = inFlightProducers.enter();
+        std::atomic<bool> waited{false};
+        std::thread waiter([this, &waited]() {
+            inFlightProducers.waitForProducers();
+            waited = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        const std::uint32_t laterToken = inFlightProducers.enter();
+        inFlightProducers.leave(earlierToken);
+        waiter.join();
+
+        EXPECT_TRUE(waited.load());
+        EXPECT_EQ(inFlightProducers.getProducersCountForTests(), 1U);
+        inFlightProducers.leave(laterToken);
+    }
+
+    TEST_F(InFlightProducersTest, Producers_From_Many_Threads_Leave_Nothing_Counted) {
+        std::vector<std::thread> producers;
+        for (int thread = 0; thread < 8; ++thread) {
+            producers.emplace_back([this]() {
+                for (int i = 0; i < 10000; ++i) {
+                    inFlightProducers.leave(inFlightProducers.enter());
+                }
+            });
+        }
+        for (int wait = 0; wait < 100; ++wait) {
+            inFlightProducers.waitForProducers();
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        EXPECT_EQ(inFlightProducers.getProducersCountForTests(), 0U);
+    }
+
+}  // namespace in_flight_producers_test
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include "LogClock.h"
+
+namespace log_clock_test {
+
+    namespace {
+        constexpr std::int64_t kStartMonotonicNs = 1000000000000;
+        constexpr std::int64_t kRealtimeOffsetNs = 1700000000000000000;
+        /* Every monotonic read of the simulated clocks moves the time forward */
+        constexpr std::int64_t kMonotonicReadStepNs = 100000;
+        constexpr std::uint64_t kTscTicksPerNs = 3U;
+        constexpr std::int64_t kSimulatedToleranceNs = 2 * kMonotonicReadStepNs;
+        /* CLOCK_REALTIME_COARSE lags behind by up to one kernel tick */
+        constexpr std::int64_t kRealClockToleranceNs = 20000000;
+
+        std::int64_t systemClockNowNs() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+    }  // namespace
+
+    class LogClockForTests : public equinox::LogClock {
+       public:
+        std::uint64_t tscTicksAt(std::int64_t monotonicNs) const { return static_cast<std::uint64_t>(monotonicNs) * kTscTicksPerNs; }
+
+        mutable std::int64_t monotonicNs = kStartMonotonicNs;
+        std::int64_t realtimeOffsetNs = kRealtimeOffsetNs;
+
+       protected:
+        std::uint64_t readTsc() const override { return tscTicksAt(monotonicNs); }
+        std::int64_t readMonotonicNs() const override {
+            const std::int64_t now = monotonicNs;
+            monotonicNs += kMonotonicReadStepNs;
+            return now;
+        }
+        std::int64_t readRealtimeNs() const override { return monotonicNs + realtimeOffsetNs; }
+    };
+
+    class LogClockTest : public ::testing::Test {
+       public:
+        LogClockForTests logClock;
+    };
+
+    TEST_F(LogClockTest, Tsc_Falls_Back_To_Monotonic_Only_Without_Invariant_Tsc) {
+        logClock.setSource(equinox::timestamp_clock::SOURCE::tsc);
+
+        EXPECT_EQ(logClock.getSource(),
+                  equinox::LogClock::isInvariantTscAvailable() ? equinox::timestamp_clock::SOURCE::tsc : equinox::timestamp_clock::SOURCE::monotonic);
+    }
+
+    TEST_F(LogClockTest, Realtime_Coarse_Reading_Is_Already_Nanoseconds_Since_Epoch) {
+        const std::uint64_t ticks = equinox::LogClock::readTicks(equinox::timestamp_clock::SOURCE::realtime_coarse);
+
+        EXPECT_EQ(logClock.toNanosecondsSinceEpoch(equinox::timestamp_clock::SOURCE::realtime_coarse, ticks), static_cast<std::int64_t>(ticks));
+    }
+
+    TEST_F(LogClockTest, Tsc_Reading_Is_Converted_With_Rate_Measured_Against_Monotonic_Clock) {
+        const std::int64_t eventMonotonicNs = kStartMonotonicNs + 500000000;
+
+        const std::int64_t timestampNs = logClock.toNanosecondsSinceEpoch(equinox::timestamp_clock::SOURCE::tsc, logClock.tscTicksAt(eventMonotonicNs));
+
+        EXPECT_NEAR(timestampNs, eventMonotonicNs + kRealtimeOffsetNs, kSimulatedToleranceNs);
+    }
+
+    class LogClockCalibrationTest : public LogClockTest, public ::testing::WithParamInterface<equinox::timestamp_clock::SOURCE> {
+       public:
+        std::uint64_t ticksAt(std::int64_t monotonicNs) const {
+            return (GetParam() == equinox::timestamp_clock::SOURCE::tsc) ? logClock.tscTicksAt(monotonicNs) : static_cast<std::uint64_t>(monotonicNs);
+        }
+    };
+
+    TEST_P(LogClockCalibrationTest, Wall_Clock_Step_Is_Picked_Up_By_Next_Calibration_Only) {
+        constexpr std::int64_t kWallClockStepNs = 3600LL * 1000000000LL;
+        logClock.toNanosecondsSinceEpoch(GetParam(), ticksAt(logClock.monotonicNs));
+        logClock.realtimeOffsetNs += kWallClockStepNs;
+
+        const std::int64_t beforeRecalibrationNs = logClock.monotonicNs + 500000000;
+        EXPECT_NEAR(logClock.toNanosecondsSinceEpoch(GetParam(), ticksAt(beforeRecalibrationNs)), beforeRecalibrationNs + kRealtimeOffsetNs,
+                    kSimulatedToleranceNs);
+
+        logClock.monotonicNs += 2000000000;
+        const std::int64_t afterRecalibrationNs = logClock.monotonicNs;
+        EXPECT_NEAR(logClock.toNanosecondsSinceEpoch(GetParam(), ticksAt(afterRecalibrationNs)), afterRecalibrationNs + kRealtimeOffsetNs + kWallClockStepNs,
+                    kSimulatedToleranceNs);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(CalibratedClocks, LogClockCalibrationTest,
+                             ::testing::Values(equinox::timestamp_clock::SOURCE::monotonic, equinox::timestamp_clock::SOURCE::tsc));
+
+    class LogClockSourceTest : public ::testing::TestWithParam<equinox::timestamp_clock::SOURCE> {};
+
+    TEST_P(LogClockSourceTest, Reading_Is_Converted_To_Current_Wall_Clock_Time) {
+        equinox::LogClock logClock;
+        logClock.setSource(GetParam());
+
+        const std::int64_t beforeNs = systemClockNowNs();
+        const std::uint64_t ticks = equinox::LogClock::readTicks(logClock.getSource());
+        const std::int64_t afterNs = systemClockNowNs();
+        const std::int64_t timestampNs = logClock.toNanosecondsSinceEpoch(logClock.getSource(), ticks);
+
+        EXPECT_GE(timestampNs, beforeNs - kRealClockToleranceNs);
+        EXPECT_LE(timestampNs, afterNs + kRealClockToleranceNs);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(AllTimestampClocks, LogClockSourceTest,
+                             ::testing::Values(equinox::timestamp_clock::SOURCE::monotonic, equinox::timestamp_clock::SOURCE::realtime_coarse,
+                                               equinox::timestamp_clock::SOURCE::tsc));
+
+}  // namespace log_clock_test
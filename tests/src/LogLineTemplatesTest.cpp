@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "ColorFormatter.h"
+#include "LogLineTemplates.h"
+
+namespace log_line_templates_test {
+
+    using namespace equinox;
+    using namespace ::testing;
+
+    class LogLineTemplatesTest : public Test {
+       public:
+        LogLineTemplatesTest() : color_formatter{}, log_line_templates{} {}
+
+        ColorFormatter color_formatter;
+        LogLineTemplates log_line_templates;
+    };
+
+    TEST_F(LogLineTemplatesTest, Default_Templates_Have_Level_Tag_Only) {
+        EXPECT_EQ(log_line_templates.getHeader(level::LOG_LEVEL::info), "[INFO] ");
+        EXPECT_EQ(log_line_templates.getTrailer(level::LOG_LEVEL::info), "");
+    }
+
+    TEST_F(LogLineTemplatesTest, Render_Without_Color_Formatter_And_Header_Has_Prefix_And_Level_Tag) {
+        log_line_templates.render("[TestPrefix]", nullptr);
+
+        EXPECT_EQ(log_line_templates.getHeader(level::LOG_LEVEL::trace), "[TestPrefix][TRACE] ");
+        EXPECT_EQ(log_line_templates.getHeader(level::LOG_LEVEL::critical), "[TestPrefix][CRITICAL] ");
+        EXPECT_EQ(log_line_templates.getTrailer(level::LOG_LEVEL::critical), "");
+    }
+
+    TEST_F(LogLineTemplatesTest, Render_With_Color_Formatter_And_Colored_Levels_Get_Color_And_Reset) {
+        log_line_templates.render("[TestPrefix]", &color_formatter);
+
+        EXPECT_EQ(log_line_templates.getHeader(level::LOG_LEVEL::error), "\033[31m[TestPrefix][ERROR] ");
+        EXPECT_EQ(log_line_templates.getTrailer(level::LOG_LEVEL::error), "\033[0m");
+        EXPECT_EQ(log_line_templates.getHeader(level::LOG_LEVEL::info), "[TestPrefix][INFO] ");
+        EXPECT_EQ(log_line_templates.getTrailer(level::LOG_LEVEL::info), "");
+    }
+
+    TEST_F(LogLineTemplatesTest, Render_Again_And_Previous_Prefix_Is_Replaced) {
+        log_line_templates.render("[First]", nullptr);
+        log_line_templates.render("[Second]", nullptr);
+
+        EXPECT_EQ(log_line_templates.getHeader(level::LOG_LEVEL::warning), "[Second][WARNING] ");
+    }
+
+    TEST_F(LogLineTemplatesTest, Render_Too_Long_Prefix_And_It_Is_Cut_To_Max_Length) {
+        const std::string longPrefix(LogLineTemplates::kMaxLogPrefixLength + 10U, 'p');
+
+        log_line_templates.render(longPrefix, nullptr);
+
+        EXPECT_EQ(log_line_templates.getHeader(level::LOG_LEVEL::debug), std::string(LogLineTemplates::kMaxLogPrefixLength, 'p') + "[DEBUG] ");
+    }
+
+    TEST_F(LogLineTemplatesTest, Get_Templates_For_Off_And_Invalid_Level_And_Empty_Returned) {
+        log_line_templates.render("[TestPrefix]", &color_formatter);
+
+        EXPECT_EQ(log_line_templates.getHeader(level::LOG_LEVEL::off), "[TestPrefix]");
+        EXPECT_EQ(log_line_templates.getHeader(static_cast<level::LOG_LEVEL>(999)), "");
+        EXPECT_EQ(log_line_templates.getTrailer(static_cast<level::LOG_LEVEL>(999)), "");
+    }
+
+}  // namespace log_line_templates_test
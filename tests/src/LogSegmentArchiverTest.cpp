@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#ifdef EQUINOX_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "LogSegmentArchiver.h"
+
+namespace log_segment_archiver_test {
+    using namespace equinox;
+
+    namespace {
+        const std::string kTestSegmentFileName = "archiver_test_1.log";
+        const std::string kTestCompressedFileName = kTestSegmentFileName + ".gz";
+        const std::string kTestSegmentContent = "[time123][Test][INFO] rotated line\n";
+
+        void writeFile(const std::string& fileName, const std::string& content) {
+            std::ofstream file(fileName, std::ofstream::out | std::ofstream::trunc);
+            file << content;
+        }
+
+        std::string readFile(const std::string& fileName) {
+            std::ifstream file(fileName);
+            std::stringstream content;
+            content << file.rdbuf();
+            return content.str();
+        }
+    }
+
+    class LogSegmentArchiverTestable : public LogSegmentArchiver {
+       public:
+        ~LogSegmentArchiverTestable() override {
+            waitIdle();
+        }
+
+        bool compressSegment(const std::string&) override {
+            ++compressCalls;
+            return false;
+        }
+
+        int compressCalls = 0;
+    };
+
+    class LogSegmentArchiverTest : public ::testing::Test {
+       public:
+        LogSegmentArchiverTest() {
+            std::filesystem::remove(kTestSegmentFileName);
+            std::filesystem::remove(kTestCompressedFileName);
+        }
+
+        ~LogSegmentArchiverTest() override {
+            std::filesystem::remove(kTestSegmentFileName);
+            std::filesystem::remove(kTestCompressedFileName);
+        }
+    };
+
+    TEST_F(LogSegmentArchiverTest, No_Compression_And_Rotated_File_Kept_Unchanged) {
+        LogSegmentArchiver logSegmentArchiver;
+        writeFile(kTestSegmentFileName, kTestSegmentContent);
+
+        logSegmentArchiver.archive(kTestSegmentFileName);
+        logSegmentArchiver.waitIdle();
+
+        EXPECT_EQ(readFile(kTestSegmentFileName), kTestSegmentContent);
+        EXPECT_FALSE(std::filesystem::exists(kTestCompressedFileName));
+    }
+
+    TEST_F(LogSegmentArchiverTest, Gzip_Compression_But_Compress_Failed_And_Rotated_File_Kept_Uncompressed) {
+        LogSegmentArchiverTestable logSegmentArchiver;
+        logSegmentArchiver.setCompression(file_compression::MODE::gzip);
+        writeFile(kTestSegmentFileName, kTestSegmentContent);
+
+        logSegmentArchiver.archive(kTestSegmentFileName);
+        logSegmentArchiver.waitIdle();
+
+#ifdef EQUINOX_HAS_ZLIB
+        EXPECT_EQ(logSegmentArchiver.compressCalls, 1);
+#endif
+        EXPECT_EQ(readFile(kTestSegmentFileName), kTestSegmentContent);
+        EXPECT_FALSE(std::filesystem::exists(kTestCompressedFileName));
+    }
+
+    TEST_F(LogSegmentArchiverTest, Drop_Page_Cache_And_Rotated_File_Kept_Unchanged) {
+        LogSegmentArchiver logSegmentArchiver;
+        logSegmentArchiver.setDropPageCache(true);
+        writeFile(kTestSegmentFileName, kTestSegmentContent);
+
+        logSegmentArchiver.archive(kTestSegmentFileName);
+        logSegmentArchiver.waitIdle();
+
+        EXPECT_EQ(readFile(kTestSegmentFileName), kTestSegmentContent);
+    }
+
+    TEST_F(LogSegmentArchiverTest, Retire_And_Rotated_File_And_Its_Archive_Removed) {
+        LogSegmentArchiver logSegmentArchiver;
+        writeFile(kTestSegmentFileName, kTestSegmentContent);
+        writeFile(kTestCompressedFileName, "archive");
+
+        logSegmentArchiver.retire(kTestSegmentFileName);
+        logSegmentArchiver.waitIdle();
+
+        EXPECT_FALSE(std::filesystem::exists(kTestSegmentFileName));
+        EXPECT_FALSE(std::filesystem::exists(kTestCompressedFileName));
+    }
+
+    TEST_F(LogSegmentArchiverTest, Archive_Then_Retire_And_Segment_Archived_Before_It_Is_Removed) {
+        LogSegmentArchiverTestable logSegmentArchiver;
+        logSegmentArchiver.setCompression(file_compression::MODE::gzip);
+        writeFile(kTestSegmentFileName, kTestSegmentContent);
+
+        logSegmentArchiver.archive(kTestSegmentFileName);
+        logSegmentArchiver.retire(kTestSegmentFileName);
+        logSegmentArchiver.waitIdle();
+
+#ifdef EQUINOX_HAS_ZLIB
+        EXPECT_EQ(logSegmentArchiver.compressCalls, 1);
+#endif
+        EXPECT_FALSE(std::filesystem::exists(kTestSegmentFileName));
+    }
+
+    TEST_F(LogSegmentArchiverTest, Wait_Idle_And_Nothing_Handed_Over_Returns_At_Once) {
+        LogSegmentArchiver logSegmentArchiver;
+
+        logSegmentArchiver.waitIdle();
+
+        EXPECT_FALSE(std::filesystem::exists(kTestCompressedFileName));
+    }
+
+#ifdef EQUINOX_HAS_ZLIB
+    TEST_F(LogSegmentArchiverTest, Gzip_Compression_And_Rotated_File_Replaced_By_Archive_With_Same_Content) {
+        LogSegmentArchiver logSegmentArchiver;
+        logSegmentArchiver.setCompression(file_compression::MODE::gzip);
+        writeFile(kTestSegmentFileName, kTestSegmentContent);
+
+        logSegmentArchiver.archive(kTestSegmentFileName);
+        logSegmentArchiver.waitIdle();
+
+        EXPECT_FALSE(std::filesystem::exists(kTestSegmentFileName));
+        gzFile compressedFile = gzopen(kTestCompressedFileName.c_str(), "rb");
+        ASSERT_NE(compressedFile, nullptr);
+        char content[256] = {};
+        const int readBytes = gzread(compressedFile, content, sizeof(content));
+        gzclose(compressedFile);
+        EXPECT_EQ(std::string(content, static_cast<std::size_t>(readBytes)), kTestSegmentContent);
+    }
+
+    TEST_F(LogSegmentArchiverTest, Gzip_Compression_But_Rotated_File_Is_Missing_And_Nothing_Written) {
+        LogSegmentArchiver logSegmentArchiver;
+        logSegmentArchiver.setCompression(file_compression::MODE::gzip);
+
+        logSegmentArchiver.archive(kTestSegmentFileName);
+        logSegmentArchiver.waitIdle();
+
+        EXPECT_FALSE(std::filesystem::exists(kTestCompressedFileName));
+    }
+#endif
+
+}  // namespace log_segment_archiver_test
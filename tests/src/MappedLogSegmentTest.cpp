@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "MappedLogSegment.h"
+
+namespace mapped_log_segment_test {
+    using namespace equinox;
+
+    namespace {
+        const std::string kTestSegmentFileName = "mapped_segment_test.log";
+        const std::size_t kTestReserveBytes = 8U * 1024U * 1024U;
+        const std::string kTestLine = "[time123][Test][INFO] mapped line\n";
+
+        std::string readFile(const std::string& fileName) {
+            std::ifstream file(fileName);
+            std::stringstream content;
+            content << file.rdbuf();
+            return content.str();
+        }
+    }
+
+    class MappedLogSegmentTestable : public MappedLogSegment {
+       public:
+        using MappedLogSegment::getCapacity;
+    };
+
+    class MappedLogSegmentTest : public ::testing::Test {
+       public:
+        MappedLogSegmentTest() {
+            std::filesystem::remove(kTestSegmentFileName);
+        }
+
+        ~MappedLogSegmentTest() override {
+            mapped_log_segment.close();
+            std::filesystem::remove(kTestSegmentFileName);
+        }
+
+        MappedLogSegmentTestable mapped_log_segment;
+    };
+
+    TEST_F(MappedLogSegmentTest, Open_And_File_Preallocated_To_Reserved_Size) {
+        EXPECT_TRUE(mapped_log_segment.open(kTestSegmentFileName, kTestReserveBytes, false));
+
+        EXPECT_TRUE(mapped_log_segment.isOpen());
+        EXPECT_EQ(mapped_log_segment.getSize(), 0U);
+        EXPECT_EQ(mapped_log_segment.getCapacity(), kTestReserveBytes);
+        EXPECT_EQ(std::filesystem::file_size(kTestSegmentFileName), kTestReserveBytes);
+    }
+
+    TEST_F(MappedLogSegmentTest, Try_Open_But_Directory_Does_Not_Exist) {
+        EXPECT_FALSE(mapped_log_segment.open("missing_directory/mapped_segment_test.log", kTestReserveBytes, false));
+
+        EXPECT_FALSE(mapped_log_segment.isOpen());
+    }
+
+    TEST_F(MappedLogSegmentTest, Try_Open_Next_File_But_Directory_Does_Not_Exist_And_Open_Segment_Kept) {
+        ASSERT_TRUE(mapped_log_segment.open(kTestSegmentFileName, kTestReserveBytes, false));
+        mapped_log_segment.append(kTestLine.data(), kTestLine.size());
+
+        EXPECT_FALSE(mapped_log_segment.open("missing_directory/mapped_segment_test.log", kTestReserveBytes, true));
+        EXPECT_TRUE(mapped_log_segment.append(kTestLine.data(), kTestLine.size()));
+        mapped_log_segment.close();
+
+        EXPECT_EQ(readFile(kTestSegmentFileName), kTestLine + kTestLine);
+    }
+
+    TEST_F(MappedLogSegmentTest, Try_Append_But_Segment_Is_Not_Open) {
+        EXPECT_FALSE(mapped_log_segment.append(kTestLine.data(), kTestLine.size()));
+    }
+
+    TEST_F(MappedLogSegmentTest, Append_And_Close_And_File_Cut_To_Written_Lines) {
+        mapped_log_segment.open(kTestSegmentFileName, kTestReserveBytes, false);
+
+        EXPECT_TRUE(mapped_log_segment.append(kTestLine.data(), kTestLine.size()));
+        EXPECT_TRUE(mapped_log_segment.sync());
+        mapped_log_segment.close();
+
+        EXPECT_FALSE(mapped_log_segment.isOpen());
+        EXPECT_EQ(readFile(kTestSegmentFileName), kTestLine);
+    }
+
+    TEST_F(MappedLogSegmentTest, Append_Past_Capacity_And_Segment_Grown) {
+        mapped_log_segment.open(kTestSegmentFileName, 0U, false);
+        const std::size_t initialCapacity = mapped_log_segment.getCapacity();
+        const std::string largeBatch(initialCapacity + 1U, 'x');
+
+        EXPECT_TRUE(mapped_log_segment.append(largeBatch.data(), largeBatch.size()));
+
+        EXPECT_GT(mapped_log_segment.getCapacity(), initialCapacity);
+        EXPECT_EQ(mapped_log_segment.getSize(), largeBatch.size());
+        mapped_log_segment.close();
+        EXPECT_EQ(std::filesystem::file_size(kTestSegmentFileName), largeBatch.size());
+    }
+
+    TEST_F(MappedLogSegmentTest, Open_Existing_File_And_Lines_Appended_After_Its_Content) {
+        {
+            std::ofstream existingFile(kTestSegmentFileName);
+            existingFile << kTestLine;
+        }
+
+        mapped_log_segment.open(kTestSegmentFileName, kTestReserveBytes, false);
+        mapped_log_segment.append(kTestLine.data(), kTestLine.size());
+        mapped_log_segment.close();
+
+        EXPECT_EQ(readFile(kTestSegmentFileName), kTestLine + kTestLine);
+    }
+
+    TEST_F(MappedLogSegmentTest, Open_Existing_File_With_Truncate_And_Content_Dropped) {
+        {
+            std::ofstream existingFile(kTestSegmentFileName);
+            existingFile << kTestLine;
+        }
+
+        mapped_log_segment.open(kTestSegmentFileName, kTestReserveBytes, true);
+
+        EXPECT_EQ(mapped_log_segment.getSize(), 0U);
+    }
+
+    TEST_F(MappedLogSegmentTest, Open_Segment_Left_With_Zero_Padding_And_Lines_Appended_Before_Padding) {
+        {
+            std::ofstream existingFile(kTestSegmentFileName, std::ofstream::binary);
+            existingFile << kTestLine << std::string(4096U, '\0');
+        }
+
+        mapped_log_segment.open(kTestSegmentFileName, kTestReserveBytes, false);
+
+        EXPECT_EQ(mapped_log_segment.getSize(), kTestLine.size());
+    }
+
+}  // namespace mapped_log_segment_test
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "OverflowStats.h"
+
+namespace overflow_stats_test {
+
+    class OverflowStatsTest : public ::testing::Test {
+       public:
+        equinox::OverflowStats overflowStats;
+    };
+
+    TEST_F(OverflowStatsTest, Dropped_Messages_Are_Counted_Per_Level_And_In_Total) {
+        overflowStats.recordDroppedMessage(equinox::level::LOG_LEVEL::debug);
+        overflowStats.recordDroppedMessage(equinox::level::LOG_LEVEL::debug);
+        overflowStats.recordDroppedMessage(equinox::level::LOG_LEVEL::error);
+
+        EXPECT_EQ(overflowStats.getDroppedMessagesCount(equinox::level::LOG_LEVEL::debug), 2U);
+        EXPECT_EQ(overflowStats.getDroppedMessagesCount(equinox::level::LOG_LEVEL::error), 1U);
+        EXPECT_EQ(overflowStats.getDroppedMessagesCount(equinox::level::LOG_LEVEL::info), 0U);
+        EXPECT_EQ(overflowStats.getDroppedMessagesCount(), 3U);
+    }
+
+    TEST_F(OverflowStatsTest, Messages_Dropped_Since_Last_Marker_Are_Reset_But_Per_Level_Counts_Are_Kept) {
+        overflowStats.recordDroppedMessage(equinox::level::LOG_LEVEL::info);
+        overflowStats.recordDroppedMessage(equinox::level::LOG_LEVEL::warning);
+
+        EXPECT_EQ(overflowStats.takeDroppedMessagesSinceLastMarker(), 2U);
+        EXPECT_EQ(overflowStats.takeDroppedMessagesSinceLastMarker(), 0U);
+        EXPECT_EQ(overflowStats.getDroppedMessagesCount(), 2U);
+    }
+
+    TEST_F(OverflowStatsTest, Level_Off_Is_Not_Counted_Per_Level_But_Still_Marked_As_Gap) {
+        overflowStats.recordDroppedMessage(equinox::level::LOG_LEVEL::off);
+
+        EXPECT_EQ(overflowStats.getDroppedMessagesCount(equinox::level::LOG_LEVEL::off), 0U);
+        EXPECT_EQ(overflowStats.getDroppedMessagesCount(), 0U);
+        EXPECT_EQ(overflowStats.takeDroppedMessagesSinceLastMarker(), 1U);
+    }
+
+}  // namespace overflow_stats_test
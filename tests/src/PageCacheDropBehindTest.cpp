@@ -0,0 +1,108 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PageCacheDropBehind.h"
+
+namespace page_cache_drop_behind_test {
+    using namespace equinox;
+
+    namespace {
+        const std::size_t kTestWindowBytes = 4096U;
+        const int kTestFd = 7;
+        const std::string kTestLogFileName = "drop_behind_test.log";
+    }
+
+    class PageCacheDropBehindTestable : public PageCacheDropBehind {
+       public:
+        PageCacheDropBehindTestable() : PageCacheDropBehind(kTestWindowBytes) {}
+
+        void startWriteback(int, std::size_t offset, std::size_t length) override {
+            writebacks.emplace_back(offset, length);
+        }
+
+        void dropWindow(int, std::size_t offset, std::size_t length) override {
+            drops.emplace_back(offset, length);
+        }
+
+        std::vector<std::pair<std::size_t, std::size_t>> writebacks;
+        std::vector<std::pair<std::size_t, std::size_t>> drops;
+    };
+
+    class PageCacheDropBehindTest : public ::testing::Test {
+       public:
+        PageCacheDropBehindTestable page_cache_drop_behind;
+    };
+
+    TEST_F(PageCacheDropBehindTest, Written_Less_Than_A_Window_And_Nothing_Done) {
+        page_cache_drop_behind.written(kTestFd, kTestWindowBytes - 1U);
+
+        EXPECT_TRUE(page_cache_drop_behind.writebacks.empty());
+        EXPECT_TRUE(page_cache_drop_behind.drops.empty());
+    }
+
+    TEST_F(PageCacheDropBehindTest, First_Window_Full_And_Its_Writeback_Started_Without_Drop) {
+        page_cache_drop_behind.written(kTestFd, kTestWindowBytes);
+
+        ASSERT_EQ(page_cache_drop_behind.writebacks.size(), 1U);
+        EXPECT_EQ(page_cache_drop_behind.writebacks[0], std::make_pair(std::size_t{0U}, kTestWindowBytes));
+        EXPECT_TRUE(page_cache_drop_behind.drops.empty());
+    }
+
+    TEST_F(PageCacheDropBehindTest, Second_Window_Full_And_First_Window_Dropped) {
+        page_cache_drop_behind.written(kTestFd, kTestWindowBytes);
+        page_cache_drop_behind.written(kTestFd, 2U * kTestWindowBytes + 10U);
+
+        ASSERT_EQ(page_cache_drop_behind.writebacks.size(), 2U);
+        EXPECT_EQ(page_cache_drop_behind.writebacks[1], std::make_pair(kTestWindowBytes, kTestWindowBytes));
+        ASSERT_EQ(page_cache_drop_behind.drops.size(), 1U);
+        EXPECT_EQ(page_cache_drop_behind.drops[0], std::make_pair(std::size_t{0U}, kTestWindowBytes));
+    }
+
+    TEST_F(PageCacheDropBehindTest, Reset_To_Size_Of_Opened_File_And_Windows_Start_There) {
+        page_cache_drop_behind.reset(100U);
+
+        page_cache_drop_behind.written(kTestFd, 100U + kTestWindowBytes);
+
+        ASSERT_EQ(page_cache_drop_behind.writebacks.size(), 1U);
+        EXPECT_EQ(page_cache_drop_behind.writebacks[0], std::make_pair(std::size_t{100U}, kTestWindowBytes));
+    }
+
+    TEST_F(PageCacheDropBehindTest, Written_With_Size_Below_Window_Start_And_Nothing_Done) {
+        page_cache_drop_behind.written(kTestFd, kTestWindowBytes);
+
+        page_cache_drop_behind.written(kTestFd, kTestWindowBytes - 10U);
+
+        EXPECT_EQ(page_cache_drop_behind.writebacks.size(), 1U);
+        EXPECT_TRUE(page_cache_drop_behind.drops.empty());
+    }
+
+    TEST_F(PageCacheDropBehindTest, Try_Written_But_File_Descriptor_Is_Invalid) {
+        page_cache_drop_behind.written(-1, 3U * kTestWindowBytes);
+
+        EXPECT_TRUE(page_cache_drop_behind.writebacks.empty());
+    }
+
+    TEST(PageCacheDropBehindFileTest, Written_To_Real_File_And_Content_Unchanged) {
+        PageCacheDropBehind pageCacheDropBehind(kTestWindowBytes);
+        const int fd = ::open(kTestLogFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        ASSERT_GE(fd, 0);
+        const std::string window(kTestWindowBytes, 'x');
+
+        for (std::size_t windowIndex = 1U; windowIndex <= 3U; ++windowIndex) {
+            ASSERT_EQ(::write(fd, window.data(), window.size()), static_cast<ssize_t>(window.size()));
+            pageCacheDropBehind.written(fd, windowIndex * kTestWindowBytes);
+        }
+        ::close(fd);
+
+        EXPECT_EQ(std::filesystem::file_size(kTestLogFileName), 3U * kTestWindowBytes);
+        std::filesystem::remove(kTestLogFileName);
+    }
+
+}  // namespace page_cache_drop_behind_test
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "PerCpuLogQueue.h"
+
+namespace per_cpu_log_queue_test {
+namespace {
+constexpr size_t kTestCpuRingCapacityBytes = 4096;
+constexpr size_t kTestCpuCount = 4;
+constexpr size_t kTestMaxBatchSize = 64;
+constexpr uint32_t kTestTimeoutMs = 10;
+constexpr const char* testMessage = "Test log message";
+}  // namespace
+
+/* Lets a test choose the CPU ring the calling thread appends to */
+class PerCpuLogQueueForTests : public ::equinox::PerCpuLogQueue {
+ public:
+  PerCpuLogQueueForTests(size_t cpu_ring_capacity_bytes, size_t cpu_count) : PerCpuLogQueue(cpu_ring_capacity_bytes, cpu_count) {}
+
+  void setCurrentCpu(size_t cpu) { mCurrentCpu_ = cpu; }
+  size_t getCpuRingsCountForTests() const { return getCpuRingsCount(); }
+  size_t getCpuRingCapacityForTests() const { return getCpuRingCapacity(); }
+  uint64_t getDroppedMessagesCountForTests() const { return getDroppedMessagesCount(); }
+
+ protected:
+  size_t getCurrentCpu() const override { return mCurrentCpu_.load(); }
+
+ private:
+  std::atomic<size_t> mCurrentCpu_{0U};
+};
+
+class PerCpuLogQueueTest : public ::testing::Test {
+ public:
+  PerCpuLogQueueTest() : perCpuLogQueue{kTestCpuRingCapacityBytes, kTestCpuCount} {}
+
+  std::vector<std::string> consumeAll() {
+    std::vector<std::string> consumed;
+    while (perCpuLogQueue.consume([&consumed](std::string_view logRecord) { consumed.emplace_back(logRecord); }, kTestMaxBatchSize, kTestTimeoutMs)) {
+    }
+    return consumed;
+  }
+
+  PerCpuLogQueueForTests perCpuLogQueue;
+};
+
+TEST_F(PerCpuLogQueueTest, One_Ring_Is_Created_Per_Cpu_And_Memory_Does_Not_Depend_On_Threads) {
+  EXPECT_EQ(perCpuLogQueue.getCpuRingsCountForTests(), kTestCpuCount);
+  EXPECT_EQ(perCpuLogQueue.getCpuRingCapacityForTests(), kTestCpuRingCapacityBytes);
+
+  std::vector<std::thread> producers;
+  for (int i = 0; i < 16; ++i) {
+    producers.emplace_back([this]() { perCpuLogQueue.enqueue(testMessage); });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  EXPECT_EQ(perCpuLogQueue.getCpuRingsCountForTests(), kTestCpuCount);
+  EXPECT_EQ(consumeAll().size(), 16U);
+}
+
+TEST_F(PerCpuLogQueueTest, Try_Consume_From_Empty_Queue_And_Return_False) {
+  EXPECT_FALSE(perCpuLogQueue.consume([](std::string_view) {}, kTestMaxBatchSize, kTestTimeoutMs));
+}
+
+TEST_F(PerCpuLogQueueTest, Messages_From_Every_Cpu_Are_Consumed_And_Ordered_Per_Cpu) {
+  for (size_t cpu = 0; cpu < kTestCpuCount; ++cpu) {
+    perCpuLogQueue.setCurrentCpu(cpu);
+    for (int i = 0; i < 3; ++i) {
+      perCpuLogQueue.enqueue(std::to_string(cpu) + ":" + std::to_string(i));
+    }
+  }
+
+  std::vector<int> nextExpectedIndex(kTestCpuCount, 0);
+  for (const auto& message : consumeAll()) {
+    const size_t separator = message.find(':');
+    const size_t cpu = std::stoul(message.substr(0, separator));
+    EXPECT_EQ(std::stoi(message.substr(separator + 1)), nextExpectedIndex[cpu]);
+    ++nextExpectedIndex[cpu];
+  }
+
+  for (size_t cpu = 0; cpu < kTestCpuCount; ++cpu) {
+    EXPECT_EQ(nextExpectedIndex[cpu], 3);
+  }
+}
+
+TEST_F(PerCpuLogQueueTest, Cpu_Number_Above_Ring_Count_Wraps_Around) {
+  perCpuLogQueue.setCurrentCpu(kTestCpuCount + 1);
+  perCpuLogQueue.enqueue(testMessage);
+
+  const std::vector<std::string> consumed = consumeAll();
+  ASSERT_EQ(consumed.size(), 1U);
+  EXPECT_EQ(consumed[0], testMessage);
+}
+
+TEST_F(PerCpuLogQueueTest, Cpu_Ring_Is_Full_And_Newest_Message_Is_Dropped_While_Other_Cpus_Still_Accept) {
+  const std::string message(500, 'x');
+  while (perCpuLogQueue.getDroppedMessagesCountForTests() == 0U) {
+    perCpuLogQueue.enqueue(message);
+  }
+
+  perCpuLogQueue.setCurrentCpu(1);
+  perCpuLogQueue.enqueue(testMessage);
+
+  const std::vector<std::string> consumed = consumeAll();
+  EXPECT_EQ(std::count(consumed.begin(), consumed.end(), testMessage), 1);
+  EXPECT_EQ(perCpuLogQueue.getDroppedMessagesCountForTests(), 1U);
+}
+
+TEST_F(PerCpuLogQueueTest, Block_Policy_Waits_Until_Worker_Drains_The_Cpu_Ring) {
+  perCpuLogQueue.setOverflowPolicy(equinox::overflow::POLICY::block, 5000U, nullptr);
+  const std::string message(500, 'x');
+  while (perCpuLogQueue.tryEnqueue(message)) {
+  }
+
+  std::vector<std::string> consumed;
+  std::thread consumer([this, &consumed]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    consumed = consumeAll();
+  });
+  EXPECT_TRUE(perCpuLogQueue.enqueue(testMessage));
+  consumer.join();
+
+  EXPECT_FALSE(consumed.empty());
+  EXPECT_EQ(perCpuLogQueue.getDroppedMessagesCountForTests(), 1U);
+}
+
+TEST_F(PerCpuLogQueueTest, Records_Wrapping_Around_The_End_Of_Ring_Are_Consumed_Intact) {
+  for (int round = 0; round < 50; ++round) {
+    const std::string message = std::string(300 + round * 7, static_cast<char>('a' + round % 26));
+    perCpuLogQueue.enqueue(message);
+
+    const std::vector<std::string> consumed = consumeAll();
+    ASSERT_EQ(consumed.size(), 1U);
+    EXPECT_EQ(consumed[0], message);
+  }
+}
+
+TEST_F(PerCpuLogQueueTest, Many_Threads_Appending_To_The_Same_Cpu_Ring_Do_Not_Lose_Or_Corrupt_Messages) {
+  constexpr int kThreadCount = 4;
+  constexpr int kMessagesPerThread = 2000;
+  PerCpuLogQueueForTests queue{256 * 1024, 1};
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < kThreadCount; ++t) {
+    producers.emplace_back([&queue, t]() {
+      for (int i = 0; i < kMessagesPerThread; ++i) {
+        queue.enqueue(std::to_string(t) + ":" + std::to_string(i));
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  std::vector<int> nextExpectedIndex(kThreadCount, 0);
+  while (queue.consume(
+      [&nextExpectedIndex](std::string_view logRecord) {
+        const size_t separator = logRecord.find(':');
+        const int thread = std::stoi(std::string(logRecord.substr(0, separator)));
+        EXPECT_EQ(std::stoi(std::string(logRecord.substr(separator + 1))), nextExpectedIndex[thread]);
+        ++nextExpectedIndex[thread];
+      },
+      kTestMaxBatchSize, kTestTimeoutMs)) {
+  }
+
+  for (int t = 0; t < kThreadCount; ++t) {
+    EXPECT_EQ(nextExpectedIndex[t], kMessagesPerThread);
+  }
+}
+
+TEST_F(PerCpuLogQueueTest, Consume_Waits_For_Message_Enqueued_By_Other_Thread) {
+  std::thread producer([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    perCpuLogQueue.enqueue(testMessage);
+  });
+
+  std::string consumed;
+  const bool result = perCpuLogQueue.consume([&consumed](std::string_view logRecord) { consumed = logRecord; }, kTestMaxBatchSize, 5000);
+  producer.join();
+
+  ASSERT_TRUE(result);
+  EXPECT_EQ(consumed, testMessage);
+}
+
+TEST_F(PerCpuLogQueueTest, Stop_Queue_And_Dequeue_Returns_Remaining_Messages_Then_False) {
+  perCpuLogQueue.enqueue(testMessage);
+  perCpuLogQueue.stop();
+
+  std::vector<std::string> out;
+  EXPECT_TRUE(perCpuLogQueue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs));
+  out.clear();
+  EXPECT_FALSE(perCpuLogQueue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs));
+}
+
+}  // namespace per_cpu_log_queue_test
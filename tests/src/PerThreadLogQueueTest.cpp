@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PerThreadLogQueue.h"
+
+namespace per_thread_log_queue_test {
+namespace {
+constexpr size_t kTestRingCapacity = 8;
+constexpr size_t kTestMaxBatchSize = 64;
+constexpr uint32_t kTestTimeoutMs = 10;
+constexpr const char* testMessage = "Test log message";
+}  // namespace
+
+class PerThreadLogQueueForTests : public ::equinox::PerThreadLogQueue {
+ public:
+  explicit PerThreadLogQueueForTests(size_t ring_capacity) : PerThreadLogQueue(ring_capacity) {}
+
+  size_t getRingsCountForTests() { return getRingsCount(); }
+  uint64_t getDroppedMessagesCountForTests() const { return getDroppedMessagesCount(); }
+};
+
+class PerThreadLogQueueTest : public ::testing::Test {
+ public:
+  PerThreadLogQueueTest() : perThreadLogQueue{kTestRingCapacity} {}
+
+  PerThreadLogQueueForTests perThreadLogQueue;
+};
+
+TEST_F(PerThreadLogQueueTest, Try_Dequeue_From_Empty_Queue_And_Return_False) {
+  std::vector<std::string> out;
+  EXPECT_FALSE(perThreadLogQueue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs));
+  EXPECT_TRUE(out.empty());
+}
+
+TEST_F(PerThreadLogQueueTest, Enqueue_And_Dequeue_Messages_From_One_Thread_And_Order_Is_Preserved) {
+  for (int i = 0; i < 5; ++i) {
+    perThreadLogQueue.enqueue(testMessage + std::to_string(i));
+  }
+
+  std::vector<std::string> out;
+  ASSERT_TRUE(perThreadLogQueue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs));
+  ASSERT_EQ(out.size(), 5U);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(out[i], testMessage + std::to_string(i));
+  }
+}
+
+TEST_F(PerThreadLogQueueTest, Enqueue_More_Messages_Than_Max_Batch_Size_And_Dequeue_Returns_Max_Batch_Size) {
+  for (int i = 0; i < 6; ++i) {
+    perThreadLogQueue.enqueue(testMessage);
+  }
+
+  std::vector<std::string> out;
+  ASSERT_TRUE(perThreadLogQueue.dequeue(out, 4, kTestTimeoutMs));
+  EXPECT_EQ(out.size(), 4U);
+
+  out.clear();
+  ASSERT_TRUE(perThreadLogQueue.dequeue(out, 4, kTestTimeoutMs));
+  EXPECT_EQ(out.size(), 2U);
+}
+
+TEST_F(PerThreadLogQueueTest, Ring_Is_Full_And_Newest_Message_Is_Dropped_And_Counted) {
+  for (size_t i = 0; i < kTestRingCapacity + 3; ++i) {
+    perThreadLogQueue.enqueue(testMessage + std::to_string(i));
+  }
+
+  std::vector<std::string> out;
+  ASSERT_TRUE(perThreadLogQueue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs));
+  ASSERT_EQ(out.size(), kTestRingCapacity);
+  EXPECT_EQ(out.back(), testMessage + std::to_string(kTestRingCapacity - 1));
+  EXPECT_EQ(perThreadLogQueue.getDroppedMessagesCountForTests(), 3U);
+}
+
+TEST_F(PerThreadLogQueueTest, Block_Policy_Waits_Until_Worker_Drains_The_Ring) {
+  perThreadLogQueue.setOverflowPolicy(equinox::overflow::POLICY::block, 5000U, nullptr);
+  for (size_t i = 0; i < kTestRingCapacity; ++i) {
+    ASSERT_TRUE(perThreadLogQueue.enqueue(testMessage + std::to_string(i)));
+  }
+  EXPECT_FALSE(perThreadLogQueue.tryEnqueue(testMessage));
+
+  std::vector<std::string> out;
+  std::thread consumer([this, &out]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    perThreadLogQueue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs);
+  });
+  EXPECT_TRUE(perThreadLogQueue.enqueue(testMessage));
+  consumer.join();
+
+  EXPECT_GE(out.size(), kTestRingCapacity);
+  EXPECT_EQ(perThreadLogQueue.getDroppedMessagesCountForTests(), 1U);
+}
+
+TEST_F(PerThreadLogQueueTest, Enqueue_From_Many_Threads_And_All_Messages_Are_Dequeued_In_Per_Thread_Order) {
+  constexpr int kThreadCount = 4;
+  constexpr int kMessagesPerThread = 1000;
+  PerThreadLogQueueForTests queue{kMessagesPerThread};
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < kThreadCount; ++t) {
+    producers.emplace_back([&queue, t]() {
+      for (int i = 0; i < kMessagesPerThread; ++i) {
+        queue.enqueue(std::to_string(t) + ":" + std::to_string(i));
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  std::vector<int> nextExpectedIndex(kThreadCount, 0);
+  std::vector<std::string> out;
+  while (queue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs)) {
+    for (const auto& message : out) {
+      const size_t separator = message.find(':');
+      const int thread = std::stoi(message.substr(0, separator));
+      EXPECT_EQ(std::stoi(message.substr(separator + 1)), nextExpectedIndex[thread]);
+      ++nextExpectedIndex[thread];
+    }
+    out.clear();
+  }
+
+  for (int t = 0; t < kThreadCount; ++t) {
+    EXPECT_EQ(nextExpectedIndex[t], kMessagesPerThread);
+  }
+}
+
+TEST_F(PerThreadLogQueueTest, Dequeue_Waits_For_Message_Enqueued_By_Other_Thread) {
+  std::thread producer([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    perThreadLogQueue.enqueue(testMessage);
+  });
+
+  std::vector<std::string> out;
+  const bool dequeued = perThreadLogQueue.dequeue(out, kTestMaxBatchSize, 5000);
+  producer.join();
+
+  ASSERT_TRUE(dequeued);
+  ASSERT_EQ(out.size(), 1U);
+  EXPECT_EQ(out[0], testMessage);
+}
+
+TEST_F(PerThreadLogQueueTest, Thread_Exits_And_Its_Ring_Is_Reclaimed_After_Being_Drained) {
+  std::thread producer([this]() { perThreadLogQueue.enqueue(testMessage); });
+  producer.join();
+  EXPECT_EQ(perThreadLogQueue.getRingsCountForTests(), 1U);
+
+  std::vector<std::string> out;
+  ASSERT_TRUE(perThreadLogQueue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs));
+  ASSERT_EQ(out.size(), 1U);
+  EXPECT_EQ(out[0], testMessage);
+  EXPECT_EQ(perThreadLogQueue.getRingsCountForTests(), 0U);
+}
+
+TEST_F(PerThreadLogQueueTest, Stop_Queue_And_Dequeue_Returns_Remaining_Messages_Then_False) {
+  perThreadLogQueue.enqueue(testMessage);
+  perThreadLogQueue.stop();
+
+  std::vector<std::string> out;
+  EXPECT_TRUE(perThreadLogQueue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs));
+  out.clear();
+  EXPECT_FALSE(perThreadLogQueue.dequeue(out, kTestMaxBatchSize, kTestTimeoutMs));
+}
+
+}  // namespace per_thread_log_queue_test
@@ -39,34 +39,99 @@
 
 #include <gtest/gtest.h>
 
-#include <iostream>
+#include <cstdint>
+#include <ctime>
 #include <memory>
+#include <string>
 
 #include "TimestampProducer.h"
 
 namespace time_stampproducer_tests {
 
+namespace {
+/* 2024-06-01T12:00:00Z */
+constexpr std::int64_t kTimestampSeconds = 1717243200;
+constexpr std::int64_t kNanosecondsPerSecond = 1000000000;
+constexpr std::int64_t kTimestampNs = kTimestampSeconds * kNanosecondsPerSecond + 123456789;
+}  // namespace
+
+class TimestampProducerTestable : public equinox::TimestampProducer {
+ public:
+  mutable int localUtcOffsetLookups = 0;
+  long localUtcOffsetSeconds = 0;
+
+ protected:
+  long getLocalUtcOffsetSeconds(std::time_t) const override {
+    ++localUtcOffsetLookups;
+    return localUtcOffsetSeconds;
+  }
+};
+
 class TimestampProducerTests : public ::testing::Test {
  public:
-  TimestampProducerTests() : mTimestampProducer{std::make_unique<equinox::TimestampProducer>()} {}
+  std::string format(std::int64_t timestampNs) {
+    char buffer[equinox::kMaxTimestampLength];
+    const std::size_t length = timestampProducer.formatTimestamp(timestampNs, buffer);
+    EXPECT_LE(length, equinox::kMaxTimestampLength);
+    return std::string(buffer, length);
+  }
 
-  std::unique_ptr<equinox::ITimestampProducer> mTimestampProducer;
+  TimestampProducerTestable timestampProducer;
 };
 
-TEST_F(TimestampProducerTests, Call_getTimestamp_And_No_Failure) {
-  ASSERT_NO_FATAL_FAILURE(mTimestampProducer->getTimestamp());
+TEST_F(TimestampProducerTests, Utc_Timestamp_Is_Iso_8601_With_Microseconds_By_Default) {
+  timestampProducer.setFormat(equinox::timestamp_format::ZONE::utc, equinox::LoggerOptions{}.timestampPrecision);
+
+  EXPECT_EQ(format(kTimestampNs), "[2024-06-01T12:00:00.123456Z]");
 }
 
-TEST_F(TimestampProducerTests, Call_getTimestampInUs_And_No_Failure) {
-  ASSERT_NO_FATAL_FAILURE(mTimestampProducer->getTimestampInUs());
+TEST_F(TimestampProducerTests, Nanosecond_Precision_Keeps_Every_Digit_And_Leading_Zeros) {
+  timestampProducer.setFormat(equinox::timestamp_format::ZONE::utc, equinox::timestamp_format::PRECISION::nanoseconds);
+
+  EXPECT_EQ(format(kTimestampNs), "[2024-06-01T12:00:00.123456789Z]");
+  EXPECT_EQ(format(kTimestampSeconds * kNanosecondsPerSecond + 7), "[2024-06-01T12:00:00.000000007Z]");
 }
 
-TEST_F(TimestampProducerTests, Call_getTimestamp_And_Print_Result) {
-  std::cout << mTimestampProducer->getTimestamp() << std::endl;
+TEST_F(TimestampProducerTests, Cached_Second_Is_Replaced_When_Next_Second_Starts) {
+  timestampProducer.setFormat(equinox::timestamp_format::ZONE::utc, equinox::timestamp_format::PRECISION::microseconds);
+
+  EXPECT_EQ(format(kTimestampSeconds * kNanosecondsPerSecond + 999999999), "[2024-06-01T12:00:00.999999Z]");
+  EXPECT_EQ(format((kTimestampSeconds + 1) * kNanosecondsPerSecond), "[2024-06-01T12:00:01.000000Z]");
+  EXPECT_EQ(format((kTimestampSeconds + 43200) * kNanosecondsPerSecond), "[2024-06-02T00:00:00.000000Z]");
 }
 
-TEST_F(TimestampProducerTests, Call_getTimestampInUs_And_Print_Result) {
-  std::cout << mTimestampProducer->getTimestampInUs() << std::endl;
+TEST_F(TimestampProducerTests, Local_Timestamp_Is_Shifted_By_Utc_Offset_And_Shows_It) {
+  timestampProducer.localUtcOffsetSeconds = 2 * 3600;
+  EXPECT_EQ(format(kTimestampNs), "[2024-06-01T14:00:00.123456+02:00]");
+
+  TimestampProducerTestable negativeOffsetProducer;
+  negativeOffsetProducer.localUtcOffsetSeconds = -(4 * 3600 + 30 * 60);
+  char buffer[equinox::kMaxTimestampLength];
+  EXPECT_EQ(std::string(buffer, negativeOffsetProducer.formatTimestamp(kTimestampNs, buffer)), "[2024-06-01T07:30:00.123456-04:30]");
+}
+
+TEST_F(TimestampProducerTests, Local_Utc_Offset_Is_Looked_Up_Once_A_Minute) {
+  for (std::int64_t second = 0; second < 60; ++second) {
+    format((kTimestampSeconds + second) * kNanosecondsPerSecond);
+  }
+  EXPECT_EQ(timestampProducer.localUtcOffsetLookups, 1);
+
+  timestampProducer.localUtcOffsetSeconds = 3600;
+  EXPECT_EQ(format((kTimestampSeconds + 60) * kNanosecondsPerSecond), "[2024-06-01T13:01:00.000000+01:00]");
+  EXPECT_EQ(timestampProducer.localUtcOffsetLookups, 2);
+}
+
+TEST_F(TimestampProducerTests, Local_Time_Matches_Localtime) {
+  equinox::TimestampProducer localTimestampProducer;
+  char buffer[equinox::kMaxTimestampLength];
+  const std::string timestamp(buffer, localTimestampProducer.formatTimestamp(kTimestampNs, buffer));
+
+  const std::time_t seconds = static_cast<std::time_t>(kTimestampSeconds);
+  std::tm localTime{};
+  localtime_r(&seconds, &localTime);
+  char expectedDateTime[32];
+  std::strftime(expectedDateTime, sizeof(expectedDateTime), "[%Y-%m-%dT%H:%M:%S.123456", &localTime);
+  EXPECT_EQ(timestamp.substr(0, std::string(expectedDateTime).size()), expectedDateTime);
 }
 
 } /*namespace time_stampproducer_tests*/
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "FileWriteLatency.h"
+#include "UringLogWriter.h"
+
+namespace uring_log_writer_test {
+    using namespace equinox;
+
+    namespace {
+        const std::string kTestLogFileName = "uring_writer_test.log";
+        const std::string kTestLine = "[time123][Test][INFO] uring line\n";
+
+        std::string readFile(const std::string& fileName) {
+            std::ifstream file(fileName);
+            std::stringstream content;
+            content << file.rdbuf();
+            return content.str();
+        }
+    }
+
+    class UringLogWriterTestable : public UringLogWriter {
+       public:
+        explicit UringLogWriterTestable(FileWriteLatency& fileWriteLatency) : UringLogWriter(fileWriteLatency) {}
+
+        using UringLogWriter::getWritesInFlight;
+    };
+
+    class UringLogWriterTest : public ::testing::Test {
+       public:
+        UringLogWriterTest() : file_write_latency{}, uring_log_writer{file_write_latency} {
+            std::filesystem::remove(kTestLogFileName);
+        }
+
+        ~UringLogWriterTest() override {
+            uring_log_writer.close();
+            std::filesystem::remove(kTestLogFileName);
+        }
+
+        void SetUp() override {
+            if (!uring_log_writer.isAvailable()) {
+                GTEST_SKIP() << "io_uring is not available";
+            }
+        }
+
+        FileWriteLatency file_write_latency;
+        UringLogWriterTestable uring_log_writer;
+    };
+
+    TEST_F(UringLogWriterTest, Try_Open_But_Directory_Does_Not_Exist) {
+        EXPECT_FALSE(uring_log_writer.open("missing_directory/uring_writer_test.log", false));
+
+        EXPECT_FALSE(uring_log_writer.isOpen());
+    }
+
+    TEST_F(UringLogWriterTest, Try_Open_Next_File_But_Directory_Does_Not_Exist_And_Open_File_Kept) {
+        ASSERT_TRUE(uring_log_writer.open(kTestLogFileName, false));
+        uring_log_writer.write(kTestLine.data(), kTestLine.size());
+
+        EXPECT_FALSE(uring_log_writer.open("missing_directory/uring_writer_test.log", true));
+        EXPECT_TRUE(uring_log_writer.write(kTestLine.data(), kTestLine.size()));
+        uring_log_writer.close();
+
+        EXPECT_EQ(readFile(kTestLogFileName), kTestLine + kTestLine);
+    }
+
+    TEST_F(UringLogWriterTest, Open_Next_File_And_Writes_In_Flight_Complete_Into_Previous_File) {
+        const std::string nextLogFileName = "uring_writer_test_next.log";
+        ASSERT_TRUE(uring_log_writer.open(kTestLogFileName, false));
+        uring_log_writer.write(kTestLine.data(), kTestLine.size());
+
+        ASSERT_TRUE(uring_log_writer.open(nextLogFileName, true));
+        EXPECT_EQ(uring_log_writer.getSize(), 0U);
+        EXPECT_TRUE(uring_log_writer.write(kTestLine.data(), kTestLine.size()));
+        uring_log_writer.close();
+
+        EXPECT_EQ(readFile(kTestLogFileName), kTestLine);
+        EXPECT_EQ(readFile(nextLogFileName), kTestLine);
+        std::filesystem::remove(nextLogFileName);
+    }
+
+    TEST_F(UringLogWriterTest, Try_Write_But_File_Is_Not_Open) {
+        EXPECT_FALSE(uring_log_writer.write(kTestLine.data(), kTestLine.size()));
+    }
+
+    TEST_F(UringLogWriterTest, Write_And_Close_And_Lines_In_File_And_Write_Latency_Recorded) {
+        ASSERT_TRUE(uring_log_writer.open(kTestLogFileName, false));
+
+        EXPECT_TRUE(uring_log_writer.write(kTestLine.data(), kTestLine.size()));
+        uring_log_writer.close();
+
+        EXPECT_EQ(uring_log_writer.getWritesInFlight(), 0U);
+        EXPECT_EQ(readFile(kTestLogFileName), kTestLine);
+        EXPECT_EQ(file_write_latency.getStats().writeCount, 1U);
+    }
+
+    TEST_F(UringLogWriterTest, Open_Existing_File_And_Writes_Go_After_Its_Content) {
+        {
+            std::ofstream existingFile(kTestLogFileName);
+            existingFile << kTestLine;
+        }
+
+        ASSERT_TRUE(uring_log_writer.open(kTestLogFileName, false));
+        EXPECT_EQ(uring_log_writer.getSize(), kTestLine.size());
+        uring_log_writer.write(kTestLine.data(), kTestLine.size());
+        uring_log_writer.close();
+
+        EXPECT_EQ(readFile(kTestLogFileName), kTestLine + kTestLine);
+    }
+
+    TEST_F(UringLogWriterTest, Write_More_Than_All_Buffers_Hold_And_Content_Kept_In_Order) {
+        std::string largeBatch;
+        for (std::size_t lineIndex = 0; largeBatch.size() < UringLogWriter::kBufferCount * UringLogWriter::kBufferBytes + 1000U; ++lineIndex) {
+            largeBatch += "line " + std::to_string(lineIndex) + "\n";
+        }
+        ASSERT_TRUE(uring_log_writer.open(kTestLogFileName, true));
+
+        EXPECT_TRUE(uring_log_writer.write(largeBatch.data(), largeBatch.size()));
+        uring_log_writer.close();
+
+        EXPECT_EQ(readFile(kTestLogFileName), largeBatch);
+    }
+
+    TEST_F(UringLogWriterTest, Sync_And_Sync_Latency_Recorded_When_It_Completes) {
+        ASSERT_TRUE(uring_log_writer.open(kTestLogFileName, false));
+        uring_log_writer.write(kTestLine.data(), kTestLine.size());
+
+        EXPECT_TRUE(uring_log_writer.sync());
+        uring_log_writer.close();
+
+        EXPECT_EQ(file_write_latency.getStats().syncCount, 1U);
+    }
+
+    TEST_F(UringLogWriterTest, Sync_And_Wait_And_Sync_Completed_Before_It_Returns) {
+        ASSERT_TRUE(uring_log_writer.open(kTestLogFileName, false));
+        uring_log_writer.write(kTestLine.data(), kTestLine.size());
+
+        EXPECT_TRUE(uring_log_writer.syncAndWait());
+
+        EXPECT_EQ(uring_log_writer.getWritesInFlight(), 0U);
+        EXPECT_EQ(file_write_latency.getStats().writeCount, 1U);
+        EXPECT_EQ(file_write_latency.getStats().syncCount, 1U);
+        EXPECT_EQ(file_write_latency.getStats().failedSyncCount, 0U);
+    }
+
+    TEST_F(UringLogWriterTest, Write_To_Full_Device_And_Failed_Write_Counted_And_Not_In_Size) {
+        ASSERT_TRUE(uring_log_writer.open("/dev/full", false));
+
+        EXPECT_TRUE(uring_log_writer.write(kTestLine.data(), kTestLine.size()));
+        uring_log_writer.syncAndWait();
+
+        EXPECT_EQ(file_write_latency.getStats().failedWriteCount, 1U);
+        EXPECT_EQ(uring_log_writer.getSize(), 0U);
+    }
+
+}  // namespace uring_log_writer_test
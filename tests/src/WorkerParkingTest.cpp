@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "WorkerParking.h"
+
+namespace worker_parking_test {
+
+    class WorkerParkingForTests : public equinox::WorkerParking {
+       public:
+        std::uint32_t getWakeUpsCountForTests() const { return getWakeUpsCount(); }
+    };
+
+    class WorkerParkingTest : public ::testing::Test {
+       public:
+        WorkerParkingForTests workerParking;
+    };
+
+    TEST_F(WorkerParkingTest, Notify_Without_Parked_Worker_Makes_No_Wake_Up) {
+        workerParking.notifyIfParked();
+        workerParking.notifyIfParked();
+
+        EXPECT_EQ(workerParking.getWakeUpsCountForTests(), 0U);
+    }
+
+    TEST_F(WorkerParkingTest, Notify_After_Prepare_To_Park_Wakes_Up_Once_And_Park_Returns_Immediately) {
+        const std::uint32_t ticket = workerParking.prepareToPark();
+        workerParking.notifyIfParked();
+        workerParking.notifyIfParked();
+        EXPECT_EQ(workerParking.getWakeUpsCountForTests(), 1U);
+
+        workerParking.park(ticket);
+        workerParking.notifyIfParked();
+        EXPECT_EQ(workerParking.getWakeUpsCountForTests(), 1U);
+    }
+
+    TEST_F(WorkerParkingTest, Cancelled_Park_Is_Not_Woken_Up) {
+        workerParking.prepareToPark();
+        workerParking.cancelPark();
+        workerParking.notifyIfParked();
+
+        EXPECT_EQ(workerParking.getWakeUpsCountForTests(), 0U);
+    }
+
+    TEST_F(WorkerParkingTest, Parked_Worker_Sleeps_Until_Notified_By_Other_Thread) {
+        std::atomic<bool> woken{false};
+        std::thread worker([this, &woken]() {
+            workerParking.park(workerParking.prepareToPark());
+            woken = true;
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_FALSE(woken.load());
+        workerParking.notifyIfParked();
+        worker.join();
+
+        EXPECT_TRUE(woken.load());
+    }
+
+}  // namespace worker_parking_test